@@ -0,0 +1,142 @@
+#include "AllocationCounter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// The replacements live apart from their callers so that the compiler
+// never sees an inlined free() paired with an operator new. Every form of
+// operator new counts, the over-aligned and the non-throwing ones too.
+
+static std::atomic<uint64_t> allocation_count{ 0 };
+
+static void* Allocate(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+static void* AllocateAligned(size_t size, std::align_val_t alignment) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    size_t alignment_bytes = (std::max)(static_cast<size_t>(alignment), sizeof(void*));
+
+    if (size == 0) {
+        size = 1;
+    }
+
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment_bytes);
+#else
+    void* data = nullptr;
+    return posix_memalign(&data, alignment_bytes, size) == 0 ? data : nullptr;
+#endif
+}
+
+static void FreeAligned(void* data) {
+#ifdef _WIN32
+    _aligned_free(data);
+#else
+    std::free(data);
+#endif
+}
+
+void* operator new(size_t size) {
+    void* data = Allocate(size);
+
+    if (data == nullptr) {
+        throw std::bad_alloc{};
+    }
+
+    return data;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    void* data = AllocateAligned(size, alignment);
+
+    if (data == nullptr) {
+        throw std::bad_alloc{};
+    }
+
+    return data;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* data) noexcept {
+    std::free(data);
+}
+
+void operator delete[](void* data) noexcept {
+    std::free(data);
+}
+
+void operator delete(void* data, size_t) noexcept {
+    std::free(data);
+}
+
+void operator delete[](void* data, size_t) noexcept {
+    std::free(data);
+}
+
+void operator delete(void* data, const std::nothrow_t&) noexcept {
+    std::free(data);
+}
+
+void operator delete[](void* data, const std::nothrow_t&) noexcept {
+    std::free(data);
+}
+
+void operator delete(void* data, std::align_val_t) noexcept {
+    FreeAligned(data);
+}
+
+void operator delete[](void* data, std::align_val_t) noexcept {
+    FreeAligned(data);
+}
+
+void operator delete(void* data, size_t, std::align_val_t) noexcept {
+    FreeAligned(data);
+}
+
+void operator delete[](void* data, size_t, std::align_val_t) noexcept {
+    FreeAligned(data);
+}
+
+void operator delete(void* data, std::align_val_t, const std::nothrow_t&) noexcept {
+    FreeAligned(data);
+}
+
+void operator delete[](void* data, std::align_val_t, const std::nothrow_t&) noexcept {
+    FreeAligned(data);
+}
+
+uint64_t com::github::coderodde::wtpdmt::getAllocationCount() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
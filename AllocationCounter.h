@@ -0,0 +1,13 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_ALLOCATION_COUNTER_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_ALLOCATION_COUNTER_HPP
+
+#include <cstdint>
+
+namespace com::github::coderodde::wtpdmt {
+
+	// Counts the calls of every form of the global operator new, which
+	// AllocationCounter.cpp replaces for the whole program with a counter in
+	// front of malloc(). Only the test tools link it, never wt itself.
+	uint64_t getAllocationCount();
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_ALLOCATION_COUNTER_HPP
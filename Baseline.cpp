@@ -0,0 +1,355 @@
+#include "Baseline.h"
+#include "BaselineFormat.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::Baseline;
+using com::github::coderodde::wtpdmt::BaselineBucket;
+using com::github::coderodde::wtpdmt::BaselineFileHeader;
+using com::github::coderodde::wtpdmt::util::Histogram;
+
+static const int TABLE_COLUMN_WIDTH = 12;
+
+// The tail that the regression test watches if no percentiles are given:
+static const double DEFAULT_TAIL_PERCENTILE = 99.0;
+
+// Below this the Kolmogorov series converges badly; the probability is
+// 1 to five digits there.
+static const double KOLMOGOROV_SERIES_MINIMUM_LAMBDA = 0.27;
+
+// One bucket value with its count in either run.
+struct BucketPair {
+    double   value_nanoseconds;
+    uint64_t baseline_count;
+    uint64_t current_count;
+};
+
+static void ThrowFileError(const string& operation, const string& path) {
+    std::stringstream ss;
+    ss << "Could not " << operation << " the baseline '" << path << "'.";
+    throw std::runtime_error{ ss.str() };
+}
+
+// Merges the non-empty buckets of both histograms by their lowest value
+// in nanoseconds.
+static std::vector<BucketPair> MergeBuckets(const Histogram& baseline,
+                                            double baseline_nanoseconds_per_tick,
+                                            const Histogram& current,
+                                            double current_nanoseconds_per_tick) {
+    std::vector<BucketPair> pairs;
+
+    for (size_t i = 0; i < Histogram::BUCKET_COUNT; i++) {
+        if (baseline.getBucketCount(i) > 0) {
+            pairs.push_back(BucketPair{ Histogram::getBucketLowestValue(i) * baseline_nanoseconds_per_tick,
+                                        baseline.getBucketCount(i),
+                                        0 });
+        }
+
+        if (current.getBucketCount(i) > 0) {
+            pairs.push_back(BucketPair{ Histogram::getBucketLowestValue(i) * current_nanoseconds_per_tick,
+                                        0,
+                                        current.getBucketCount(i) });
+        }
+    }
+
+    std::stable_sort(pairs.begin(), pairs.end(), [](const BucketPair& a, const BucketPair& b) {
+        return a.value_nanoseconds < b.value_nanoseconds;
+    });
+
+    std::vector<BucketPair> merged;
+
+    for (const BucketPair& pair : pairs) {
+        if (!merged.empty() && merged.back().value_nanoseconds == pair.value_nanoseconds) {
+            merged.back().baseline_count += pair.baseline_count;
+            merged.back().current_count += pair.current_count;
+        } else {
+            merged.push_back(pair);
+        }
+    }
+
+    return merged;
+}
+
+// The probability that the Kolmogorov distribution exceeds 'lambda'.
+static double KolmogorovProbability(double lambda) {
+    if (lambda < KOLMOGOROV_SERIES_MINIMUM_LAMBDA) {
+        return 1.0;
+    }
+
+    double sum = 0.0;
+    double sign = 1.0;
+
+    for (int k = 1; k <= 100; k++) {
+        double term = sign * std::exp(-2.0 * k * k * lambda * lambda);
+        sum += term;
+
+        if (std::fabs(term) < 1e-12) {
+            break;
+        }
+
+        sign = -sign;
+    }
+
+    return std::clamp(2.0 * sum, 0.0, 1.0);
+}
+
+// The probability that a standard normal variable exceeds 'z'.
+static double UpperNormalProbability(double z) {
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+void com::github::coderodde::wtpdmt::saveBaseline(const string& path,
+                                                  const Histogram& histogram,
+                                                  const util::Clock& clock,
+                                                  size_t thread_count) {
+    std::vector<BaselineBucket> buckets;
+
+    for (size_t i = 0; i < Histogram::BUCKET_COUNT; i++) {
+        if (histogram.getBucketCount(i) > 0) {
+            buckets.push_back(BaselineBucket{ static_cast<uint32_t>(i), 0, histogram.getBucketCount(i) });
+        }
+    }
+
+    BaselineFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BASELINE_FILE_MAGIC, sizeof(header.magic));
+
+    header.version                = BASELINE_FILE_VERSION;
+    header.header_size            = sizeof(BaselineFileHeader);
+    header.bucket_size            = sizeof(BaselineBucket);
+    header.bucket_count           = static_cast<uint32_t>(buckets.size());
+    header.sub_bucket_bits        = Histogram::SUB_BUCKET_BITS;
+    header.clock_source           = static_cast<uint32_t>(clock.getSource());
+    header.thread_count           = static_cast<uint32_t>(thread_count);
+    header.nanoseconds_per_tick   = clock.getNanosecondsPerTick();
+    header.end_time_nanoseconds   = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    header.count                  = histogram.getCount();
+    header.minimum                = histogram.getMinimum();
+    header.maximum                = histogram.getMaximum();
+    header.sum                    = histogram.getSum();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(buckets.data()),
+               static_cast<std::streamsize>(buckets.size() * sizeof(BaselineBucket)));
+
+    if (!file.flush()) {
+        ThrowFileError("write", path);
+    }
+}
+
+std::unique_ptr<Baseline> com::github::coderodde::wtpdmt::loadBaseline(const string& path) {
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file) {
+        ThrowFileError("open", path);
+    }
+
+    BaselineFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, BASELINE_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != BASELINE_FILE_VERSION ||
+        header.header_size < sizeof(BaselineFileHeader) ||
+        header.bucket_size < sizeof(BaselineBucket)) {
+        ThrowFileError("recognize", path);
+    }
+
+    if (header.sub_bucket_bits != Histogram::SUB_BUCKET_BITS) {
+        ThrowFileError("use the buckets of", path);
+    }
+
+    std::vector<uint64_t> counts(Histogram::BUCKET_COUNT, 0);
+    std::vector<char> record(header.bucket_size);
+    file.seekg(header.header_size);
+
+    for (uint32_t i = 0; i < header.bucket_count; i++) {
+        BaselineBucket bucket;
+
+        if (!file.read(record.data(), static_cast<std::streamsize>(record.size()))) {
+            ThrowFileError("read", path);
+        }
+
+        std::memcpy(&bucket, record.data(), sizeof(bucket));
+
+        if (bucket.index >= Histogram::BUCKET_COUNT) {
+            ThrowFileError("recognize", path);
+        }
+
+        counts[bucket.index] = bucket.count;
+    }
+
+    std::unique_ptr<Baseline> baseline = std::make_unique<Baseline>();
+    baseline->histogram.restore(counts.data(),
+                                header.minimum,
+                                header.maximum,
+                                header.sum);
+    baseline->nanoseconds_per_tick = header.nanoseconds_per_tick;
+    baseline->clock_source         = static_cast<util::ClockSource>(header.clock_source);
+    baseline->thread_count         = header.thread_count;
+    baseline->time_nanoseconds     = header.end_time_nanoseconds;
+
+    return baseline;
+}
+
+static void PrintComparisonRow(const string& label, double baseline_nanoseconds, double current_nanoseconds) {
+    std::cout << std::setw(TABLE_COLUMN_WIDTH) << label
+              << std::setw(TABLE_COLUMN_WIDTH) << baseline_nanoseconds
+              << std::setw(TABLE_COLUMN_WIDTH) << current_nanoseconds
+              << std::setw(TABLE_COLUMN_WIDTH) << current_nanoseconds - baseline_nanoseconds;
+
+    if (baseline_nanoseconds > 0.0) {
+        std::cout << std::setw(TABLE_COLUMN_WIDTH - 1)
+                  << 100.0 * (current_nanoseconds - baseline_nanoseconds) / baseline_nanoseconds << "%";
+    } else {
+        std::cout << std::setw(TABLE_COLUMN_WIDTH) << "-";
+    }
+
+    std::cout << "\n";
+}
+
+bool com::github::coderodde::wtpdmt::compareWithBaseline(const Baseline& baseline,
+                                                         const Histogram& histogram,
+                                                         const util::Clock& clock,
+                                                         const std::vector<double>& percentiles) {
+    const Histogram& reference = baseline.histogram;
+    double reference_nanoseconds_per_tick = baseline.nanoseconds_per_tick;
+    double nanoseconds_per_tick = clock.getNanosecondsPerTick();
+
+    if (reference.getCount() == 0 || histogram.getCount() == 0) {
+        std::cout << "WARNING: Nothing to compare; one of the runs has no gaps.\n";
+        return false;
+    }
+
+    if (baseline.clock_source != clock.getSource()) {
+        std::cout << "WARNING: The baseline used the clock "
+                  << util::Clock::getSourceName(baseline.clock_source)
+                  << "; comparing in nanoseconds.\n";
+    }
+
+    std::cout << "\nGaps compared with the baseline of "
+              << reference.getCount() << " gaps (ns):\n";
+
+    std::cout << std::fixed << std::setprecision(1) << std::setfill(' ') << std::right;
+    std::cout << std::setw(TABLE_COLUMN_WIDTH) << ""
+              << std::setw(TABLE_COLUMN_WIDTH) << "Baseline"
+              << std::setw(TABLE_COLUMN_WIDTH) << "Current"
+              << std::setw(TABLE_COLUMN_WIDTH) << "Delta"
+              << std::setw(TABLE_COLUMN_WIDTH) << "Delta %"
+              << "\n";
+
+    PrintComparisonRow("Mean",
+                       reference.getMean() * reference_nanoseconds_per_tick,
+                       histogram.getMean() * nanoseconds_per_tick);
+
+    for (double percentile : percentiles) {
+        std::stringstream label;
+        label << "p" << std::defaultfloat << percentile;
+
+        PrintComparisonRow(label.str(),
+                           reference.getValueAtPercentile(percentile) * reference_nanoseconds_per_tick,
+                           histogram.getValueAtPercentile(percentile) * nanoseconds_per_tick);
+    }
+
+    PrintComparisonRow("Max",
+                       reference.getMaximum() * reference_nanoseconds_per_tick,
+                       histogram.getMaximum() * nanoseconds_per_tick);
+
+    std::vector<BucketPair> pairs = MergeBuckets(reference, reference_nanoseconds_per_tick,
+                                                 histogram, nanoseconds_per_tick);
+
+    double n = static_cast<double>(reference.getCount());
+    double m = static_cast<double>(histogram.getCount());
+
+    // Kolmogorov-Smirnov: the largest distance between the two CDFs.
+    // Mann-Whitney: U counts the pairs in which the current gap is the
+    // larger one, ties as a half.
+    double reference_cumulative = 0.0;
+    double current_cumulative = 0.0;
+    double distance = 0.0;
+    double u = 0.0;
+    double tie_correction = 0.0;
+
+    for (const BucketPair& pair : pairs) {
+        double reference_count = static_cast<double>(pair.baseline_count);
+        double current_count = static_cast<double>(pair.current_count);
+        double tied = reference_count + current_count;
+
+        u += current_count * (reference_cumulative + 0.5 * reference_count);
+        tie_correction += tied * tied * tied - tied;
+
+        reference_cumulative += reference_count;
+        current_cumulative += current_count;
+        distance = (std::max)(distance, std::fabs(reference_cumulative / n - current_cumulative / m));
+    }
+
+    double effective_count = n * m / (n + m);
+    double ks_lambda = (std::sqrt(effective_count) + 0.12 + 0.11 / std::sqrt(effective_count)) * distance;
+    double ks_probability = KolmogorovProbability(ks_lambda);
+
+    double total = n + m;
+    double u_variance = n * m / 12.0 * ((total + 1.0) - tie_correction / (total * (total - 1.0)));
+    double u_z = u_variance > 0.0 ? (u - n * m / 2.0) / std::sqrt(u_variance) : 0.0;
+    double u_probability = u_variance > 0.0 ? UpperNormalProbability(u_z) : 1.0;
+
+    std::cout << std::defaultfloat << std::setprecision(4);
+    std::cout << "\nINFO: Kolmogorov-Smirnov D = " << distance << " (p = " << ks_probability << ").\n";
+    std::cout << "INFO: A current gap is the larger of a pair with probability " << u / (n * m)
+              << " (Mann-Whitney z = " << u_z << ", one-sided p = " << u_probability << ").\n";
+
+    // The tail test: did more gaps than before exceed the baseline's own
+    // tail value? Two proportions, pooled, one-sided.
+    double tail_percentile = percentiles.empty()
+                           ? DEFAULT_TAIL_PERCENTILE
+                           : *std::max_element(percentiles.begin(), percentiles.end());
+    double threshold_nanoseconds =
+        reference.getValueAtPercentile(tail_percentile) * reference_nanoseconds_per_tick;
+    double reference_exceeding = 0.0;
+    double current_exceeding = 0.0;
+
+    for (const BucketPair& pair : pairs) {
+        if (pair.value_nanoseconds > threshold_nanoseconds) {
+            reference_exceeding += static_cast<double>(pair.baseline_count);
+            current_exceeding += static_cast<double>(pair.current_count);
+        }
+    }
+
+    double reference_fraction = reference_exceeding / n;
+    double current_fraction = current_exceeding / m;
+    double pooled_fraction = (reference_exceeding + current_exceeding) / total;
+    double tail_error = std::sqrt(pooled_fraction * (1.0 - pooled_fraction) * (1.0 / n + 1.0 / m));
+    double tail_probability = tail_error > 0.0
+                            ? UpperNormalProbability((current_fraction - reference_fraction) / tail_error)
+                            : 1.0;
+
+    std::cout << "INFO: " << 100.0 * reference_fraction << "% of the baseline gaps and "
+              << 100.0 * current_fraction << "% of the current ones exceed the baseline p"
+              << tail_percentile << " of " << threshold_nanoseconds << " ns (one-sided p = "
+              << tail_probability << ").\n";
+
+    bool regressed = current_fraction > reference_fraction && tail_probability < BASELINE_SIGNIFICANCE_LEVEL;
+
+    if (regressed) {
+        std::cout << "WARNING: The tail regressed at the " << 100.0 * BASELINE_SIGNIFICANCE_LEVEL
+                  << "% significance level.\n";
+    } else {
+        std::cout << "INFO: No significant tail regression.\n";
+    }
+
+    std::cout << std::defaultfloat << std::setprecision(6);
+    return regressed;
+}
@@ -0,0 +1,53 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_BASELINE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_BASELINE_HPP
+
+#include "Clock.h"
+#include "Histogram.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using std::string;
+
+	// The gap distribution of an earlier run, as saveBaseline() wrote it.
+	struct Baseline {
+		util::Histogram   histogram;
+		double            nanoseconds_per_tick;
+		util::ClockSource clock_source;
+		uint32_t          thread_count;
+		uint64_t          time_nanoseconds; // Unix epoch time of the end of the run.
+	};
+
+	// Writes the aggregate gap histogram of a run in the layout of
+	// BaselineFormat.h.
+	void saveBaseline(const string& path,
+					  const util::Histogram& histogram,
+					  const util::Clock& clock,
+					  size_t thread_count);
+
+	std::unique_ptr<Baseline> loadBaseline(const string& path);
+
+	// The significance level of the tail regression test, and what the
+	// program exits with if the tail regressed.
+	constexpr double BASELINE_SIGNIFICANCE_LEVEL   = 0.01;
+	constexpr int    BASELINE_REGRESSION_EXIT_CODE = 2;
+
+	// Prints the percentiles of both runs and their deltas, a two-sample
+	// Kolmogorov-Smirnov test and a one-sided Mann-Whitney U test of the
+	// whole distributions, and a one-sided test of how many gaps exceed
+	// the baseline's value at the highest of 'percentiles' (p99 without
+	// any). Returns true if that tail got significantly worse.
+	//
+	// The tests work on histogram buckets, so values within one bucket
+	// count as ties. Runs with different clocks compare in nanoseconds,
+	// which blurs the buckets.
+	bool compareWithBaseline(const Baseline& baseline,
+							 const util::Histogram& histogram,
+							 const util::Clock& clock,
+							 const std::vector<double>& percentiles);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_BASELINE_HPP
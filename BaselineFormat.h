@@ -0,0 +1,52 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_BASELINE_FORMAT_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_BASELINE_FORMAT_HPP
+
+#include <cstdint>
+
+namespace com::github::coderodde::wtpdmt {
+
+	// Layout of a result file that a later run compares itself against
+	// (all fields little-endian):
+	//
+	//   BaselineFileHeader            header_size bytes
+	//   BaselineBucket[bucket_count]  bucket_size bytes each
+	//
+	// Only the non-empty buckets of the gap histogram are stored, in
+	// increasing order. Gap values are in clock ticks; multiply by
+	// nanoseconds_per_tick. The buckets are those of util::Histogram with
+	// sub_bucket_bits. Readers must check magic and version, and should use
+	// header_size and bucket_size to step over fields added by later
+	// versions.
+
+	constexpr char     BASELINE_FILE_MAGIC[8] = { 'W', 'T', 'P', 'D', 'B', 'S', 'L', '\0' };
+	constexpr uint32_t BASELINE_FILE_VERSION  = 1;
+
+	struct BaselineFileHeader {
+		char     magic[8];
+		uint32_t version;
+		uint32_t header_size;
+		uint32_t bucket_size;
+		uint32_t bucket_count;
+		uint32_t sub_bucket_bits;
+		uint32_t clock_source;           // util::ClockSource of the run.
+		uint32_t thread_count;
+		uint32_t reserved;
+		double   nanoseconds_per_tick;
+		uint64_t end_time_nanoseconds;   // Unix epoch time of the end of the run.
+		uint64_t count;
+		uint64_t minimum;
+		uint64_t maximum;
+		double   sum;
+		uint64_t reserved2;
+	};
+
+	struct BaselineBucket {
+		uint32_t index;
+		uint32_t reserved;
+		uint64_t count;
+	};
+
+	static_assert(sizeof(BaselineFileHeader) == 96, "Unexpected baseline header layout.");
+	static_assert(sizeof(BaselineBucket) == 16, "Unexpected baseline bucket layout.");
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_BASELINE_FORMAT_HPP
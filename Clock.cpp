@@ -0,0 +1,278 @@
+#include "Clock.h"
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(WTPDMT_HAS_TSC) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+using std::string;
+
+// Clock source names as accepted by --clock:
+static const string CLOCK_TICK_COUNT_STR    = "tickcount";
+static const string CLOCK_QPC_STR           = "qpc";
+static const string CLOCK_TSC_STR           = "tsc";
+static const string CLOCK_TSCP_STR          = "rdtscp";
+static const string CLOCK_MONOTONIC_STR     = "monotonic";
+static const string CLOCK_MONOTONIC_RAW_STR = "monotonic-raw";
+static const string CLOCK_BOOTTIME_STR      = "boottime";
+
+static const std::chrono::milliseconds TSC_CALIBRATION_DURATION{ 100 };
+static const std::chrono::milliseconds STEP_PROBE_DURATION{ 100 };
+static const size_t STEP_PROBE_MAXIMUM_STEPS = 1000;
+static const size_t READ_COST_SAMPLES        = 1 << 20;
+
+using com::github::coderodde::wtpdmt::util::ClockSource;
+
+com::github::coderodde::wtpdmt::util::Clock::Clock(ClockSource source) :
+    m_source                   { source },
+    m_nanoseconds_per_tick     { 1.0 },
+    m_resolution_nanoseconds   { 1.0 },
+    m_smallest_step_nanoseconds{ 0.0 },
+    m_read_cost_nanoseconds    { 0.0 }
+{
+    calibrate();
+}
+
+ClockSource com::github::coderodde::wtpdmt::util::Clock::getSource() const {
+    return m_source;
+}
+
+string com::github::coderodde::wtpdmt::util::Clock::getName() const {
+    return getSourceName(m_source);
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::Clock::read() const {
+    return dispatch(m_source, [](auto reader) {
+        return decltype(reader)::read();
+    });
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::Clock::ticksToNanoseconds(uint64_t ticks) const {
+    return static_cast<uint64_t>(static_cast<double>(ticks) * m_nanoseconds_per_tick + 0.5);
+}
+
+double com::github::coderodde::wtpdmt::util::Clock::getNanosecondsPerTick() const {
+    return m_nanoseconds_per_tick;
+}
+
+double com::github::coderodde::wtpdmt::util::Clock::getResolutionNanoseconds() const {
+    return m_resolution_nanoseconds;
+}
+
+double com::github::coderodde::wtpdmt::util::Clock::getSmallestStepNanoseconds() const {
+    return m_smallest_step_nanoseconds;
+}
+
+double com::github::coderodde::wtpdmt::util::Clock::getReadCostNanoseconds() const {
+    return m_read_cost_nanoseconds;
+}
+
+ClockSource com::github::coderodde::wtpdmt::util::Clock::getDefaultSource() {
+#ifdef _WIN32
+    return ClockSource::QPC;
+#else
+    return ClockSource::MONOTONIC;
+#endif
+}
+
+std::vector<ClockSource> com::github::coderodde::wtpdmt::util::Clock::getSupportedSources() {
+    std::vector<ClockSource> sources;
+#ifdef _WIN32
+    sources.push_back(ClockSource::TICK_COUNT);
+    sources.push_back(ClockSource::QPC);
+#else
+    sources.push_back(ClockSource::MONOTONIC);
+    sources.push_back(ClockSource::MONOTONIC_RAW);
+    sources.push_back(ClockSource::BOOTTIME);
+#endif
+#ifdef WTPDMT_HAS_TSC
+    sources.push_back(ClockSource::TSC);
+    sources.push_back(ClockSource::TSCP);
+#endif
+    return sources;
+}
+
+string com::github::coderodde::wtpdmt::util::Clock::getSourceName(ClockSource source) {
+    switch (source) {
+    case ClockSource::TICK_COUNT:    return CLOCK_TICK_COUNT_STR;
+    case ClockSource::QPC:           return CLOCK_QPC_STR;
+    case ClockSource::TSC:           return CLOCK_TSC_STR;
+    case ClockSource::TSCP:          return CLOCK_TSCP_STR;
+    case ClockSource::MONOTONIC:     return CLOCK_MONOTONIC_STR;
+    case ClockSource::MONOTONIC_RAW: return CLOCK_MONOTONIC_RAW_STR;
+    case ClockSource::BOOTTIME:      return CLOCK_BOOTTIME_STR;
+    }
+
+    throw std::logic_error{ "Unknown clock source." };
+}
+
+bool com::github::coderodde::wtpdmt::util::Clock::findSource(const string& name, ClockSource* source_ptr) {
+    for (ClockSource source : getSupportedSources()) {
+        if (getSourceName(source) == name) {
+            *source_ptr = source;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool com::github::coderodde::wtpdmt::util::Clock::isTscInvariant() {
+#ifdef WTPDMT_HAS_TSC
+    // CPUID.80000007H:EDX[8] advertises a constant-rate TSC that keeps
+    // ticking in deep C-states:
+#ifdef _MSC_VER
+    int registers[4];
+    __cpuid(registers, 0x80000000);
+
+    if (static_cast<unsigned int>(registers[0]) < 0x80000007) {
+        return false;
+    }
+
+    __cpuid(registers, 0x80000007);
+    return (registers[3] & (1 << 8)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+
+    return (edx & (1 << 8)) != 0;
+#endif
+#else
+    return false;
+#endif
+}
+
+template<class Reader>
+static double calibrateNanosecondsPerTick() {
+    // Compare the reader against std::chrono::steady_clock over a busy
+    // wait long enough to make the steady clock's granularity negligible:
+    auto reference_start = std::chrono::steady_clock::now();
+    uint64_t ticks_start = Reader::read();
+    auto reference_end = reference_start;
+
+    do {
+        reference_end = std::chrono::steady_clock::now();
+    } while (reference_end - reference_start < TSC_CALIBRATION_DURATION);
+
+    uint64_t ticks_end = Reader::read();
+    double elapsed_nanoseconds =
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            reference_end - reference_start).count());
+
+    return elapsed_nanoseconds / static_cast<double>(ticks_end - ticks_start);
+}
+
+template<class Reader>
+static uint64_t measureSmallestStepTicks() {
+    auto deadline = std::chrono::steady_clock::now() + STEP_PROBE_DURATION;
+    uint64_t smallest_step = UINT64_MAX;
+
+    for (size_t step = 0; step < STEP_PROBE_MAXIMUM_STEPS; step++) {
+        uint64_t ta = Reader::read();
+        uint64_t tb = ta;
+
+        while (tb == ta) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return smallest_step == UINT64_MAX ? 0 : smallest_step;
+            }
+
+            tb = Reader::read();
+        }
+
+        if (tb - ta < smallest_step) {
+            smallest_step = tb - ta;
+        }
+    }
+
+    return smallest_step;
+}
+
+template<class Reader>
+static double measureReadCostNanoseconds() {
+    volatile uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < READ_COST_SAMPLES; i++) {
+        sink = Reader::read();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    (void) sink;
+
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end - start).count()) / static_cast<double>(READ_COST_SAMPLES);
+}
+
+void com::github::coderodde::wtpdmt::util::Clock::calibrate() {
+    switch (m_source) {
+#ifdef _WIN32
+    case ClockSource::TICK_COUNT: {
+        DWORD time_adjustment;
+        DWORD time_increment;
+        BOOL time_adjustment_disabled;
+
+        m_nanoseconds_per_tick = 1000.0 * 1000.0;
+
+        if (GetSystemTimeAdjustment(&time_adjustment,
+                                    &time_increment,
+                                    &time_adjustment_disabled)) {
+            // The increment is expressed in 100 ns units:
+            m_resolution_nanoseconds = 100.0 * time_increment;
+        } else {
+            m_resolution_nanoseconds = m_nanoseconds_per_tick;
+        }
+
+        break;
+    }
+
+    case ClockSource::QPC: {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        m_nanoseconds_per_tick = 1e9 / static_cast<double>(frequency.QuadPart);
+        m_resolution_nanoseconds = m_nanoseconds_per_tick;
+        break;
+    }
+#else
+    case ClockSource::MONOTONIC:
+    case ClockSource::MONOTONIC_RAW:
+    case ClockSource::BOOTTIME: {
+        clockid_t clock_id = m_source == ClockSource::MONOTONIC     ? CLOCK_MONOTONIC :
+                             m_source == ClockSource::MONOTONIC_RAW ? CLOCK_MONOTONIC_RAW :
+                                                                      CLOCK_BOOTTIME;
+        timespec resolution;
+        clock_getres(clock_id, &resolution);
+        m_nanoseconds_per_tick = 1.0;
+        m_resolution_nanoseconds = resolution.tv_sec * 1e9 + resolution.tv_nsec;
+        break;
+    }
+#endif
+#ifdef WTPDMT_HAS_TSC
+    case ClockSource::TSC:
+        m_nanoseconds_per_tick = calibrateNanosecondsPerTick<TscReader>();
+        m_resolution_nanoseconds = m_nanoseconds_per_tick;
+        break;
+
+    case ClockSource::TSCP:
+        m_nanoseconds_per_tick = calibrateNanosecondsPerTick<TscpReader>();
+        m_resolution_nanoseconds = m_nanoseconds_per_tick;
+        break;
+#endif
+    default:
+        throw std::logic_error{ "Clock source '"
+                              + getSourceName(m_source)
+                              + "' is not supported on this platform." };
+    }
+
+    dispatch(m_source, [this](auto reader) {
+        using Reader = decltype(reader);
+        m_smallest_step_nanoseconds = measureSmallestStepTicks<Reader>() * m_nanoseconds_per_tick;
+        m_read_cost_nanoseconds = measureReadCostNanoseconds<Reader>();
+    });
+}
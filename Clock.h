@@ -0,0 +1,161 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_CLOCK_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_CLOCK_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define WTPDMT_HAS_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	using std::string;
+
+	enum class ClockSource {
+		TICK_COUNT,
+		QPC,
+		TSC,
+		TSCP,
+		MONOTONIC,
+		MONOTONIC_RAW,
+		BOOTTIME
+	};
+
+	// Each reader is a stateless type with a static read() so that the
+	// measurement loop can be instantiated once per clock source and pays
+	// no dispatch cost per sample.
+#ifdef _WIN32
+	struct TickCountReader {
+		static uint64_t read() {
+			return GetTickCount64();
+		}
+	};
+
+	struct QpcReader {
+		static uint64_t read() {
+			LARGE_INTEGER counter;
+			QueryPerformanceCounter(&counter);
+			return static_cast<uint64_t>(counter.QuadPart);
+		}
+	};
+#else
+	template<clockid_t CLOCK_ID>
+	struct ClockGettimeReader {
+		static uint64_t read() {
+			timespec ts;
+			clock_gettime(CLOCK_ID, &ts);
+			return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL
+				 + static_cast<uint64_t>(ts.tv_nsec);
+		}
+	};
+
+	using MonotonicReader    = ClockGettimeReader<CLOCK_MONOTONIC>;
+	using MonotonicRawReader = ClockGettimeReader<CLOCK_MONOTONIC_RAW>;
+	using BoottimeReader     = ClockGettimeReader<CLOCK_BOOTTIME>;
+
+	// Not a clock source: the CPU time of the calling thread, for the gap
+	// attribution.
+	using ThreadCpuTimeReader = ClockGettimeReader<CLOCK_THREAD_CPUTIME_ID>;
+#endif
+
+#ifdef WTPDMT_HAS_TSC
+	struct TscReader {
+		static uint64_t read() {
+			// Keep rdtsc from being executed ahead of the preceding loads:
+			_mm_lfence();
+			return __rdtsc();
+		}
+	};
+
+	struct TscpReader {
+		static uint64_t read() {
+			unsigned int aux;
+			return __rdtscp(&aux);
+		}
+	};
+#endif
+
+	class Clock {
+	private:
+
+		ClockSource m_source;
+		double      m_nanoseconds_per_tick;
+		double      m_resolution_nanoseconds;
+		double      m_smallest_step_nanoseconds;
+		double      m_read_cost_nanoseconds;
+
+	public:
+
+		explicit Clock(ClockSource source);
+
+		ClockSource getSource() const;
+		string getName() const;
+		uint64_t read() const;
+		uint64_t ticksToNanoseconds(uint64_t ticks) const;
+		double getNanosecondsPerTick() const;
+		double getResolutionNanoseconds() const;
+		double getSmallestStepNanoseconds() const;
+		double getReadCostNanoseconds() const;
+
+		static ClockSource getDefaultSource();
+		static std::vector<ClockSource> getSupportedSources();
+		static string getSourceName(ClockSource source);
+		static bool findSource(const string& name, ClockSource* source_ptr);
+		static bool isTscInvariant();
+
+		// Calls 'function' with a default-constructed reader matching
+		// 'source'. The reader type carries the clock, so the callee is
+		// compiled separately for every clock source.
+		template<class Function>
+		static auto dispatch(ClockSource source, Function&& function) {
+			switch (source) {
+#ifdef _WIN32
+			case ClockSource::TICK_COUNT:
+				return function(TickCountReader{});
+
+			case ClockSource::QPC:
+				return function(QpcReader{});
+#else
+			case ClockSource::MONOTONIC:
+				return function(MonotonicReader{});
+
+			case ClockSource::MONOTONIC_RAW:
+				return function(MonotonicRawReader{});
+
+			case ClockSource::BOOTTIME:
+				return function(BoottimeReader{});
+#endif
+#ifdef WTPDMT_HAS_TSC
+			case ClockSource::TSC:
+				return function(TscReader{});
+
+			case ClockSource::TSCP:
+				return function(TscpReader{});
+#endif
+			default:
+				throw std::logic_error{ "Clock source '"
+									  + getSourceName(source)
+									  + "' is not supported on this platform." };
+			}
+		}
+
+	private:
+
+		void calibrate();
+	};
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_CLOCK_HPP
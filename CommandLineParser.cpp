@@ -1,95 +1,309 @@
 #include "CommandLineParser.h"'
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <filesystem>
-#include <functional>
 #include <iomanip>
 #include <iostream>
-#include <map>
-#include <regex>
+#include <iterator>
+#include <limits>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "Baseline.h"
+#include "ListItems.h"
+#include "Measurement.h"
+#include "PriorityNames.h"
+#include "SharedMemory.h"
+#include "ThreadControl.h"
+#include "TimerResolution.h"
+
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <sched.h>
+#endif
 
 using std::string;
+using com::github::coderodde::wtpdmt::util::nextListItem;
 
-static const string HEXADECIMAL_REGEX_PATTERN = "0[xX]([0-9a-fA-F]{1,8})";
-static const std::regex HEXADECIMAL_REGEX = std::regex(HEXADECIMAL_REGEX_PATTERN);
+// Parses all of 'value' in 'base' with std::from_chars(), which neither
+// allocates nor depends on the locale. Out-of-range values fail.
+template<class T>
+static bool ParseNumber(std::string_view value, T* result, int base) {
+    const char* end = value.data() + value.size();
+    auto [last, error] = std::from_chars(value.data(), end, *result, base);
+    return !value.empty() && error == std::errc{} && last == end;
+}
 
-static const string DECIMAL_REGEX_PATTERN = "-?([0-9]{1,10})";
-static const std::regex DECIMAL_REGEX = std::regex(DECIMAL_REGEX_PATTERN);
+static uint64_t ParseUnsignedValue(std::string_view flag, std::string_view value) {
+    uint64_t result;
 
-static bool IsHexadecimalString(string& str) {
-    return std::regex_match(str, HEXADECIMAL_REGEX);
-}
+    if (!ParseNumber(value, &result, 10)) {
+        std::stringstream ss;
+        ss << "Could not parse '"
+           << value
+           << "' as a non-negative integer for the flag "
+           << flag
+           << ".";
 
-static bool IsDecimalString(string& str) {
-    return std::regex_match(str, DECIMAL_REGEX);
-}
+        throw std::logic_error{ ss.str() };
+    }
 
-// Priority class names:
-static const string ABOVE_NORMAL_PRIORITY_CLASS_STR   = "ABOVE_NORMAL_PRIORITY_CLASS";   // 0x00008000
-static const string BELOW_NORMAL_PRIORITY_CLASS_STR   = "BELOW_NORMAL_PRIORITY_CLASS";   // 0x00004000
-static const string HIGH_PRIORITY_CLASS_STR           = "HIGH_PRIORITY_CLASS";           // 0x00000080
-static const string IDLE_PRIORITY_CLASS_STR           = "IDLE_PRIORITY_CLASS";           // 0x00000040
-static const string NORMAL_PRIORITY_CLASS_STR         = "NORMAL_PRIORITY_CLASS";         // 0x00000020
-static const string PROCESS_MODE_BACKGROUND_BEGIN_STR = "PROCESS_MODE_BACKGROUND_BEGIN"; // 0x00100000
-static const string PROCESS_MODE_BACKGROUND_END_STR   = "PROCESS_MODE_BACKGROUND_END";   // 0x00200000
-static const string REALTIME_PRIORITY_CLASS_STR       = "REALTIME_PRIORITY_CLASS";       // 0x00000100
+    return result;
+}
 
-// Thread priority names:
-static string THREAD_MODE_BACKGROUND_BEGIN_STR  = "THREAD_MODE_BACKGROUND_BEGIN";  // 0x0010000
-static string THREAD_MODE_BACKGROUND_END_STR    = "THREAD_MODE_BACKGROUND_END";    // 0x00020000
-static string THREAD_PRIORITY_ABOVE_NORMAL_STR  = "THREAD_PRIORITY_ABOVE_NORMAL";  // 1
-static string THREAD_PRIORITY_BELOW_NORMAL_STR  = "THREAD_PRIORITY_BELOW_NORMAL";  // -1
-static string THREAD_PRIORITY_HIGHEST_STR       = "THREAD_PRIORITY_HIGHEST";       // 2
-static string THREAD_PRIORITY_IDLE_STR          = "THREAD_PRIORITY_IDLE";          // -15
-static string THREAD_PRIORITY_LOWEST_STR        = "THREAD_PRIORITY_LOWEST";        // -2
-static string THREAD_PRIORITY_NORMAL_STR        = "THREAD_PRIORITY_NORMAL";        // 0
-static string THREAD_PRIORITY_TIME_CRITICAL_STR = "THREAD_PRIORITY_TIME_CRITICAL"; // 15
+#ifndef _WIN32
+static const int MAXIMUM_WINDOWS_NAME_LENGTH = 29; // THREAD_PRIORITY_TIME_CRITICAL
+#endif
 
 // Program flags:
-static string FLAG_LONG_HELP                 = "--help";
-static string FLAG_LONG_NUMBER_OF_ITERATIONS = "--iterations";
-static string FLAG_LONG_PRIORITY_CLASS       = "--priority-class";
-static string FLAG_LONG_THREAD_PRIORITY      = "--thread-priority";
-
-static string FLAG_SHORT_HELP                 = "-h";
-static string FLAG_SHORT_NUMBER_OF_ITERATIONS = "-i";
-static string FLAG_SHORT_PRIORITY_CLASS       = "-p";
-static string FLAG_SHORT_THREAD_PRIORITY      = "-t";
+static constexpr std::string_view FLAG_LONG_HELP                 = "--help";
+static constexpr std::string_view FLAG_LONG_NUMBER_OF_ITERATIONS = "--iterations";
+static constexpr std::string_view FLAG_LONG_PRIORITY_CLASS       = "--priority-class";
+static constexpr std::string_view FLAG_LONG_THREAD_PRIORITY      = "--thread-priority";
+static constexpr std::string_view FLAG_LONG_CLOCK                = "--clock";
+static constexpr std::string_view FLAG_LONG_PERCENTILES          = "--percentiles";
+static constexpr std::string_view FLAG_LONG_THREADS              = "--threads";
+static constexpr std::string_view FLAG_LONG_CPUS                 = "--cpus";
+static constexpr std::string_view FLAG_LONG_TRACE                = "--trace";
+static constexpr std::string_view FLAG_LONG_THRESHOLD            = "--threshold";
+static constexpr std::string_view FLAG_LONG_MODE                 = "--mode";
+static constexpr std::string_view FLAG_LONG_INTERVAL             = "--interval";
+static constexpr std::string_view FLAG_LONG_MECHANISMS           = "--mechanisms";
+static constexpr std::string_view FLAG_LONG_TASKS                = "--tasks";
+static constexpr std::string_view FLAG_LONG_SCHED_DEADLINE       = "--sched-deadline";
+static constexpr std::string_view FLAG_LONG_MEMORY               = "--memory";
+static constexpr std::string_view FLAG_LONG_SWEEP                = "--sweep";
+static constexpr std::string_view FLAG_LONG_LOAD                 = "--load";
+static constexpr std::string_view FLAG_LONG_REPORT_INTERVAL      = "--report-interval";
+static constexpr std::string_view FLAG_LONG_REPORT_FORMAT        = "--report-format";
+static constexpr std::string_view FLAG_LONG_DAEMON               = "--daemon";
+static constexpr std::string_view FLAG_LONG_WINDOW               = "--window";
+static constexpr std::string_view FLAG_LONG_DURATION             = "--duration";
+static constexpr std::string_view FLAG_LONG_ATTRIBUTE            = "--attribute";
+static constexpr std::string_view FLAG_LONG_LOCKS                = "--locks";
+static constexpr std::string_view FLAG_LONG_HOLD                 = "--hold";
+static constexpr std::string_view FLAG_LONG_PRIORITIES           = "--priorities";
+static constexpr std::string_view FLAG_LONG_PRIMITIVES           = "--primitives";
+static constexpr std::string_view FLAG_LONG_TIMER                = "--timer";
+static constexpr std::string_view FLAG_LONG_SAVE                 = "--save";
+static constexpr std::string_view FLAG_LONG_COMPARE              = "--compare";
+static constexpr std::string_view FLAG_LONG_CPU_LATENCY          = "--cpu-latency";
+static constexpr std::string_view FLAG_LONG_POWER                = "--power";
+static constexpr std::string_view FLAG_LONG_KERNELS              = "--kernels";
+static constexpr std::string_view FLAG_LONG_STEPS                = "--steps";
+
+static constexpr std::string_view FLAG_SHORT_HELP                 = "-h";
+static constexpr std::string_view FLAG_SHORT_NUMBER_OF_ITERATIONS = "-i";
+static constexpr std::string_view FLAG_SHORT_PRIORITY_CLASS       = "-p";
+static constexpr std::string_view FLAG_SHORT_THREAD_PRIORITY      = "-t";
+static constexpr std::string_view FLAG_SHORT_CLOCK                = "-c";
 
 static const size_t DEFAULT_M_ITERATIONS      = 10 * 1000 * 1000;
-static const DWORD  DEFAULT_M_PRIORITY_CLASS  = NORMAL_PRIORITY_CLASS;
-static const int    DEFAULT_M_THREAD_PRIORITY = THREAD_PRIORITY_NORMAL;
+#ifdef _WIN32
+static const unsigned long DEFAULT_M_PRIORITY_CLASS = NORMAL_PRIORITY_CLASS;
+#else
+static const unsigned long DEFAULT_M_PRIORITY_CLASS = SCHED_OTHER;
+#endif
+static const int    DEFAULT_M_THREAD_PRIORITY = 0;
+static const uint64_t DEFAULT_M_THRESHOLD_NANOSECONDS = 10 * 1000;
+static constexpr double DEFAULT_M_PERCENTILES[] = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+static const size_t   DEFAULT_M_WAKEUP_ITERATIONS = 1000;
+static const uint64_t DEFAULT_M_INTERVAL_NANOSECONDS = 1000 * 1000;
+static const size_t   DEFAULT_M_PERIODIC_ITERATIONS = 10 * 1000;
+static const uint64_t DEFAULT_M_TASK_PERIOD_NANOSECONDS = 1000 * 1000;
+static const uint64_t DEFAULT_DAEMON_INTERVAL_MILLISECONDS = 1000;
+static const size_t   DEFAULT_WINDOW_INTERVALS = 60;
+static const uint64_t DEFAULT_DURATION_MILLISECONDS = 5000;
+static const uint64_t DEFAULT_PROBE_SNAPSHOT_INTERVAL_MILLISECONDS = 1000;
+static const size_t   DEFAULT_M_INVERSION_ITERATIONS = 1000;
+static const uint64_t DEFAULT_M_HOLD_NANOSECONDS = 100 * 1000;
+static const size_t   DEFAULT_M_PING_PONG_ITERATIONS = 10 * 1000;
+static const size_t   DEFAULT_M_WORK_ITERATIONS = 100 * 1000;
+static const size_t   DEFAULT_M_WORK_STEPS = 500;
+static const size_t   DEFAULT_M_SURVEY_ITERATIONS = 100 * 1000 * 1000;
+
+// Measurement mode names:
+static constexpr std::string_view MODE_GAPS_STR     = "gaps";
+static constexpr std::string_view MODE_WAKEUP_STR   = "wakeup";
+static constexpr std::string_view MODE_PERIODIC_STR = "periodic";
+static constexpr std::string_view MODE_PROBE_STR    = "probe";
+static constexpr std::string_view MODE_INVERSION_STR = "inversion";
+static constexpr std::string_view MODE_PING_PONG_STR = "pingpong";
+static constexpr std::string_view MODE_WORK_STR      = "work";
+static constexpr std::string_view MODE_SURVEY_STR    = "survey";
+
+// What '--sweep all' walks through, from the lowest priority up. The
+// background modes are left out; they can be listed by name.
+static constexpr std::string_view SWEEP_ALL_STR = "all";
+
+namespace names = com::github::coderodde::wtpdmt::util;
+
+#ifdef _WIN32
+static constexpr std::string_view SWEEP_PRIORITY_CLASS_NAMES[] = {
+    names::IDLE_PRIORITY_CLASS_STR,
+    names::BELOW_NORMAL_PRIORITY_CLASS_STR,
+    names::NORMAL_PRIORITY_CLASS_STR,
+    names::ABOVE_NORMAL_PRIORITY_CLASS_STR,
+    names::HIGH_PRIORITY_CLASS_STR,
+    names::REALTIME_PRIORITY_CLASS_STR,
+};
+#else
+// SCHED_DEADLINE joins them when --sched-deadline is given:
+static constexpr std::string_view SWEEP_PRIORITY_CLASS_NAMES[] = {
+    names::SCHED_IDLE_STR,
+    names::SCHED_BATCH_STR,
+    names::SCHED_OTHER_STR,
+    names::SCHED_RR_STR,
+    names::SCHED_FIFO_STR,
+};
+#endif
+
+static constexpr std::string_view SWEEP_THREAD_PRIORITY_NAMES[] = {
+    names::THREAD_PRIORITY_IDLE_STR,
+    names::THREAD_PRIORITY_LOWEST_STR,
+    names::THREAD_PRIORITY_BELOW_NORMAL_STR,
+    names::THREAD_PRIORITY_NORMAL_STR,
+    names::THREAD_PRIORITY_ABOVE_NORMAL_STR,
+    names::THREAD_PRIORITY_HIGHEST_STR,
+    names::THREAD_PRIORITY_TIME_CRITICAL_STR,
+};
+
+// Low, medium and high, as names so that they map under any class:
+static constexpr std::string_view DEFAULT_INVERSION_THREAD_PRIORITY_NAMES[] = {
+    names::THREAD_PRIORITY_LOWEST_STR,
+    names::THREAD_PRIORITY_NORMAL_STR,
+    names::THREAD_PRIORITY_HIGHEST_STR
+};
+
+static std::vector<string> ParseSweepList(std::string_view list, std::span<const std::string_view> all_names) {
+    if (list.empty() || list == SWEEP_ALL_STR) {
+        return std::vector<string>(all_names.begin(), all_names.end());
+    }
+
+    std::vector<string> names;
+    std::string_view name;
+
+    while (nextListItem(list, ',', &name)) {
+        names.emplace_back(name);
+    }
+
+    return names;
+}
+
+// Memory policy names:
+static constexpr std::string_view MEMORY_LOCK_STR        = "lock";
+static constexpr std::string_view MEMORY_PREFAULT_STR    = "prefault";
+static constexpr std::string_view MEMORY_LARGE_PAGES_STR = "large-pages";
 
 com::github::coderodde::wtpdmt::util::CommandLineParser::CommandLineParser(int argc, char* argv[]) :
     m_iteration_flag_present      { false },
     m_priority_class_flag_present { false },
     m_thread_priority_flag_present{ false },
+    m_clock_flag_present          { false },
+    m_percentiles_flag_present    { false },
+    m_threads_flag_present        { false },
+    m_cpus_flag_present           { false },
+    m_trace_flag_present          { false },
+    m_threshold_flag_present      { false },
+    m_mode_flag_present           { false },
+    m_interval_flag_present       { false },
+    m_mechanisms_flag_present     { false },
+    m_tasks_flag_present          { false },
+    m_sched_deadline_flag_present { false },
+    m_memory_flag_present         { false },
+    m_sweep_flag_present          { false },
+    m_load_flag_present           { false },
+    m_report_interval_flag_present{ false },
+    m_report_format_flag_present  { false },
+    m_daemon_flag_present         { false },
+    m_window_flag_present         { false },
+    m_duration_flag_present       { false },
+    m_attribute_flag_present      { false },
+    m_locks_flag_present          { false },
+    m_hold_flag_present           { false },
+    m_priorities_flag_present     { false },
+    m_primitives_flag_present     { false },
+    m_timer_flag_present          { false },
+    m_save_flag_present           { false },
+    m_compare_flag_present        { false },
+    m_cpu_latency_flag_present    { false },
+    m_power_flag_present          { false },
+    m_kernels_flag_present        { false },
+    m_steps_flag_present          { false },
     m_help_flag_present           { false },
     m_argv                        { argv },
     m_argc                        { argc },
     m_argument_index              { 1 },
     m_iterations     { DEFAULT_M_ITERATIONS },
     m_priority_class { DEFAULT_M_PRIORITY_CLASS },
-    m_thread_priority{ DEFAULT_M_THREAD_PRIORITY }
+    m_thread_priority{ DEFAULT_M_THREAD_PRIORITY },
+    m_clock_source   { Clock::getDefaultSource() },
+    m_percentiles    {},
+    m_threads        { 0 },
+    m_threshold_nanoseconds{ DEFAULT_M_THRESHOLD_NANOSECONDS },
+    m_mode           { MeasurementMode::GAPS },
+    m_interval_nanoseconds{ DEFAULT_M_INTERVAL_NANOSECONDS },
+    m_mechanisms     {},
+    m_sched_deadline_parameters{},
+    m_memory_policy{ false, false, false },
+    m_report_interval_milliseconds{ 0 },
+    m_report_format{ LiveReportFormat::CSV },
+    m_window_intervals{ DEFAULT_WINDOW_INTERVALS },
+    m_duration_milliseconds{ DEFAULT_DURATION_MILLISECONDS },
+    m_attribution_threshold_nanoseconds{ 0 },
+    m_locks{},
+    m_hold_nanoseconds{ DEFAULT_M_HOLD_NANOSECONDS },
+    m_scenario_thread_priority_values{},
+    m_primitives{},
+    m_timer_nanoseconds{},
+    m_save_path{},
+    m_compare_path{},
+    m_cpu_latency_microseconds{ 0 },
+    m_power_threshold_nanoseconds{ 0 },
+    m_kernels{},
+    m_steps{ DEFAULT_M_WORK_STEPS }
 {
-    loadDispatchMap();
-    loadPriorityClassNameMap();
-    loadThreadPriorityNameMap();
-    loadPriorityClassNumberSet();
-    loadThreadPriorityNumberSet();
-    loadFlagSet();
     parseCommandLine();
 }
 
 size_t com::github::coderodde::wtpdmt::util::CommandLineParser::getNumberOfIterations() {
+    // Every wakeup takes about an interval, so the spinning default would
+    // run for hours:
+    if (m_mode == MeasurementMode::WAKEUP && !m_iteration_flag_present) {
+        return DEFAULT_M_WAKEUP_ITERATIONS;
+    }
+
+    if (m_mode == MeasurementMode::PERIODIC && !m_iteration_flag_present) {
+        return DEFAULT_M_PERIODIC_ITERATIONS;
+    }
+
+    if (m_mode == MeasurementMode::INVERSION && !m_iteration_flag_present) {
+        return DEFAULT_M_INVERSION_ITERATIONS;
+    }
+
+    if (m_mode == MeasurementMode::PING_PONG && !m_iteration_flag_present) {
+        return DEFAULT_M_PING_PONG_ITERATIONS;
+    }
+
+    if (m_mode == MeasurementMode::WORK && !m_iteration_flag_present) {
+        return DEFAULT_M_WORK_ITERATIONS;
+    }
+
+    // Long enough to catch the timers that fire every second or two:
+    if (m_mode == MeasurementMode::SURVEY && !m_iteration_flag_present) {
+        return DEFAULT_M_SURVEY_ITERATIONS;
+    }
+
     return m_iterations;
 }
 
-DWORD com::github::coderodde::wtpdmt::util::CommandLineParser::getPriorityClass() {
+com::github::coderodde::wtpdmt::util::PriorityClass com::github::coderodde::wtpdmt::util::CommandLineParser::getPriorityClass() {
     return m_priority_class;
 }
 
@@ -97,33 +311,138 @@ int com::github::coderodde::wtpdmt::util::CommandLineParser::getThreadPriority()
     return m_thread_priority;
 }
 
+com::github::coderodde::wtpdmt::util::ClockSource com::github::coderodde::wtpdmt::util::CommandLineParser::getClockSource() {
+    return m_clock_source;
+}
+
+std::span<const double> com::github::coderodde::wtpdmt::util::CommandLineParser::getPercentiles() {
+    if (!m_percentiles_flag_present) {
+        return DEFAULT_M_PERCENTILES;
+    }
+
+    return m_percentiles;
+}
+
+size_t com::github::coderodde::wtpdmt::util::CommandLineParser::getNumberOfThreads() {
+    return m_threads;
+}
+
+const std::vector<int>& com::github::coderodde::wtpdmt::util::CommandLineParser::getCpus() {
+    return m_cpus;
+}
+
+std::vector<int> com::github::coderodde::wtpdmt::util::CommandLineParser::getMeasurementCpus() {
+    if (m_cpus_flag_present) {
+        if (m_threads_flag_present && m_threads != m_cpus.size()) {
+            std::stringstream ss;
+            ss << "The flag "
+               << FLAG_LONG_THREADS
+               << " asks for "
+               << m_threads
+               << " threads, but "
+               << FLAG_LONG_CPUS
+               << " lists "
+               << m_cpus.size()
+               << " CPUs.";
+
+            throw std::logic_error{ ss.str() };
+        }
+
+        return m_cpus;
+    }
+
+    if (m_threads_flag_present) {
+        // Pin the threads to the first CPUs:
+        std::vector<int> cpus;
+
+        for (size_t cpu = 0; cpu < m_threads; cpu++) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+
+        return cpus;
+    }
+
+    // A single thread wherever the scheduler puts it:
+    return std::vector<int>{ -1 };
+}
+
+bool com::github::coderodde::wtpdmt::util::CommandLineParser::traceRequested() {
+    return m_trace_flag_present;
+}
+
+const string& com::github::coderodde::wtpdmt::util::CommandLineParser::getTracePath() {
+    return m_trace_path;
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::CommandLineParser::getThresholdNanoseconds() {
+    return m_threshold_nanoseconds;
+}
+
+com::github::coderodde::wtpdmt::util::MeasurementMode com::github::coderodde::wtpdmt::util::CommandLineParser::getMode() {
+    return m_mode;
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::CommandLineParser::getIntervalNanoseconds() {
+    return m_interval_nanoseconds;
+}
+
+std::span<const com::github::coderodde::wtpdmt::WakeupMechanism> com::github::coderodde::wtpdmt::util::CommandLineParser::getMechanisms() {
+    if (!m_mechanisms_flag_present) {
+        return getSupportedWakeupMechanisms();
+    }
+
+    return m_mechanisms;
+}
+
+com::github::coderodde::wtpdmt::WakeupMechanism com::github::coderodde::wtpdmt::util::CommandLineParser::getPeriodicMechanism() {
+    return m_mechanisms_flag_present ? m_mechanisms[0] : getPreciseWakeupMechanism();
+}
+
+std::vector<com::github::coderodde::wtpdmt::PeriodicTask> com::github::coderodde::wtpdmt::util::CommandLineParser::getTasks() {
+    if (m_tasks.empty()) {
+        return std::vector<PeriodicTask>{ PeriodicTask{ DEFAULT_M_TASK_PERIOD_NANOSECONDS,
+                                                        DEFAULT_M_TASK_PERIOD_NANOSECONDS,
+                                                        m_thread_priority } };
+    }
+
+    // Tasks without a priority of their own run at the thread priority:
+    std::vector<PeriodicTask> tasks = m_tasks;
+
+    for (size_t i = 0; i < tasks.size(); i++) {
+        tasks[i].thread_priority = m_task_thread_priority_values[i].empty()
+                                 ? m_thread_priority
+                                 : parseThreadPriority(m_task_thread_priority_values[i]);
+    }
+
+    return tasks;
+}
+
 bool com::github::coderodde::wtpdmt::util::CommandLineParser::helpRequested() {
     return m_help_flag_present;
 }
 
-template<class Value>
-size_t getMapStringKeyMaximumLength(std::map<string, Value>& map) {
+template<class Entry>
+static size_t GetMaximumNameLength(std::span<const Entry> entries) {
     size_t maximum_string_length = 0;
 
-    for (const auto& i : map) {
-        maximum_string_length = max(maximum_string_length,
-                                    i.first.length());
+    for (const Entry& entry : entries) {
+        maximum_string_length = (std::max)(maximum_string_length,
+                                           entry.name.length());
     }
 
     return maximum_string_length;
 }
 
 size_t com::github::coderodde::wtpdmt::util::CommandLineParser::getMaximumPriorityClassNameLength() {
-    return getMapStringKeyMaximumLength(m_priority_class_name_map);
+    return GetMaximumNameLength(getPriorityClassNames());
 }
 
 size_t com::github::coderodde::wtpdmt::util::CommandLineParser::getMaximumThreadPriorityNameLength() {
-    return getMapStringKeyMaximumLength(m_thread_priority_name_map);
+    return GetMaximumNameLength(getThreadPriorityNames());
 }
 
 void com::github::coderodde::wtpdmt::util::CommandLineParser::printHelp() {
-    size_t maximum_class_name_length = getMapStringKeyMaximumLength(m_priority_class_name_map);
-    size_t maximum_thread_priority_name_length = getMapStringKeyMaximumLength(m_thread_priority_name_map);
+    size_t maximum_class_name_length = getMaximumPriorityClassNameLength();
 
     string programFileName = std::filesystem::path(m_argv[0]).filename().string();
 
@@ -132,155 +451,599 @@ void com::github::coderodde::wtpdmt::util::CommandLineParser::printHelp() {
               << "[" << FLAG_SHORT_PRIORITY_CLASS       << "|" << FLAG_LONG_PRIORITY_CLASS       << " <CLASS>] "
               << "[" << FLAG_SHORT_THREAD_PRIORITY      << "|" << FLAG_LONG_THREAD_PRIORITY      << " <THREAD>] "
               << "[" << FLAG_SHORT_NUMBER_OF_ITERATIONS << "|" << FLAG_LONG_NUMBER_OF_ITERATIONS << " <ITERATIONS>] "
+              << "[" << FLAG_SHORT_CLOCK                << "|" << FLAG_LONG_CLOCK                << " <CLOCK>] "
+              << "[" << FLAG_LONG_PERCENTILES << " <PERCENTILES>] "
+              << "[" << FLAG_LONG_THREADS << " <THREADS>] "
+              << "[" << FLAG_LONG_CPUS << " <CPUS>] "
+              << "[" << FLAG_LONG_TRACE << " <FILE>] "
+              << "[" << FLAG_LONG_THRESHOLD << " <NANOSECONDS>] "
+              << "[" << FLAG_LONG_MODE << " <MODE>] "
+              << "[" << FLAG_LONG_INTERVAL << " <NANOSECONDS>] "
+              << "[" << FLAG_LONG_MECHANISMS << " <MECHANISMS>] "
+              << "[" << FLAG_LONG_TASKS << " <TASKS>] "
+              << "[" << FLAG_LONG_SCHED_DEADLINE << " <RUNTIME>:<DEADLINE>:<PERIOD>] "
+              << "[" << FLAG_LONG_MEMORY << " <MEMORY>] "
+              << "[" << FLAG_LONG_SWEEP << " <CLASSES>[:<THREADS>]] "
+              << "[" << FLAG_LONG_LOAD << " <LOADS>] "
+              << "[" << FLAG_LONG_REPORT_INTERVAL << " <MILLISECONDS>] "
+              << "[" << FLAG_LONG_REPORT_FORMAT << " <FORMAT>] "
+              << "[" << FLAG_LONG_DAEMON << " <NAME>] "
+              << "[" << FLAG_LONG_WINDOW << " <INTERVALS>] "
+              << "[" << FLAG_LONG_DURATION << " <MILLISECONDS>] "
+              << "[" << FLAG_LONG_ATTRIBUTE << " <NANOSECONDS>] "
+              << "[" << FLAG_LONG_LOCKS << " <LOCKS>] "
+              << "[" << FLAG_LONG_HOLD << " <NANOSECONDS>] "
+              << "[" << FLAG_LONG_PRIORITIES << " <THREADS>] "
+              << "[" << FLAG_LONG_PRIMITIVES << " <PRIMITIVES>] "
+              << "[" << FLAG_LONG_TIMER << " <TIMERS>] "
+              << "[" << FLAG_LONG_SAVE << " <FILE>] "
+              << "[" << FLAG_LONG_COMPARE << " <FILE>] "
+              << "[" << FLAG_LONG_CPU_LATENCY << " <MICROSECONDS>] "
+              << "[" << FLAG_LONG_POWER << " <NANOSECONDS>] "
+              << "[" << FLAG_LONG_KERNELS << " <KERNELS>] "
+              << "[" << FLAG_LONG_STEPS << " <STEPS>] "
               << "[" << FLAG_SHORT_HELP                 << "|" << FLAG_LONG_HELP                 << "]\n"
               << "where:\n\n"
               << "  <CLASS> is one of: \n";
 
+#ifndef _WIN32
+    // Linux takes scheduling policies in place of priority classes:
+    for (const PriorityClassName& entry : getPriorityClassNames()) {
+        std::cout
+            << "    "
+            << std::setw(maximum_class_name_length)
+            << std::left
+            << entry.name
+            << " -- Sets the scheduling policy of the measuring threads to "
+            << entry.priority_class
+            << (entry.priority_class == DEFAULT_M_PRIORITY_CLASS ? " (default)" : "")
+            << "\n";
+    }
+
+    std::cout << "\n  or one of the Windows priority classes, which map to:\n";
+
+    for (const auto& mapping : PRIORITY_CLASS_POLICY_MAPPING) {
+        std::cout
+            << "    "
+            << std::setw(MAXIMUM_WINDOWS_NAME_LENGTH)
+            << std::left
+            << mapping.first
+            << " -- "
+            << getPriorityClassName(static_cast<PriorityClass>(mapping.second))
+            << "\n";
+    }
+
+    std::cout << "\n  <THREAD> is a nice level in [" << MINIMUM_NICE << ", " << MAXIMUM_NICE
+              << "] under SCHED_OTHER and SCHED_BATCH, a real-time"
+              << "\n  priority in [" << sched_get_priority_min(SCHED_FIFO) << ", "
+              << sched_get_priority_max(SCHED_FIFO) << "] under SCHED_FIFO and SCHED_RR, and ignored otherwise,"
+              << "\n  or one of the Windows thread priorities, which map to:\n"
+              << "    " << std::setw(MAXIMUM_WINDOWS_NAME_LENGTH) << std::left << ""
+              << "    nice  real-time\n";
+
+    for (const ThreadPriorityMapping& mapping : THREAD_PRIORITY_MAPPING) {
+        std::cout
+            << "    "
+            << std::setw(MAXIMUM_WINDOWS_NAME_LENGTH)
+            << std::left
+            << mapping.name
+            << " -- "
+            << std::right
+            << std::setw(4)
+            << mapping.nice
+            << std::setw(11)
+            << mapping.realtime_priority
+            << (mapping.name == THREAD_PRIORITY_NORMAL_STR ? " (default)" : "")
+            << "\n";
+    }
+
+    std::cout << "\n  " << SCHED_DEADLINE_STR << " needs " << FLAG_LONG_SCHED_DEADLINE
+              << " with the runtime, relative deadline and period"
+              << "\n  of the measuring threads in nanoseconds, for example 200000:1000000:1000000.\n";
+#else
+    size_t maximum_thread_priority_name_length = getMaximumThreadPriorityNameLength();
+
     std::cout << std::hex << std::setfill(' ');
 
-    for (auto& i : m_priority_class_name_map) {
+    for (const PriorityClassName& entry : getPriorityClassNames()) {
         std::cout
             << "    "
             << std::setw(maximum_class_name_length)
             << std::left
             << std::setfill(' ')
-            << i.first
+            << entry.name
             << " -- Sets the process class to 0x"
             << std::hex
             << std::right
             << std::setfill('0')
             << std::setw(8)
-            << i.second
+            << entry.priority_class
             << " = "
             << std::dec
-            << i.second
-            << (i.second == DEFAULT_M_PRIORITY_CLASS ? " (default)" : "")
+            << entry.priority_class
+            << (entry.priority_class == DEFAULT_M_PRIORITY_CLASS ? " (default)" : "")
             << "\n";
     }
 
     std::cout << "\n  <THREAD> is one of:\n";
 
-    for (auto& i : m_thread_priority_name_map) {
+    for (const ThreadPriorityName& entry : getThreadPriorityNames()) {
         std::cout
             << "    "
             << std::setw(maximum_thread_priority_name_length)
             << std::left
             << std::setfill(' ')
-            << i.first
+            << entry.name
             << " -- Sets the thread priority to 0x"
             << std::hex
             << std::right
             << std::setfill('0')
             << std::setw(8)
-            << i.second
+            << entry.thread_priority
             << " = "
             << std::dec
-            << i.second
-            << (i.second == DEFAULT_M_THREAD_PRIORITY ? " (default)" : "")
+            << entry.thread_priority
+            << (entry.thread_priority == DEFAULT_M_THREAD_PRIORITY ? " (default)" : "")
+            << "\n";
+    }
+#endif
+
+    std::cout << "\n  <CLOCK> is one of:\n";
+
+    for (ClockSource source : Clock::getSupportedSources()) {
+        std::cout
+            << "    "
+            << Clock::getSourceName(source)
+            << (source == Clock::getDefaultSource() ? " (default)" : "")
             << "\n";
     }
 
+    std::cout << "\n  <PERCENTILES> is a comma-separated list of percentiles in (0, 100], "
+              << "for example 50,99,99.9 (default: ";
+
+    for (size_t i = 0; i < std::size(DEFAULT_M_PERCENTILES); i++) {
+        std::cout << (i == 0 ? "" : ",") << DEFAULT_M_PERCENTILES[i];
+    }
+
+    std::cout << ")\n";
+
+    std::cout << "\n  <THREADS> is the number of measuring threads, pinned to CPUs 0 to <THREADS> - 1"
+              << "\n  <CPUS> is a CPU list such as 0-3,6 with one pinned measuring thread per CPU"
+              << "\n  Without either, a single unpinned thread is measured.\n"
+              << "\n  <FILE> receives a binary trace of every gap of at least <NANOSECONDS>"
+              << "\n  (default: " << DEFAULT_M_THRESHOLD_NANOSECONDS << " ns) with its wall-clock timestamp.\n"
+              << "\n  <MODE> is one of:"
+              << "\n    " << MODE_GAPS_STR << " -- Spins on the clock and records the gaps between reads (default)"
+              << "\n    " << MODE_WAKEUP_STR << " -- Sleeps for " << FLAG_LONG_INTERVAL << " <NANOSECONDS> (default: "
+              << DEFAULT_M_INTERVAL_NANOSECONDS << " ns)"
+              << "\n      and records how late each wakeup is; <ITERATIONS> defaults to "
+              << DEFAULT_M_WAKEUP_ITERATIONS << " here"
+              << "\n    " << MODE_PERIODIC_STR << " -- Runs " << FLAG_LONG_TASKS << " <TASKS> on an absolute release schedule and"
+              << "\n      reports release latency, period jitter and deadline misses; <ITERATIONS>"
+              << "\n      counts releases per task and defaults to " << DEFAULT_M_PERIODIC_ITERATIONS << " here"
+              << "\n    " << MODE_PROBE_STR << " -- Runs the embeddable jitter probe for " << FLAG_LONG_DURATION << " <MILLISECONDS> (default: "
+              << DEFAULT_DURATION_MILLISECONDS << ")"
+              << "\n      on at most one CPU, snapshots it every " << FLAG_LONG_REPORT_INTERVAL << " (default: "
+              << DEFAULT_PROBE_SNAPSHOT_INTERVAL_MILLISECONDS << ") milliseconds and"
+              << "\n      prints every snapshot; <NANOSECONDS> is the callback threshold"
+              << "\n    " << MODE_INVERSION_STR << " -- Runs a priority inversion on every lock in " << FLAG_LONG_LOCKS << " <LOCKS>; see below"
+              << "\n    " << MODE_PING_PONG_STR << " -- Bounces a token between two threads with every primitive in"
+              << "\n      " << FLAG_LONG_PRIMITIVES << " <PRIMITIVES>; see below"
+              << "\n    " << MODE_WORK_STR << " -- Times a fixed amount of work per iteration with every kernel in"
+              << "\n      " << FLAG_LONG_KERNELS << " <KERNELS>; see below"
+              << "\n    " << MODE_SURVEY_STR << " -- Measures the gaps on every CPU at once and suggests which"
+              << "\n      cores to isolate; see below\n"
+              << "\n  <TASKS> is a comma-separated list of <PERIOD>[:<THREAD>[:<DEADLINE>]] in nanoseconds,"
+              << "\n  for example 1000000:THREAD_PRIORITY_HIGHEST,100000:15:50000. <THREAD> defaults to the"
+              << "\n  thread priority and <DEADLINE> to <PERIOD>. <CPUS> gives one CPU per task or one CPU"
+              << "\n  for all of them (default: one task with a period of " << DEFAULT_M_TASK_PERIOD_NANOSECONDS << " ns)\n"
+              << "\n  <MECHANISMS> is a comma-separated list of wakeup mechanisms (default: all). The"
+              << "\n  periodic mode waits with the first one (default: "
+              << getWakeupMechanismName(getPreciseWakeupMechanism()) << "):\n";
+
+    for (WakeupMechanism mechanism : getSupportedWakeupMechanisms()) {
+        std::cout << "    " << getWakeupMechanismName(mechanism) << "\n";
+    }
+
+    std::cout << "\n  <MEMORY> is a comma-separated list of:"
+              << "\n    " << MEMORY_LOCK_STR << " -- Locks all memory of the process into RAM"
+#ifdef _WIN32
+              << " (a larger working set plus VirtualLock())"
+#else
+              << " (mlockall())"
+#endif
+              << "\n    " << MEMORY_PREFAULT_STR << " -- Touches the measurement buffers and thread stacks before measuring"
+              << "\n    " << MEMORY_LARGE_PAGES_STR << " -- Backs the measurement buffers with "
+#ifdef _WIN32
+              << "large pages (needs SeLockMemoryPrivilege)"
+#else
+              << "huge pages (reserved or transparent)"
+#endif
+              << "\n  Page faults during the run are reported either way.\n"
+              << "\n  " << FLAG_LONG_SWEEP << " measures gaps at every combination of <CLASSES> and <THREADS>, which"
+              << "\n  are comma-separated lists of the names or values above or '" << SWEEP_ALL_STR << "' (the default for"
+              << "\n  <THREADS>). '" << SWEEP_ALL_STR << "' leaves out the background modes"
+#ifndef _WIN32
+              << " and, without " << FLAG_LONG_SCHED_DEADLINE << ", " << SCHED_DEADLINE_STR
+#endif
+              << ". Each combination"
+              << "\n  warms up for a tenth of <ITERATIONS> first; a matrix of the tails closes the report.\n"
+              << "\n  <LOADS> runs background load during the measurement. It is a '+'-separated list of"
+              << "\n  <KIND>[:<CPUS>[:<CLASS>[:<THREAD>]]] with one load thread per CPU in <CPUS> (default:"
+              << "\n  one unpinned thread)"
+#ifdef _WIN32
+              << ". <CLASS> must be left empty, as the priority class belongs to the"
+              << "\n  process. <THREAD> defaults to " << THREAD_PRIORITY_NORMAL_STR << ","
+#else
+              << ", <CLASS> defaults to " << SCHED_OTHER_STR << " and <THREAD> to"
+              << "\n  " << THREAD_PRIORITY_NORMAL_STR << ","
+#endif
+              << " for example spin:0-3+memory:1::" << THREAD_PRIORITY_LOWEST_STR << ". <KIND> is one of:";
+
+    for (LoadKind kind : getLoadKinds()) {
+        std::cout << "\n    " << getLoadKindName(kind);
+    }
+
+    std::cout << "\n\n  " << FLAG_LONG_REPORT_INTERVAL << " prints the gaps of every <MILLISECONDS> while the "
+              << MODE_GAPS_STR << " mode runs,"
+              << "\n  from a background thread that the measuring threads never wait for. <FORMAT> is "
+              << getLiveReportFormatName(LiveReportFormat::CSV) << " (default)"
+              << "\n  or " << getLiveReportFormatName(LiveReportFormat::JSON) << " (one object per line).\n";
+
+    std::cout << "\n  " << FLAG_LONG_DAEMON << " measures gaps until SIGINT or SIGTERM and publishes them into the shared"
+              << "\n  memory segment " << SharedMemory::getSystemName("<NAME>") << " every "
+              << FLAG_LONG_REPORT_INTERVAL << " (default " << DEFAULT_DAEMON_INTERVAL_MILLISECONDS << ") milliseconds:"
+              << "\n  the last interval, the last <INTERVALS> intervals (default " << DEFAULT_WINDOW_INTERVALS << ")"
+              << "\n  and everything since the start, per thread. Read it with wtshm <NAME>.\n";
+
+    std::cout << "\n  " << FLAG_LONG_ATTRIBUTE << " classifies every gap of at least <NANOSECONDS> in the " << MODE_GAPS_STR << " mode"
+              << "\n  as descheduled (the thread switched out), interrupt/SMI-like (the thread was"
+              << "\n  charged for the gap) or steal (neither, and no interrupts on its CPU). Each"
+#ifdef _WIN32
+              << "\n  classified gap costs a few microseconds; without switch counts Windows knows"
+              << "\n  no steal. The next gap starts after it.\n";
+#else
+              << "\n  classified gap costs tens of microseconds reading /proc; the next gap starts"
+              << "\n  after it.\n";
+#endif
+
+    std::cout << "\n  The " << MODE_INVERSION_STR << " mode runs a low-, a medium- and a high-priority thread on the"
+              << "\n  first of <CPUS> (default: 0) at the " << FLAG_LONG_PRIORITIES << " <LOW>,<MEDIUM>,<HIGH> of <CLASS>"
+              << "\n  (default: " << DEFAULT_INVERSION_THREAD_PRIORITY_NAMES[0] << ","
+              << DEFAULT_INVERSION_THREAD_PRIORITY_NAMES[1] << ","
+              << "\n  " << DEFAULT_INVERSION_THREAD_PRIORITY_NAMES[2] << "). The low thread holds the lock for "
+              << FLAG_LONG_HOLD << " <NANOSECONDS>"
+              << "\n  (default: " << DEFAULT_M_HOLD_NANOSECONDS << ") while the medium thread spins for ten times as long;"
+              << "\n  the report shows how long the high thread waited. <ITERATIONS> defaults to "
+              << DEFAULT_M_INVERSION_ITERATIONS << " here."
+              << "\n  A real-time <CLASS> shows the inversion best. <LOCKS> is a comma-separated list of"
+              << "\n  (default: all):\n";
+
+    for (LockKind kind : getSupportedLockKinds()) {
+        std::cout << "    " << getLockKindName(kind) << "\n";
+    }
+
+    std::cout << "\n  The " << MODE_PING_PONG_STR << " mode runs a ping and a pong thread at " << FLAG_LONG_PRIORITIES
+              << " <PING>,<PONG>"
+              << "\n  (default: <THREAD> for both) and reports round-trip and one-way latencies. With"
+              << "\n  two <CPUS> it runs on those, with one on that CPU alone, and otherwise on CPU 0"
+              << "\n  paired with itself, an SMT sibling, a core of the same package and one of another"
+              << "\n  package where there are any. <ITERATIONS> counts round trips and defaults to "
+              << DEFAULT_M_PING_PONG_ITERATIONS << " here."
+              << "\n  <PRIMITIVES> is a comma-separated list of (default: all):\n";
+
+    for (HandoffPrimitive primitive : getSupportedHandoffPrimitives()) {
+        std::cout << "    " << getHandoffPrimitiveName(primitive) << "\n";
+    }
+
+    std::cout << "\n  The " << MODE_WORK_STR << " mode runs <STEPS> (default: " << DEFAULT_M_WORK_STEPS
+              << ") steps of a kernel per iteration on the measuring"
+              << "\n  threads and records how long each iteration takes. Where the gaps show when a"
+              << "\n  thread does not run, this shows how evenly it gets work done while it runs. A step"
+              << "\n  is a multiply (alu), a hop through a random cycle over half of a cache (chase-*)"
+              << "\n  or an element of a triad over arrays half the size of L2 (stream). <ITERATIONS>"
+              << "\n  defaults to " << DEFAULT_M_WORK_ITERATIONS << " here."
+              << "\n  <KERNELS> is a comma-separated list of (default: all):\n";
+
+    for (WorkKernel kernel : getWorkKernels()) {
+        std::cout << "    " << getWorkKernelName(kernel) << "\n";
+    }
+
+    std::cout << "\n  The " << MODE_SURVEY_STR << " mode runs a pinned measuring thread on each of <CPUS> (default:"
+              << "\n  all online CPUs) at once and counts the interrupts each CPU takes meanwhile. It"
+              << "\n  ranks the cores by the share of time lost to gaps of at least <NANOSECONDS> and"
+              << "\n  suggests isolating all but the noisiest core of each package"
+#ifdef _WIN32
+              << ", as CPU sets to reserve."
+#else
+              << ", as isolcpus, nohz_full,"
+              << "\n  rcu_nocbs and irqaffinity kernel parameters."
+#endif
+              << "\n  <ITERATIONS> defaults to " << DEFAULT_M_SURVEY_ITERATIONS << " here.\n";
+
+    std::cout << "\n  " << FLAG_LONG_TIMER << " sets the " << getTimerResolutionName() << " to <TIMERS> nanoseconds for the run"
+#ifdef _WIN32
+              << "\n  (NtSetTimerResolution(), in steps of 100 ns; Windows clamps it to what it supports)."
+#else
+              << "\n  (PR_SET_TIMERSLACK; real-time and SCHED_DEADLINE threads have no slack)."
+#endif
+              << "\n  A comma-separated list of several values sweeps them in the " << MODE_WAKEUP_STR << " mode and"
+              << "\n  compares the overshoot and the CPU time per wakeup of each.\n";
+
+    std::cout << "\n  " << FLAG_LONG_SAVE << " writes the gap distribution of a plain " << MODE_GAPS_STR << " run to <FILE>. "
+              << FLAG_LONG_COMPARE << " compares"
+              << "\n  the run with one saved earlier: percentile deltas, a Kolmogorov-Smirnov and a"
+              << "\n  Mann-Whitney test, and a test of how many gaps exceed the baseline at the highest"
+              << "\n  of <PERCENTILES>. The program exits with " << BASELINE_REGRESSION_EXIT_CODE
+              << " if that tail got worse at the "
+              << 100.0 * BASELINE_SIGNIFICANCE_LEVEL << "%"
+              << "\n  significance level.\n";
+
+    std::cout << "\n  " << FLAG_LONG_CPU_LATENCY << " keeps the CPUs out of deep idle states for the run"
+#ifdef _WIN32
+              << "\n  as far as Windows lets a process: it opts out of power throttling (EcoQoS) and"
+              << "\n  holds a system-required power request. <MICROSECONDS> is ignored.\n";
+#else
+              << "\n  by holding <MICROSECONDS> as the wakeup latency limit in /dev/cpu_dma_latency"
+              << "\n  (root only). 0 allows no idle state but polling.\n";
+#endif
+
+    std::cout << "\n  " << FLAG_LONG_POWER << " classifies every gap of at least <NANOSECONDS> in the " << MODE_GAPS_STR << " mode,"
+              << "\n  also with " << FLAG_LONG_SWEEP << ", by what power management did around it: halted (the CPU was"
+              << "\n  idle for most of it), slowed (it ran below " << 100.0 * SLOWED_FREQUENCY_RATIO
+              << "% of its nominal frequency) or full"
+#ifdef _WIN32
+              << "\n  speed. Windows tells the current frequency only, so no gap counts as halted.\n";
+#else
+              << "\n  speed. It reads APERF and MPERF from /dev/cpu/N/msr (root and the msr module), or"
+              << "\n  else the cpuidle and cpufreq files in /sys.\n";
+#endif
+
     std::cout << "\n";
 }
 
-string com::github::coderodde::wtpdmt::util::CommandLineParser::getPriorityClassName(DWORD priority_class) {
-    for (const auto& p : m_priority_class_name_map) {
-        if (p.second == priority_class) {
-            return p.first;
-        }
-    }
+const com::github::coderodde::wtpdmt::util::SchedDeadlineParameters& com::github::coderodde::wtpdmt::util::CommandLineParser::getSchedDeadlineParameters() {
+    return m_sched_deadline_parameters;
+}
+
+const com::github::coderodde::wtpdmt::util::MemoryPolicy& com::github::coderodde::wtpdmt::util::CommandLineParser::getMemoryPolicy() {
+    return m_memory_policy;
+}
 
-    std::stringstream ss;
+bool com::github::coderodde::wtpdmt::util::CommandLineParser::sweepRequested() {
+    return m_sweep_flag_present;
+}
 
-    ss << "Unknown priority class: 0x"
-       << std::setw(8)
-       << std::right
-       << std::setfill('0')
-       << std::hex
-       << priority_class
-       << " = "
-       << std::dec
-       << priority_class
-       << ".";
+const std::vector<string>& com::github::coderodde::wtpdmt::util::CommandLineParser::getSweepClassNames() {
+    return m_sweep_class_names;
+}
 
-    throw std::logic_error{ ss.str() };
+const std::vector<string>& com::github::coderodde::wtpdmt::util::CommandLineParser::getSweepThreadPriorityNames() {
+    return m_sweep_thread_priority_names;
 }
 
-string com::github::coderodde::wtpdmt::util::CommandLineParser::getThreadPriorityName(int thread_priority) {
-    for (const auto& p : m_thread_priority_name_map) {
-        if (p.second == thread_priority) {
-            return p.first;
-        }
-    }
+const std::vector<com::github::coderodde::wtpdmt::SweepPoint>& com::github::coderodde::wtpdmt::util::CommandLineParser::getSweepPoints() {
+    return m_sweep_points;
+}
+
+const std::vector<com::github::coderodde::wtpdmt::LoadSpecification>& com::github::coderodde::wtpdmt::util::CommandLineParser::getLoads() {
+    return m_loads;
+}
 
-    std::stringstream ss;
+uint64_t com::github::coderodde::wtpdmt::util::CommandLineParser::getReportIntervalMilliseconds() {
+    return m_report_interval_milliseconds;
+}
+
+com::github::coderodde::wtpdmt::LiveReportFormat com::github::coderodde::wtpdmt::util::CommandLineParser::getReportFormat() {
+    return m_report_format;
+}
 
-    ss << "Unknown thread priority: 0x"
-       << std::hex
-       << thread_priority
-       << " = "
-       << std::dec
-       << thread_priority
-       << ".";
+bool com::github::coderodde::wtpdmt::util::CommandLineParser::daemonRequested() {
+    return m_daemon_flag_present;
+}
 
-    throw std::logic_error{ ss.str() };
+const string& com::github::coderodde::wtpdmt::util::CommandLineParser::getDaemonSegmentName() {
+    return m_daemon_segment_name;
 }
 
-void com::github::coderodde::wtpdmt::util::CommandLineParser::loadDispatchMap() {
-    std::function<void(CommandLineParser&)> function_flag_iterations = &CommandLineParser::processIterationFlags;
+uint64_t com::github::coderodde::wtpdmt::util::CommandLineParser::getDaemonIntervalMilliseconds() {
+    return m_report_interval_flag_present ? m_report_interval_milliseconds : DEFAULT_DAEMON_INTERVAL_MILLISECONDS;
+}
 
-    m_flag_processor_map[FLAG_LONG_NUMBER_OF_ITERATIONS]  = function_flag_iterations;
-    m_flag_processor_map[FLAG_SHORT_NUMBER_OF_ITERATIONS] = function_flag_iterations;
+size_t com::github::coderodde::wtpdmt::util::CommandLineParser::getWindowIntervals() {
+    return m_window_intervals;
+}
 
-    std::function<void(CommandLineParser&)> function_flag_priority_class = &CommandLineParser::processPriorityClassFlags;
+uint64_t com::github::coderodde::wtpdmt::util::CommandLineParser::getDurationMilliseconds() {
+    return m_duration_milliseconds;
+}
 
-    m_flag_processor_map[FLAG_LONG_PRIORITY_CLASS]  = function_flag_priority_class;
-    m_flag_processor_map[FLAG_SHORT_PRIORITY_CLASS] = function_flag_priority_class;
+uint64_t com::github::coderodde::wtpdmt::util::CommandLineParser::getProbeSnapshotIntervalMilliseconds() {
+    return m_report_interval_flag_present ? m_report_interval_milliseconds : DEFAULT_PROBE_SNAPSHOT_INTERVAL_MILLISECONDS;
+}
 
-    std::function<void(CommandLineParser&)> function_flag_thread_priority = &CommandLineParser::processThreadPriorityFlags;
+bool com::github::coderodde::wtpdmt::util::CommandLineParser::attributionRequested() {
+    return m_attribute_flag_present;
+}
 
-    m_flag_processor_map[FLAG_LONG_THREAD_PRIORITY]  = function_flag_thread_priority;
-    m_flag_processor_map[FLAG_SHORT_THREAD_PRIORITY] = function_flag_thread_priority;
+uint64_t com::github::coderodde::wtpdmt::util::CommandLineParser::getAttributionThresholdNanoseconds() {
+    return m_attribution_threshold_nanoseconds;
+}
 
-    std::function<void(CommandLineParser&)> function_flag_help = &CommandLineParser::processHelpFlags;
+std::span<const com::github::coderodde::wtpdmt::LockKind> com::github::coderodde::wtpdmt::util::CommandLineParser::getLocks() {
+    if (!m_locks_flag_present) {
+        return getSupportedLockKinds();
+    }
 
-    m_flag_processor_map[FLAG_LONG_HELP]  = function_flag_help;
-    m_flag_processor_map[FLAG_SHORT_HELP] = function_flag_help;
+    return m_locks;
 }
 
-void com::github::coderodde::wtpdmt::util::CommandLineParser::loadPriorityClassNameMap() {
-    m_priority_class_name_map[ABOVE_NORMAL_PRIORITY_CLASS_STR]   = ABOVE_NORMAL_PRIORITY_CLASS;
-    m_priority_class_name_map[BELOW_NORMAL_PRIORITY_CLASS_STR]   = BELOW_NORMAL_PRIORITY_CLASS;
-    m_priority_class_name_map[HIGH_PRIORITY_CLASS_STR]           = HIGH_PRIORITY_CLASS;
-    m_priority_class_name_map[IDLE_PRIORITY_CLASS_STR]           = IDLE_PRIORITY_CLASS;
-    m_priority_class_name_map[NORMAL_PRIORITY_CLASS_STR]         = NORMAL_PRIORITY_CLASS;
-    m_priority_class_name_map[PROCESS_MODE_BACKGROUND_BEGIN_STR] = PROCESS_MODE_BACKGROUND_BEGIN;
-    m_priority_class_name_map[PROCESS_MODE_BACKGROUND_END_STR]   = PROCESS_MODE_BACKGROUND_END;
-    m_priority_class_name_map[REALTIME_PRIORITY_CLASS_STR]       = REALTIME_PRIORITY_CLASS;
+uint64_t com::github::coderodde::wtpdmt::util::CommandLineParser::getHoldNanoseconds() {
+    return m_hold_nanoseconds;
 }
 
-void com::github::coderodde::wtpdmt::util::CommandLineParser::loadThreadPriorityNameMap() {
-    m_thread_priority_name_map[THREAD_MODE_BACKGROUND_BEGIN_STR]  = THREAD_MODE_BACKGROUND_BEGIN;
-    m_thread_priority_name_map[THREAD_MODE_BACKGROUND_END_STR]    = THREAD_MODE_BACKGROUND_END;
-    m_thread_priority_name_map[THREAD_PRIORITY_ABOVE_NORMAL_STR]  = THREAD_PRIORITY_ABOVE_NORMAL;
-    m_thread_priority_name_map[THREAD_PRIORITY_BELOW_NORMAL_STR]  = THREAD_PRIORITY_BELOW_NORMAL;
-    m_thread_priority_name_map[THREAD_PRIORITY_HIGHEST_STR]       = THREAD_PRIORITY_HIGHEST;
-    m_thread_priority_name_map[THREAD_PRIORITY_IDLE_STR]          = THREAD_PRIORITY_IDLE;
-    m_thread_priority_name_map[THREAD_PRIORITY_LOWEST_STR]        = THREAD_PRIORITY_LOWEST;
-    m_thread_priority_name_map[THREAD_PRIORITY_NORMAL_STR]        = THREAD_PRIORITY_NORMAL;
-    m_thread_priority_name_map[THREAD_PRIORITY_TIME_CRITICAL_STR] = THREAD_PRIORITY_TIME_CRITICAL;
+// One priority per thread of the inversion or the ping-pong mode.
+std::vector<int> com::github::coderodde::wtpdmt::util::CommandLineParser::getScenarioThreadPriorities() {
+    std::vector<string> values = m_scenario_thread_priority_values;
+
+    if (values.empty() && m_mode == MeasurementMode::INVERSION) {
+        values.assign(std::begin(DEFAULT_INVERSION_THREAD_PRIORITY_NAMES),
+                      std::end(DEFAULT_INVERSION_THREAD_PRIORITY_NAMES));
+    }
+
+    if (values.empty()) {
+        return std::vector<int>(PING_PONG_THREAD_COUNT, m_thread_priority);
+    }
+
+    std::vector<int> thread_priorities;
+
+    for (string& value : values) {
+        thread_priorities.push_back(parseThreadPriority(value));
+    }
+
+    return thread_priorities;
 }
 
-void com::github::coderodde::wtpdmt::util::CommandLineParser::loadPriorityClassNumberSet() {
-    for (const auto& p : m_priority_class_name_map) {
-        m_priority_class_number_set.emplace(p.second);
+std::span<const com::github::coderodde::wtpdmt::HandoffPrimitive> com::github::coderodde::wtpdmt::util::CommandLineParser::getPrimitives() {
+    if (!m_primitives_flag_present) {
+        return getSupportedHandoffPrimitives();
     }
+
+    return m_primitives;
+}
+
+const std::vector<uint64_t>& com::github::coderodde::wtpdmt::util::CommandLineParser::getTimerNanoseconds() {
+    return m_timer_nanoseconds;
+}
+
+bool com::github::coderodde::wtpdmt::util::CommandLineParser::saveRequested() {
+    return m_save_flag_present;
+}
+
+const string& com::github::coderodde::wtpdmt::util::CommandLineParser::getSavePath() {
+    return m_save_path;
+}
+
+bool com::github::coderodde::wtpdmt::util::CommandLineParser::compareRequested() {
+    return m_compare_flag_present;
+}
+
+const string& com::github::coderodde::wtpdmt::util::CommandLineParser::getComparePath() {
+    return m_compare_path;
+}
+
+bool com::github::coderodde::wtpdmt::util::CommandLineParser::cpuLatencyRequested() {
+    return m_cpu_latency_flag_present;
 }
 
-void com::github::coderodde::wtpdmt::util::CommandLineParser::loadThreadPriorityNumberSet() {
-    for (const auto& p : m_thread_priority_name_map) {
-        m_thread_priority_number_set.emplace(p.second);
+uint64_t com::github::coderodde::wtpdmt::util::CommandLineParser::getCpuLatencyMicroseconds() {
+    return m_cpu_latency_microseconds;
+}
+
+bool com::github::coderodde::wtpdmt::util::CommandLineParser::powerRequested() {
+    return m_power_flag_present;
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::CommandLineParser::getPowerThresholdNanoseconds() {
+    return m_power_threshold_nanoseconds;
+}
+
+std::span<const com::github::coderodde::wtpdmt::WorkKernel> com::github::coderodde::wtpdmt::util::CommandLineParser::getKernels() {
+    if (!m_kernels_flag_present) {
+        return getWorkKernels();
     }
+
+    return m_kernels;
+}
+
+size_t com::github::coderodde::wtpdmt::util::CommandLineParser::getSteps() {
+    return m_steps;
+}
+
+string com::github::coderodde::wtpdmt::util::CommandLineParser::getPriorityClassName(PriorityClass priority_class) {
+    return com::github::coderodde::wtpdmt::util::getPriorityClassName(priority_class);
+}
+
+string com::github::coderodde::wtpdmt::util::CommandLineParser::getThreadPriorityName(int thread_priority) {
+    return com::github::coderodde::wtpdmt::util::getThreadPriorityName(m_priority_class, thread_priority);
+}
+
+string com::github::coderodde::wtpdmt::util::CommandLineParser::getEffectiveThreadPriorityName(PriorityClass priority_class,
+                                                                                              int thread_priority) {
+#ifdef _WIN32
+    return getThreadPriorityName(thread_priority);
+#else
+    return getPriorityClassName(priority_class)
+         + ", "
+         + describeThreadPriority(priority_class, thread_priority);
+#endif
+}
+
+com::github::coderodde::wtpdmt::util::CommandLineParser::FlagProcessor
+com::github::coderodde::wtpdmt::util::CommandLineParser::findFlagProcessor(std::string_view flag) {
+    struct FlagEntry {
+        std::string_view flag;
+        FlagProcessor    processor;
+    };
+
+    // Sorted by flag for the binary search below; the long flags sort
+    // before the short ones:
+    static constexpr FlagEntry FLAG_TABLE[] = {
+        { FLAG_LONG_ATTRIBUTE,            &CommandLineParser::processAttributeFlags       },
+        { FLAG_LONG_CLOCK,                &CommandLineParser::processClockFlags           },
+        { FLAG_LONG_COMPARE,              &CommandLineParser::processCompareFlags         },
+        { FLAG_LONG_CPU_LATENCY,          &CommandLineParser::processCpuLatencyFlags      },
+        { FLAG_LONG_CPUS,                 &CommandLineParser::processCpusFlags            },
+        { FLAG_LONG_DAEMON,               &CommandLineParser::processDaemonFlags          },
+        { FLAG_LONG_DURATION,             &CommandLineParser::processDurationFlags        },
+        { FLAG_LONG_HELP,                 &CommandLineParser::processHelpFlags            },
+        { FLAG_LONG_HOLD,                 &CommandLineParser::processHoldFlags            },
+        { FLAG_LONG_INTERVAL,             &CommandLineParser::processIntervalFlags        },
+        { FLAG_LONG_NUMBER_OF_ITERATIONS, &CommandLineParser::processIterationFlags       },
+        { FLAG_LONG_KERNELS,              &CommandLineParser::processKernelsFlags         },
+        { FLAG_LONG_LOAD,                 &CommandLineParser::processLoadFlags            },
+        { FLAG_LONG_LOCKS,                &CommandLineParser::processLocksFlags           },
+        { FLAG_LONG_MECHANISMS,           &CommandLineParser::processMechanismsFlags      },
+        { FLAG_LONG_MEMORY,               &CommandLineParser::processMemoryFlags          },
+        { FLAG_LONG_MODE,                 &CommandLineParser::processModeFlags            },
+        { FLAG_LONG_PERCENTILES,          &CommandLineParser::processPercentilesFlags     },
+        { FLAG_LONG_POWER,                &CommandLineParser::processPowerFlags           },
+        { FLAG_LONG_PRIMITIVES,           &CommandLineParser::processPrimitivesFlags      },
+        { FLAG_LONG_PRIORITIES,           &CommandLineParser::processPrioritiesFlags      },
+        { FLAG_LONG_PRIORITY_CLASS,       &CommandLineParser::processPriorityClassFlags   },
+        { FLAG_LONG_REPORT_FORMAT,        &CommandLineParser::processReportFormatFlags    },
+        { FLAG_LONG_REPORT_INTERVAL,      &CommandLineParser::processReportIntervalFlags  },
+        { FLAG_LONG_SAVE,                 &CommandLineParser::processSaveFlags            },
+        { FLAG_LONG_SCHED_DEADLINE,       &CommandLineParser::processSchedDeadlineFlags   },
+        { FLAG_LONG_STEPS,                &CommandLineParser::processStepsFlags           },
+        { FLAG_LONG_SWEEP,                &CommandLineParser::processSweepFlags           },
+        { FLAG_LONG_TASKS,                &CommandLineParser::processTasksFlags           },
+        { FLAG_LONG_THREAD_PRIORITY,      &CommandLineParser::processThreadPriorityFlags  },
+        { FLAG_LONG_THREADS,              &CommandLineParser::processThreadsFlags         },
+        { FLAG_LONG_THRESHOLD,            &CommandLineParser::processThresholdFlags       },
+        { FLAG_LONG_TIMER,                &CommandLineParser::processTimerFlags           },
+        { FLAG_LONG_TRACE,                &CommandLineParser::processTraceFlags           },
+        { FLAG_LONG_WINDOW,               &CommandLineParser::processWindowFlags          },
+        { FLAG_SHORT_CLOCK,               &CommandLineParser::processClockFlags           },
+        { FLAG_SHORT_HELP,                &CommandLineParser::processHelpFlags            },
+        { FLAG_SHORT_NUMBER_OF_ITERATIONS, &CommandLineParser::processIterationFlags      },
+        { FLAG_SHORT_PRIORITY_CLASS,      &CommandLineParser::processPriorityClassFlags   },
+        { FLAG_SHORT_THREAD_PRIORITY,     &CommandLineParser::processThreadPriorityFlags  },
+    };
+
+    constexpr auto flag_less = [](const FlagEntry& a, const FlagEntry& b) {
+        return a.flag < b.flag;
+    };
+
+    static_assert(std::is_sorted(std::begin(FLAG_TABLE), std::end(FLAG_TABLE), flag_less),
+                  "FLAG_TABLE must be sorted by flag.");
+
+    const FlagEntry* entry = std::lower_bound(std::begin(FLAG_TABLE),
+                                              std::end(FLAG_TABLE),
+                                              FlagEntry{ flag, nullptr },
+                                              flag_less);
+
+    return entry != std::end(FLAG_TABLE) && entry->flag == flag ? entry->processor : nullptr;
 }
 
 void com::github::coderodde::wtpdmt::util::CommandLineParser::parseCommandLine() {
@@ -291,26 +1054,162 @@ void com::github::coderodde::wtpdmt::util::CommandLineParser::parseCommandLine()
             return;
         }
     }
+
+    resolveThreadPriority();
+    resolveSweep();
+    resolveLoads();
+    resolveDaemon();
+    resolveProbe();
+    resolveAttribution();
+    resolveInversion();
+    resolvePingPong();
+    resolveTimer();
+    resolveBaseline();
+    resolvePower();
+    resolveWork();
 }
 
-void com::github::coderodde::wtpdmt::util::CommandLineParser::loadFlagSet() {
-    m_flag_set.emplace(FLAG_LONG_HELP);
-    m_flag_set.emplace(FLAG_LONG_PRIORITY_CLASS);
-    m_flag_set.emplace(FLAG_LONG_THREAD_PRIORITY);
-    m_flag_set.emplace(FLAG_LONG_NUMBER_OF_ITERATIONS);
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolveThreadPriority() {
+    // The flags may come in any order, but on Linux the meaning of a thread
+    // priority depends on the policy:
+    m_thread_priority = parseThreadPriority(m_thread_priority_flag_present
+                                            ? std::string_view(m_thread_priority_value)
+                                            : THREAD_PRIORITY_NORMAL_STR);
 
-    m_flag_set.emplace(FLAG_SHORT_HELP);
-    m_flag_set.emplace(FLAG_SHORT_PRIORITY_CLASS);
-    m_flag_set.emplace(FLAG_SHORT_THREAD_PRIORITY);
-    m_flag_set.emplace(FLAG_SHORT_NUMBER_OF_ITERATIONS);
+#ifndef _WIN32
+    if (m_priority_class == SCHED_DEADLINE && !m_sched_deadline_flag_present) {
+        std::stringstream ss;
+        ss << SCHED_DEADLINE_STR << " needs the flag " << FLAG_LONG_SCHED_DEADLINE << ".";
+        throw std::logic_error{ ss.str() };
+    }
+#endif
 }
 
-void com::github::coderodde::wtpdmt::util::CommandLineParser::checkFlagIsValid(string& flag) {
-    if (!m_flag_set.contains(flag)) {
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolveSweep() {
+    if (!m_sweep_flag_present) {
+        return;
+    }
+
+    if (m_priority_class_flag_present || m_thread_priority_flag_present) {
+        std::stringstream ss;
+        ss << "The flag " << FLAG_LONG_SWEEP << " picks the priorities itself; drop "
+           << FLAG_LONG_PRIORITY_CLASS << " and " << FLAG_LONG_THREAD_PRIORITY << ".";
+        throw std::logic_error{ ss.str() };
+    }
+
+    if (m_mode != MeasurementMode::GAPS) {
         std::stringstream ss;
-        ss << "Unknown flag: " << m_argv[m_argument_index] << ".";
+        ss << "The flag " << FLAG_LONG_SWEEP << " works in the " << MODE_GAPS_STR << " mode only.";
         throw std::logic_error{ ss.str() };
     }
+
+    size_t separator = m_sweep_value.find(':');
+    std::vector<std::string_view> all_class_names(std::begin(SWEEP_PRIORITY_CLASS_NAMES),
+                                                  std::end(SWEEP_PRIORITY_CLASS_NAMES));
+
+#ifndef _WIN32
+    if (m_sched_deadline_flag_present) {
+        all_class_names.push_back(SCHED_DEADLINE_STR);
+    }
+#endif
+
+    std::string_view sweep_value = m_sweep_value;
+    m_sweep_class_names = ParseSweepList(sweep_value.substr(0, separator), all_class_names);
+    m_sweep_thread_priority_names = ParseSweepList(separator == string::npos
+                                                   ? std::string_view{}
+                                                   : sweep_value.substr(separator + 1),
+                                                   SWEEP_THREAD_PRIORITY_NAMES);
+
+    for (size_t class_index = 0; class_index < m_sweep_class_names.size(); class_index++) {
+        PriorityClass priority_class = parsePriorityClass(m_sweep_class_names[class_index]);
+
+#ifndef _WIN32
+        if (priority_class == SCHED_DEADLINE && !m_sched_deadline_flag_present) {
+            std::stringstream ss;
+            ss << SCHED_DEADLINE_STR << " needs the flag " << FLAG_LONG_SCHED_DEADLINE << ".";
+            throw std::logic_error{ ss.str() };
+        }
+#endif
+
+        for (size_t thread_priority_index = 0;
+             thread_priority_index < m_sweep_thread_priority_names.size();
+             thread_priority_index++) {
+            SweepPoint point;
+            point.class_index           = class_index;
+            point.thread_priority_index = thread_priority_index;
+            point.priority_class        = priority_class;
+            point.thread_priority       = parseThreadPriority(m_sweep_thread_priority_names[thread_priority_index],
+                                                              priority_class);
+            m_sweep_points.push_back(point);
+        }
+    }
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolveLoads() {
+    if (!m_load_flag_present) {
+        return;
+    }
+
+    std::string_view list = m_load_value;
+    std::string_view item;
+
+    while (nextListItem(list, '+', &item)) {
+        std::string_view fields = item;
+        std::string_view kind_name;
+        std::string_view cpu_list;
+        std::string_view priority_class_value;
+        std::string_view thread_priority_value;
+
+        nextListItem(fields, ':', &kind_name);
+        nextListItem(fields, ':', &cpu_list);
+        nextListItem(fields, ':', &priority_class_value);
+        nextListItem(fields, ':', &thread_priority_value);
+
+        LoadSpecification load;
+
+        if (std::count(item.begin(), item.end(), ':') > 3 || !findLoadKind(kind_name, &load.kind)) {
+            std::stringstream ss;
+            ss << "Could not parse '" << item << "' as <KIND>[:<CPUS>[:<CLASS>[:<THREAD>]]].";
+            throw std::logic_error{ ss.str() };
+        }
+
+#ifdef _WIN32
+        if (!priority_class_value.empty()) {
+            throw std::logic_error{ "Windows has one priority class per process; leave the load <CLASS> empty." };
+        }
+
+        load.priority_class = m_priority_class;
+#else
+        load.priority_class = priority_class_value.empty()
+                            ? static_cast<PriorityClass>(SCHED_OTHER)
+                            : parsePriorityClass(priority_class_value);
+
+        if (load.priority_class == SCHED_DEADLINE) {
+            std::stringstream ss;
+            ss << "Load threads cannot run under " << SCHED_DEADLINE_STR << ".";
+            throw std::logic_error{ ss.str() };
+        }
+#endif
+
+        if (thread_priority_value.empty()) {
+            thread_priority_value = THREAD_PRIORITY_NORMAL_STR;
+        }
+
+        load.thread_priority = parseThreadPriority(thread_priority_value, load.priority_class);
+
+        std::vector<int> cpus = cpu_list.empty() || cpu_list == "-"
+                              ? std::vector<int>{ UNPINNED_CPU }
+                              : parseCpuList(cpu_list);
+
+        for (int cpu : cpus) {
+            load.cpu = cpu;
+            m_loads.push_back(load);
+        }
+    }
+
+    if (m_loads.empty()) {
+        throw std::logic_error{ "The load list is empty." };
+    }
 }
 
 void com::github::coderodde::wtpdmt::util::CommandLineParser::checkMoreParametersAvailable() {
@@ -323,7 +1222,7 @@ void com::github::coderodde::wtpdmt::util::CommandLineParser::checkMoreParameter
 }
 
 void com::github::coderodde::wtpdmt::util::CommandLineParser::processFlagPair() {
-    string flag = m_argv[m_argument_index];
+    std::string_view flag = m_argv[m_argument_index];
 
     if (flag == FLAG_LONG_HELP || flag == FLAG_SHORT_HELP) {
         m_help_flag_present = true;
@@ -331,14 +1230,20 @@ void com::github::coderodde::wtpdmt::util::CommandLineParser::processFlagPair()
     }
 
     // First check that the currently indexed flag is correct:
-    checkFlagIsValid(flag);
+    FlagProcessor processor = findFlagProcessor(flag);
+
+    if (processor == nullptr) {
+        std::stringstream ss;
+        ss << "Unknown flag: " << flag << ".";
+        throw std::logic_error{ ss.str() };
+    }
 
     // Check that there is more parameters in the command line:
     m_argument_index++;
     checkMoreParametersAvailable();
 
     // Process the flag:
-    (m_flag_processor_map[flag])(*this);
+    (this->*processor)();
 }
 
 void com::github::coderodde::wtpdmt::util::CommandLineParser::processHelpFlags() {
@@ -358,96 +1263,1091 @@ void com::github::coderodde::wtpdmt::util::CommandLineParser::processIterationFl
     }
 
     m_iteration_flag_present = true;
-    string value = m_argv[m_argument_index];
-    std::istringstream ss(value);
-    ss >> m_iterations;
+    m_iterations = static_cast<size_t>(ParseUnsignedValue(FLAG_LONG_NUMBER_OF_ITERATIONS, m_argv[m_argument_index]));
     m_argument_index++;
 }
 
 template<class T>
-void com::github::coderodde::wtpdmt::util::CommandLineParser::parseValue(string& value, T* target_ptr) {
-	if (IsHexadecimalString(value)) {
-        // Try parse as hexadecimal:
-		std::istringstream iss(value);
-		iss >> std::hex >> *target_ptr;
-
-		if (iss.fail() || iss.bad()) {
-			std::stringstream ss;
-			ss << "Could not parse '"
-			   << value
-			   << "' as a valid hexadecimal value.";
-
-			throw std::logic_error{ ss.str() };
-		}
-	} else if (IsDecimalString(value)) {	
-		// Try parse as decimal:
-		std::istringstream iss(value);
-		iss >> *target_ptr;
-
-		if (iss.fail() || iss.bad()) {
-			std::stringstream ss;
-			ss << "Could not parse '"
-			   << value
-			   << "' as a valid decimal value.";
-
-			throw std::logic_error{ ss.str() };
-		}
-	} else {
-		std::stringstream ss;
-		ss << "Could not parse '"
-		   << value
-		   << "' as a hexadecimal or decimal value.";
-
-		throw std::logic_error{ ss.str() };
-	}
-}
+void com::github::coderodde::wtpdmt::util::CommandLineParser::parseValue(std::string_view value, T* target_ptr) {
+    bool hexadecimal = value.size() > 2 && value[0] == '0' && (value[1] == 'x' || value[1] == 'X');
 
-void com::github::coderodde::wtpdmt::util::CommandLineParser::processPriorityClassFlags() {
-    if (m_priority_class_flag_present) {
+    if (hexadecimal ? !ParseNumber(value.substr(2), target_ptr, 16)
+                    : !ParseNumber(value, target_ptr, 10)) {
         std::stringstream ss;
-        ss << "The flag "
-            << FLAG_SHORT_PRIORITY_CLASS
-            << " or "
-            << FLAG_LONG_PRIORITY_CLASS
-            << " given more than once.";
+        ss << "Could not parse '"
+           << value
+           << "' as a hexadecimal or decimal value.";
 
         throw std::logic_error{ ss.str() };
     }
+}
+
+int com::github::coderodde::wtpdmt::util::CommandLineParser::parseThreadPriority(std::string_view value) {
+    return parseThreadPriority(value, m_priority_class);
+}
 
-    auto pair = m_priority_class_name_map.find(m_argv[m_argument_index]);
+int com::github::coderodde::wtpdmt::util::CommandLineParser::parseThreadPriority(std::string_view value,
+                                                                                 PriorityClass priority_class) {
+    int thread_priority;
 
-    if (pair == m_priority_class_name_map.cend()) {
-        string value = m_argv[m_argument_index];
-        parseValue(value, &m_priority_class);
-    } else {
-        m_priority_class = pair->second;
+    if (findThreadPriority(value, priority_class, &thread_priority)) {
+        return thread_priority;
     }
 
-    m_priority_class_flag_present = true;
-    m_argument_index++;
+    parseValue(value, &thread_priority);
+
+#ifdef _WIN32
+    return thread_priority;
+#else
+    int policy = static_cast<int>(priority_class);
+
+    int minimum = isRealtimePolicy(policy) ? sched_get_priority_min(policy) : MINIMUM_NICE;
+    int maximum = isRealtimePolicy(policy) ? sched_get_priority_max(policy) : MAXIMUM_NICE;
+
+    if (thread_priority < minimum || thread_priority > maximum) {
+        std::stringstream ss;
+        ss << "The thread priority " << thread_priority << " is outside of ["
+           << minimum << ", " << maximum << "] under "
+           << getPriorityClassName(priority_class) << ".";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    return thread_priority;
+#endif
 }
 
-void com::github::coderodde::wtpdmt::util::CommandLineParser::processThreadPriorityFlags() {
-    if (m_thread_priority_flag_present) {
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processPriorityClassFlags() {
+    if (m_priority_class_flag_present) {
         std::stringstream ss;
         ss << "The flag "
-            << FLAG_SHORT_THREAD_PRIORITY
+            << FLAG_SHORT_PRIORITY_CLASS
             << " or "
-            << FLAG_LONG_THREAD_PRIORITY
+            << FLAG_LONG_PRIORITY_CLASS
             << " given more than once.";
 
         throw std::logic_error{ ss.str() };
     }
 
-    auto pair = m_thread_priority_name_map.find(m_argv[m_argument_index]);
-
-    if (pair == m_thread_priority_name_map.cend()) {
-        string value = m_argv[m_argument_index];
-		parseValue(value, &m_thread_priority);
-    } else {
-        m_thread_priority = pair->second;
+    m_priority_class = parsePriorityClass(m_argv[m_argument_index]);
+    m_priority_class_flag_present = true;
+    m_argument_index++;
+}
+
+com::github::coderodde::wtpdmt::util::PriorityClass com::github::coderodde::wtpdmt::util::CommandLineParser::parsePriorityClass(std::string_view value) {
+    PriorityClass priority_class;
+
+    if (findPriorityClass(value, &priority_class)) {
+        return priority_class;
+    }
+
+    parseValue(value, &priority_class);
+
+#ifndef _WIN32
+    auto class_names = getPriorityClassNames();
+
+    if (std::none_of(class_names.begin(), class_names.end(), [priority_class](const PriorityClassName& entry) {
+            return entry.priority_class == priority_class;
+        })) {
+        std::stringstream ss;
+        ss << "Unknown scheduling policy: " << value << ".";
+        throw std::logic_error{ ss.str() };
+    }
+#endif
+
+    return priority_class;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processThreadPriorityFlags() {
+    if (m_thread_priority_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_SHORT_THREAD_PRIORITY
+            << " or "
+            << FLAG_LONG_THREAD_PRIORITY
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
     }
 
+    m_thread_priority_value = m_argv[m_argument_index];
     m_thread_priority_flag_present = true;
     m_argument_index++;
 }
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processClockFlags() {
+    if (m_clock_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_SHORT_CLOCK
+            << " or "
+            << FLAG_LONG_CLOCK
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    string value = m_argv[m_argument_index];
+
+    if (!Clock::findSource(value, &m_clock_source)) {
+        std::stringstream ss;
+        ss << "Unknown or unsupported clock source: '" << value << "'.";
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_clock_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processPercentilesFlags() {
+    if (m_percentiles_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_PERCENTILES
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    std::string_view list = m_argv[m_argument_index];
+    std::string_view item;
+
+    while (nextListItem(list, ',', &item)) {
+        double percentile = 0.0;
+        const char* end = item.data() + item.size();
+        auto [last, error] = std::from_chars(item.data(), end, percentile);
+
+        if (item.empty() || error != std::errc{} || last != end || percentile <= 0.0 || percentile > 100.0) {
+            std::stringstream ss;
+            ss << "Could not parse '"
+               << item
+               << "' as a percentile in (0, 100].";
+
+            throw std::logic_error{ ss.str() };
+        }
+
+        m_percentiles.push_back(percentile);
+    }
+
+    if (m_percentiles.empty()) {
+        throw std::logic_error{ "The percentile list is empty." };
+    }
+
+    m_percentiles_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processThreadsFlags() {
+    if (m_threads_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_THREADS
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    string value = m_argv[m_argument_index];
+
+    if (!ParseNumber(std::string_view(value), &m_threads, 10) || m_threads == 0 ||
+        m_threads > static_cast<size_t>(getCpuCount())) {
+        std::stringstream ss;
+        ss << "The number of threads must be between 1 and "
+           << getCpuCount()
+           << ", got '"
+           << value
+           << "'.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_threads_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processCpusFlags() {
+    if (m_cpus_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_CPUS
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_cpus = parseCpuList(m_argv[m_argument_index]);
+
+    for (int cpu : m_cpus) {
+        if (cpu >= getCpuCount()) {
+            std::stringstream ss;
+            ss << "CPU " << cpu << " does not exist; the machine has "
+               << getCpuCount() << " CPUs.";
+
+            throw std::logic_error{ ss.str() };
+        }
+    }
+
+    m_cpus_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processTraceFlags() {
+    if (m_trace_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_TRACE
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_trace_path = m_argv[m_argument_index];
+    m_trace_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processThresholdFlags() {
+    if (m_threshold_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_THRESHOLD
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_threshold_nanoseconds = ParseUnsignedValue(FLAG_LONG_THRESHOLD, m_argv[m_argument_index]);
+    m_threshold_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processModeFlags() {
+    if (m_mode_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_MODE
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    string value = m_argv[m_argument_index];
+
+    if (value == MODE_GAPS_STR) {
+        m_mode = MeasurementMode::GAPS;
+    } else if (value == MODE_WAKEUP_STR) {
+        m_mode = MeasurementMode::WAKEUP;
+    } else if (value == MODE_PERIODIC_STR) {
+        m_mode = MeasurementMode::PERIODIC;
+    } else if (value == MODE_PROBE_STR) {
+        m_mode = MeasurementMode::PROBE;
+    } else if (value == MODE_INVERSION_STR) {
+        m_mode = MeasurementMode::INVERSION;
+    } else if (value == MODE_PING_PONG_STR) {
+        m_mode = MeasurementMode::PING_PONG;
+    } else if (value == MODE_WORK_STR) {
+        m_mode = MeasurementMode::WORK;
+    } else if (value == MODE_SURVEY_STR) {
+        m_mode = MeasurementMode::SURVEY;
+    } else {
+        std::stringstream ss;
+        ss << "Unknown mode: " << value << ".";
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_mode_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processIntervalFlags() {
+    if (m_interval_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_INTERVAL
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_interval_nanoseconds = ParseUnsignedValue(FLAG_LONG_INTERVAL, m_argv[m_argument_index]);
+
+    if (m_interval_nanoseconds == 0) {
+        throw std::logic_error{ "The wakeup interval must be positive." };
+    }
+
+    m_interval_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processMechanismsFlags() {
+    if (m_mechanisms_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_MECHANISMS
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    std::string_view list = m_argv[m_argument_index];
+    std::string_view name;
+
+    while (nextListItem(list, ',', &name)) {
+        WakeupMechanism mechanism;
+
+        if (!findWakeupMechanism(name, &mechanism)) {
+            std::stringstream ss;
+            ss << "Unknown or unsupported wakeup mechanism: " << name << ".";
+            throw std::logic_error{ ss.str() };
+        }
+
+        m_mechanisms.push_back(mechanism);
+    }
+
+    if (m_mechanisms.empty()) {
+        throw std::logic_error{ "The wakeup mechanism list is empty." };
+    }
+
+    m_mechanisms_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processTasksFlags() {
+    if (m_tasks_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_TASKS
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    std::string_view list = m_argv[m_argument_index];
+    std::string_view item;
+
+    while (nextListItem(list, ',', &item)) {
+        std::string_view fields = item;
+        std::string_view period;
+        std::string_view thread_priority;
+        std::string_view deadline;
+
+        nextListItem(fields, ':', &period);
+        nextListItem(fields, ':', &thread_priority);
+        nextListItem(fields, ':', &deadline);
+
+        if (std::count(item.begin(), item.end(), ':') > 2) {
+            std::stringstream ss;
+            ss << "Could not parse '" << item << "' as <PERIOD>[:<THREAD>[:<DEADLINE>]].";
+            throw std::logic_error{ ss.str() };
+        }
+
+        PeriodicTask task;
+        task.period_nanoseconds = ParseUnsignedValue(FLAG_LONG_TASKS, period);
+        task.deadline_nanoseconds = deadline.empty()
+                                  ? task.period_nanoseconds
+                                  : ParseUnsignedValue(FLAG_LONG_TASKS, deadline);
+        task.thread_priority = m_thread_priority; // Resolved by getTasks().
+
+        if (task.period_nanoseconds == 0) {
+            std::stringstream ss;
+            ss << "The period of the task '" << item << "' must be positive.";
+            throw std::logic_error{ ss.str() };
+        }
+
+        m_tasks.push_back(task);
+        m_task_thread_priority_values.emplace_back(thread_priority);
+    }
+
+    if (m_tasks.empty()) {
+        throw std::logic_error{ "The task list is empty." };
+    }
+
+    m_tasks_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processSchedDeadlineFlags() {
+    if (m_sched_deadline_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_SCHED_DEADLINE
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+#ifdef _WIN32
+    throw std::logic_error{ "SCHED_DEADLINE is available on Linux only." };
+#else
+    std::string_view value = m_argv[m_argument_index];
+    std::string_view fields = value;
+    std::string_view runtime;
+    std::string_view deadline;
+    std::string_view period;
+
+    nextListItem(fields, ':', &runtime);
+    nextListItem(fields, ':', &deadline);
+    nextListItem(fields, ':', &period);
+
+    if (std::count(value.begin(), value.end(), ':') > 2 || period.empty()) {
+        std::stringstream ss;
+        ss << "Could not parse '" << value << "' as <RUNTIME>:<DEADLINE>:<PERIOD>.";
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_sched_deadline_parameters.runtime_nanoseconds  = ParseUnsignedValue(FLAG_LONG_SCHED_DEADLINE, runtime);
+    m_sched_deadline_parameters.deadline_nanoseconds = ParseUnsignedValue(FLAG_LONG_SCHED_DEADLINE, deadline);
+    m_sched_deadline_parameters.period_nanoseconds   = ParseUnsignedValue(FLAG_LONG_SCHED_DEADLINE, period);
+
+    // The kernel rejects anything else:
+    if (m_sched_deadline_parameters.runtime_nanoseconds == 0 ||
+        m_sched_deadline_parameters.runtime_nanoseconds > m_sched_deadline_parameters.deadline_nanoseconds ||
+        m_sched_deadline_parameters.deadline_nanoseconds > m_sched_deadline_parameters.period_nanoseconds) {
+        throw std::logic_error{ "SCHED_DEADLINE needs 0 < <RUNTIME> <= <DEADLINE> <= <PERIOD>." };
+    }
+
+    m_sched_deadline_flag_present = true;
+    m_argument_index++;
+#endif
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processMemoryFlags() {
+    if (m_memory_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_MEMORY
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    std::string_view list = m_argv[m_argument_index];
+    std::string_view name;
+
+    while (nextListItem(list, ',', &name)) {
+        if (name == MEMORY_LOCK_STR) {
+            m_memory_policy.lock_memory = true;
+        } else if (name == MEMORY_PREFAULT_STR) {
+            m_memory_policy.prefault = true;
+        } else if (name == MEMORY_LARGE_PAGES_STR) {
+            m_memory_policy.large_pages = true;
+        } else {
+            std::stringstream ss;
+            ss << "Unknown memory option: " << name << ".";
+            throw std::logic_error{ ss.str() };
+        }
+    }
+
+    m_memory_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processSweepFlags() {
+    if (m_sweep_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_SWEEP
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_sweep_value = m_argv[m_argument_index];
+    m_sweep_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processLoadFlags() {
+    if (m_load_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_LOAD
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_load_value = m_argv[m_argument_index];
+    m_load_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processReportIntervalFlags() {
+    if (m_report_interval_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_REPORT_INTERVAL
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_report_interval_milliseconds = ParseUnsignedValue(FLAG_LONG_REPORT_INTERVAL, m_argv[m_argument_index]);
+
+    if (m_report_interval_milliseconds == 0) {
+        throw std::logic_error{ "The report interval must be positive." };
+    }
+
+    m_report_interval_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processReportFormatFlags() {
+    if (m_report_format_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_REPORT_FORMAT
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    string value = m_argv[m_argument_index];
+
+    if (!findLiveReportFormat(value, &m_report_format)) {
+        std::stringstream ss;
+        ss << "Unknown report format: " << value << ".";
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_report_format_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolveDaemon() {
+    if (!m_daemon_flag_present) {
+        if (m_window_flag_present) {
+            std::stringstream ss;
+            ss << "The flag " << FLAG_LONG_WINDOW << " needs " << FLAG_LONG_DAEMON << ".";
+            throw std::logic_error{ ss.str() };
+        }
+
+        return;
+    }
+
+    if (m_mode != MeasurementMode::GAPS || m_sweep_flag_present) {
+        std::stringstream ss;
+        ss << "The flag " << FLAG_LONG_DAEMON << " works in the plain " << MODE_GAPS_STR << " mode only.";
+        throw std::logic_error{ ss.str() };
+    }
+
+    // A trace would grow without bound, and the segment replaces the
+    // printed reports:
+    if (m_trace_flag_present || m_report_format_flag_present) {
+        std::stringstream ss;
+        ss << "The flag " << FLAG_LONG_DAEMON << " does not go with "
+           << FLAG_LONG_TRACE << " or " << FLAG_LONG_REPORT_FORMAT << ".";
+        throw std::logic_error{ ss.str() };
+    }
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processDaemonFlags() {
+    if (m_daemon_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_DAEMON
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    string name = m_argv[m_argument_index];
+
+    // The name becomes part of a file name on Linux and of an object name
+    // on Windows:
+    bool valid = !name.empty();
+
+    for (char c : name) {
+        valid = valid && (std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.');
+    }
+
+    if (!valid) {
+        std::stringstream ss;
+        ss << "Invalid segment name: '" << name << "'; use letters, digits, '-', '_' and '.'.";
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_daemon_segment_name = name;
+    m_daemon_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processWindowFlags() {
+    if (m_window_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_WINDOW
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_window_intervals = static_cast<size_t>(ParseUnsignedValue(FLAG_LONG_WINDOW, m_argv[m_argument_index]));
+
+    if (m_window_intervals == 0) {
+        throw std::logic_error{ "The window must span at least one interval." };
+    }
+
+    m_window_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolveProbe() {
+    if (m_mode != MeasurementMode::PROBE) {
+        if (m_duration_flag_present) {
+            std::stringstream ss;
+            ss << "The flag " << FLAG_LONG_DURATION << " works in the " << MODE_PROBE_STR << " mode only.";
+            throw std::logic_error{ ss.str() };
+        }
+
+        return;
+    }
+
+    // The probe runs the way an embedding process would run it, with none
+    // of the other machinery of wt beside it:
+    if (m_sweep_flag_present ||
+        m_load_flag_present ||
+        m_trace_flag_present ||
+        m_report_format_flag_present ||
+        m_daemon_flag_present) {
+        std::stringstream ss;
+        ss << "The " << MODE_PROBE_STR << " mode does not go with "
+           << FLAG_LONG_SWEEP << ", "
+           << FLAG_LONG_LOAD << ", "
+           << FLAG_LONG_TRACE << ", "
+           << FLAG_LONG_REPORT_FORMAT << " or "
+           << FLAG_LONG_DAEMON << ".";
+        throw std::logic_error{ ss.str() };
+    }
+
+    if (getMeasurementCpus().size() > 1) {
+        std::stringstream ss;
+        ss << "The " << MODE_PROBE_STR << " mode runs one probe; give at most one CPU.";
+        throw std::logic_error{ ss.str() };
+    }
+
+    if (getProbeSnapshotIntervalMilliseconds() > m_duration_milliseconds) {
+        throw std::logic_error{ "The snapshot interval is longer than the probe runs." };
+    }
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processDurationFlags() {
+    if (m_duration_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_DURATION
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_duration_milliseconds = ParseUnsignedValue(FLAG_LONG_DURATION, m_argv[m_argument_index]);
+
+    if (m_duration_milliseconds == 0) {
+        throw std::logic_error{ "The duration must be positive." };
+    }
+
+    m_duration_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolveAttribution() {
+    if (!m_attribute_flag_present) {
+        return;
+    }
+
+    if (m_mode != MeasurementMode::GAPS || m_sweep_flag_present || m_daemon_flag_present) {
+        std::stringstream ss;
+        ss << "The flag " << FLAG_LONG_ATTRIBUTE << " works in the " << MODE_GAPS_STR
+           << " mode only, without " << FLAG_LONG_SWEEP << " or " << FLAG_LONG_DAEMON << ".";
+        throw std::logic_error{ ss.str() };
+    }
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processAttributeFlags() {
+    if (m_attribute_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_ATTRIBUTE
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_attribution_threshold_nanoseconds = ParseUnsignedValue(FLAG_LONG_ATTRIBUTE, m_argv[m_argument_index]);
+
+    if (m_attribution_threshold_nanoseconds == 0) {
+        throw std::logic_error{ "The attribution threshold must be positive." };
+    }
+
+    m_attribute_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolveInversion() {
+    if (m_mode != MeasurementMode::INVERSION) {
+        if (m_locks_flag_present || m_hold_flag_present) {
+            std::stringstream ss;
+            ss << "The flags " << FLAG_LONG_LOCKS << " and " << FLAG_LONG_HOLD
+               << " work in the " << MODE_INVERSION_STR << " mode only.";
+            throw std::logic_error{ ss.str() };
+        }
+
+        return;
+    }
+
+    if (m_priorities_flag_present && m_scenario_thread_priority_values.size() != INVERSION_THREAD_COUNT) {
+        std::stringstream ss;
+        ss << "The " << MODE_INVERSION_STR << " mode takes " << FLAG_LONG_PRIORITIES << " <LOW>,<MEDIUM>,<HIGH>.";
+        throw std::logic_error{ ss.str() };
+    }
+
+    if (getMeasurementCpus().size() > 1) {
+        std::stringstream ss;
+        ss << "The " << MODE_INVERSION_STR << " mode runs its threads on one CPU; give at most one.";
+        throw std::logic_error{ ss.str() };
+    }
+
+    // Fails early on priorities that do not fit the class:
+    getScenarioThreadPriorities();
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processLocksFlags() {
+    if (m_locks_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_LOCKS
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    std::string_view list = m_argv[m_argument_index];
+    std::string_view name;
+
+    while (nextListItem(list, ',', &name)) {
+        LockKind kind;
+
+        if (!findLockKind(name, &kind)) {
+            std::stringstream ss;
+            ss << "Unknown or unsupported lock: " << name << ".";
+            throw std::logic_error{ ss.str() };
+        }
+
+        m_locks.push_back(kind);
+    }
+
+    if (m_locks.empty()) {
+        throw std::logic_error{ "The lock list is empty." };
+    }
+
+    m_locks_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processHoldFlags() {
+    if (m_hold_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_HOLD
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_hold_nanoseconds = ParseUnsignedValue(FLAG_LONG_HOLD, m_argv[m_argument_index]);
+
+    if (m_hold_nanoseconds == 0) {
+        throw std::logic_error{ "The hold time must be positive." };
+    }
+
+    m_hold_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processPrioritiesFlags() {
+    if (m_priorities_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_PRIORITIES
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    std::string_view list = m_argv[m_argument_index];
+    std::string_view value;
+
+    // Parsed by getScenarioThreadPriorities(), once the class is known;
+    // the resolvers check the count against the mode:
+    while (nextListItem(list, ',', &value)) {
+        m_scenario_thread_priority_values.emplace_back(value);
+    }
+
+    m_priorities_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolvePingPong() {
+    if (m_mode != MeasurementMode::PING_PONG) {
+        if (m_primitives_flag_present) {
+            std::stringstream ss;
+            ss << "The flag " << FLAG_LONG_PRIMITIVES << " works in the " << MODE_PING_PONG_STR << " mode only.";
+            throw std::logic_error{ ss.str() };
+        }
+
+        if (m_priorities_flag_present && m_mode != MeasurementMode::INVERSION) {
+            std::stringstream ss;
+            ss << "The flag " << FLAG_LONG_PRIORITIES << " works in the " << MODE_INVERSION_STR << " and "
+               << MODE_PING_PONG_STR << " modes only.";
+            throw std::logic_error{ ss.str() };
+        }
+
+        return;
+    }
+
+    if (m_priorities_flag_present && m_scenario_thread_priority_values.size() != PING_PONG_THREAD_COUNT) {
+        std::stringstream ss;
+        ss << "The " << MODE_PING_PONG_STR << " mode takes " << FLAG_LONG_PRIORITIES << " <PING>,<PONG>.";
+        throw std::logic_error{ ss.str() };
+    }
+
+    if (getMeasurementCpus().size() > PING_PONG_THREAD_COUNT) {
+        std::stringstream ss;
+        ss << "The " << MODE_PING_PONG_STR << " mode runs two threads; give at most two CPUs.";
+        throw std::logic_error{ ss.str() };
+    }
+
+    getScenarioThreadPriorities();
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processPrimitivesFlags() {
+    if (m_primitives_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_PRIMITIVES
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    std::string_view list = m_argv[m_argument_index];
+    std::string_view name;
+
+    while (nextListItem(list, ',', &name)) {
+        HandoffPrimitive primitive;
+
+        if (!findHandoffPrimitive(name, &primitive)) {
+            std::stringstream ss;
+            ss << "Unknown or unsupported handoff primitive: " << name << ".";
+            throw std::logic_error{ ss.str() };
+        }
+
+        m_primitives.push_back(primitive);
+    }
+
+    if (m_primitives.empty()) {
+        throw std::logic_error{ "The handoff primitive list is empty." };
+    }
+
+    m_primitives_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolveTimer() {
+    if (m_timer_nanoseconds.size() > 1 && m_mode != MeasurementMode::WAKEUP) {
+        std::stringstream ss;
+        ss << "Several values for " << FLAG_LONG_TIMER << " sweep them in the " << MODE_WAKEUP_STR << " mode only.";
+        throw std::logic_error{ ss.str() };
+    }
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processTimerFlags() {
+    if (m_timer_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_TIMER
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    std::string_view list = m_argv[m_argument_index];
+    std::string_view value;
+
+    while (nextListItem(list, ',', &value)) {
+        uint64_t nanoseconds = ParseUnsignedValue(FLAG_LONG_TIMER, value);
+
+        if (nanoseconds == 0) {
+            throw std::logic_error{ "The timer setting must be positive." };
+        }
+
+        m_timer_nanoseconds.push_back(nanoseconds);
+    }
+
+    if (m_timer_nanoseconds.empty()) {
+        throw std::logic_error{ "The timer list is empty." };
+    }
+
+    m_timer_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolveBaseline() {
+    if (!m_save_flag_present && !m_compare_flag_present) {
+        return;
+    }
+
+    if (m_mode != MeasurementMode::GAPS || m_sweep_flag_present || m_daemon_flag_present) {
+        std::stringstream ss;
+        ss << "The flags " << FLAG_LONG_SAVE << " and " << FLAG_LONG_COMPARE
+           << " work in the plain " << MODE_GAPS_STR << " mode only.";
+        throw std::logic_error{ ss.str() };
+    }
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processSaveFlags() {
+    if (m_save_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_SAVE
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_save_path = m_argv[m_argument_index];
+    m_save_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processCompareFlags() {
+    if (m_compare_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_COMPARE
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_compare_path = m_argv[m_argument_index];
+    m_compare_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processCpuLatencyFlags() {
+    if (m_cpu_latency_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_CPU_LATENCY
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_cpu_latency_microseconds = ParseUnsignedValue(FLAG_LONG_CPU_LATENCY, m_argv[m_argument_index]);
+
+    // The kernel takes a signed 32-bit value:
+    if (m_cpu_latency_microseconds > static_cast<uint64_t>((std::numeric_limits<int32_t>::max)())) {
+        throw std::logic_error{ "The CPU latency is too large." };
+    }
+
+    m_cpu_latency_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolvePower() {
+    if (!m_power_flag_present) {
+        return;
+    }
+
+    if (m_mode != MeasurementMode::GAPS || m_daemon_flag_present) {
+        std::stringstream ss;
+        ss << "The flag " << FLAG_LONG_POWER << " works in the " << MODE_GAPS_STR
+           << " mode only, without " << FLAG_LONG_DAEMON << ".";
+        throw std::logic_error{ ss.str() };
+    }
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processPowerFlags() {
+    if (m_power_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_POWER
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_power_threshold_nanoseconds = ParseUnsignedValue(FLAG_LONG_POWER, m_argv[m_argument_index]);
+
+    if (m_power_threshold_nanoseconds == 0) {
+        throw std::logic_error{ "The power state threshold must be positive." };
+    }
+
+    m_power_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::resolveWork() {
+    if (m_mode != MeasurementMode::WORK && (m_kernels_flag_present || m_steps_flag_present)) {
+        std::stringstream ss;
+        ss << "The flags " << FLAG_LONG_KERNELS << " and " << FLAG_LONG_STEPS
+           << " work in the " << MODE_WORK_STR << " mode only.";
+        throw std::logic_error{ ss.str() };
+    }
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processKernelsFlags() {
+    if (m_kernels_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_KERNELS
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    std::string_view list = m_argv[m_argument_index];
+    std::string_view name;
+
+    while (nextListItem(list, ',', &name)) {
+        WorkKernel kernel;
+
+        if (!findWorkKernel(name, &kernel)) {
+            std::stringstream ss;
+            ss << "Unknown work kernel: " << name << ".";
+            throw std::logic_error{ ss.str() };
+        }
+
+        m_kernels.push_back(kernel);
+    }
+
+    if (m_kernels.empty()) {
+        throw std::logic_error{ "The work kernel list is empty." };
+    }
+
+    m_kernels_flag_present = true;
+    m_argument_index++;
+}
+
+void com::github::coderodde::wtpdmt::util::CommandLineParser::processStepsFlags() {
+    if (m_steps_flag_present) {
+        std::stringstream ss;
+        ss << "The flag "
+            << FLAG_LONG_STEPS
+            << " given more than once.";
+
+        throw std::logic_error{ ss.str() };
+    }
+
+    m_steps = static_cast<size_t>(ParseUnsignedValue(FLAG_LONG_STEPS, m_argv[m_argument_index]));
+
+    if (m_steps == 0) {
+        throw std::logic_error{ "The number of steps must be positive." };
+    }
+
+    m_steps_flag_present = true;
+    m_argument_index++;
+}
@@ -2,28 +2,79 @@
 #define COM_GITHUB_CODERODDE_WTPDMT_UTIL_COMMAND_LINE_PARSER_HPP
 
 #include <filesystem>
-#include <functional>
 #include <iomanip>
 #include <iostream>
-#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <cstdint>
+#include <span>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
-#include <windows.h>
+#include <string_view>
+#include <vector>
+#include "Clock.h"
+#include "InversionMode.h"
+#include "LiveReporter.h"
+#include "LoadGenerator.h"
+#include "MemoryControl.h"
+#include "PeriodicMode.h"
+#include "PingPongMode.h"
+#include "SweepMode.h"
+#include "ThreadControl.h"
+#include "WakeupMode.h"
+#include "WorkMode.h"
 
 namespace com::github::coderodde::wtpdmt::util {
 
 	using std::string;
 
+	enum class MeasurementMode {
+		GAPS,      // Back-to-back clock reads on a spinning thread
+		WAKEUP,    // Overshoot of sleeping and timer primitives
+		PERIODIC,  // Fixed-rate tasks with release latency and deadline misses
+		PROBE,     // The embeddable JitterProbe, snapshotted while it runs
+		INVERSION, // Low-, medium- and high-priority threads sharing a lock
+		PING_PONG, // Two threads handing a token back and forth
+		WORK,      // A fixed work kernel timed per iteration
+		SURVEY     // Gaps on every CPU at once, ranked for isolation
+	};
+
 	class CommandLineParser {
 	private:
 
 		bool m_iteration_flag_present;
 		bool m_priority_class_flag_present;
 		bool m_thread_priority_flag_present;
+		bool m_clock_flag_present;
+		bool m_percentiles_flag_present;
+		bool m_threads_flag_present;
+		bool m_cpus_flag_present;
+		bool m_trace_flag_present;
+		bool m_threshold_flag_present;
+		bool m_mode_flag_present;
+		bool m_interval_flag_present;
+		bool m_mechanisms_flag_present;
+		bool m_tasks_flag_present;
+		bool m_sched_deadline_flag_present;
+		bool m_memory_flag_present;
+		bool m_sweep_flag_present;
+		bool m_load_flag_present;
+		bool m_report_interval_flag_present;
+		bool m_report_format_flag_present;
+		bool m_daemon_flag_present;
+		bool m_window_flag_present;
+		bool m_duration_flag_present;
+		bool m_attribute_flag_present;
+		bool m_locks_flag_present;
+		bool m_hold_flag_present;
+		bool m_priorities_flag_present;
+		bool m_primitives_flag_present;
+		bool m_timer_flag_present;
+		bool m_save_flag_present;
+		bool m_compare_flag_present;
+		bool m_cpu_latency_flag_present;
+		bool m_power_flag_present;
+		bool m_kernels_flag_present;
+		bool m_steps_flag_present;
 		bool m_help_flag_present;
 
 		char** m_argv;
@@ -31,48 +82,169 @@ namespace com::github::coderodde::wtpdmt::util {
 		int m_argument_index;
 
 		size_t m_iterations;
-		DWORD m_priority_class;
+		PriorityClass m_priority_class;
+		string m_thread_priority_value; // Resolved once the class is known.
 		int m_thread_priority;
-
-		std::unordered_map<string, std::function<void(CommandLineParser&)>> m_flag_processor_map;
-		std::map<string, DWORD>    m_priority_class_name_map;
-		std::map<string, int>      m_thread_priority_name_map;
-		std::unordered_set<DWORD>  m_priority_class_number_set;
-		std::unordered_set<int>    m_thread_priority_number_set;
-		std::unordered_set<string> m_flag_set;
+		ClockSource m_clock_source;
+		std::vector<double> m_percentiles; // Empty unless given, as are the other lists with defaults.
+		size_t m_threads;
+		std::vector<int> m_cpus;
+		string m_trace_path;
+		uint64_t m_threshold_nanoseconds;
+		MeasurementMode m_mode;
+		uint64_t m_interval_nanoseconds;
+		std::vector<WakeupMechanism> m_mechanisms;
+		std::vector<PeriodicTask> m_tasks;
+		std::vector<string> m_task_thread_priority_values; // Empty if not given.
+		SchedDeadlineParameters m_sched_deadline_parameters;
+		MemoryPolicy m_memory_policy;
+		string m_sweep_value; // Resolved once all flags are known.
+		std::vector<string> m_sweep_class_names;
+		std::vector<string> m_sweep_thread_priority_names;
+		std::vector<SweepPoint> m_sweep_points;
+		string m_load_value; // Resolved once all flags are known.
+		std::vector<LoadSpecification> m_loads;
+		uint64_t m_report_interval_milliseconds; // 0 for no live report.
+		LiveReportFormat m_report_format;
+		string m_daemon_segment_name; // Empty unless running as a daemon.
+		size_t m_window_intervals;
+		uint64_t m_duration_milliseconds;
+		uint64_t m_attribution_threshold_nanoseconds;
+		std::vector<LockKind> m_locks;
+		uint64_t m_hold_nanoseconds;
+		std::vector<string> m_scenario_thread_priority_values; // Empty if not given.
+		std::vector<HandoffPrimitive> m_primitives;
+		std::vector<uint64_t> m_timer_nanoseconds; // Empty to leave the timer alone.
+		string m_save_path;
+		string m_compare_path;
+		uint64_t m_cpu_latency_microseconds;
+		uint64_t m_power_threshold_nanoseconds;
+		std::vector<WorkKernel> m_kernels;
+		size_t m_steps;
 
 	public:
 	
 		CommandLineParser(int argc, char* argv[]);
 
 		size_t getNumberOfIterations();
-		DWORD getPriorityClass();
+		PriorityClass getPriorityClass();
 		int getThreadPriority();
+		ClockSource getClockSource();
+		std::span<const double> getPercentiles();
+		size_t getNumberOfThreads();
+		const std::vector<int>& getCpus();
+		std::vector<int> getMeasurementCpus();
+		bool traceRequested();
+		const string& getTracePath();
+		uint64_t getThresholdNanoseconds();
+		MeasurementMode getMode();
+		uint64_t getIntervalNanoseconds();
+		std::span<const WakeupMechanism> getMechanisms();
+		WakeupMechanism getPeriodicMechanism();
+		std::vector<PeriodicTask> getTasks();
 		bool helpRequested();
 		void printHelp();
-		string getPriorityClassName(DWORD priority_class);
+		const SchedDeadlineParameters& getSchedDeadlineParameters();
+		const MemoryPolicy& getMemoryPolicy();
+		bool sweepRequested();
+		const std::vector<string>& getSweepClassNames();
+		const std::vector<string>& getSweepThreadPriorityNames();
+		const std::vector<SweepPoint>& getSweepPoints();
+		const std::vector<LoadSpecification>& getLoads();
+		uint64_t getReportIntervalMilliseconds();
+		LiveReportFormat getReportFormat();
+		bool daemonRequested();
+		const string& getDaemonSegmentName();
+		uint64_t getDaemonIntervalMilliseconds();
+		size_t getWindowIntervals();
+		uint64_t getDurationMilliseconds();
+		uint64_t getProbeSnapshotIntervalMilliseconds();
+		bool attributionRequested();
+		uint64_t getAttributionThresholdNanoseconds();
+		std::span<const LockKind> getLocks();
+		uint64_t getHoldNanoseconds();
+		std::vector<int> getScenarioThreadPriorities();
+		std::span<const HandoffPrimitive> getPrimitives();
+		const std::vector<uint64_t>& getTimerNanoseconds();
+		bool saveRequested();
+		const string& getSavePath();
+		bool compareRequested();
+		const string& getComparePath();
+		bool cpuLatencyRequested();
+		uint64_t getCpuLatencyMicroseconds();
+		bool powerRequested();
+		uint64_t getPowerThresholdNanoseconds();
+		std::span<const WorkKernel> getKernels();
+		size_t getSteps();
+		string getPriorityClassName(PriorityClass priority_class);
 		string getThreadPriorityName(int thread_priority);
+		string getEffectiveThreadPriorityName(PriorityClass priority_class, int thread_priority);
 		size_t getMaximumPriorityClassNameLength();
 		size_t getMaximumThreadPriorityNameLength();
 
 	private:
 	
-		void loadDispatchMap();
-		void loadPriorityClassNameMap();
-		void loadThreadPriorityNameMap();
-		void loadPriorityClassNumberSet();
-		void loadThreadPriorityNumberSet();
-		void loadFlagSet();
+		typedef void (CommandLineParser::*FlagProcessor)();
+
+		// Looks the flag up in a constant table; null if there is no such
+		// flag.
+		static FlagProcessor findFlagProcessor(std::string_view flag);
+
 		void parseCommandLine();
-		void checkFlagIsValid(string& flag);
+		void resolveThreadPriority();
+		void resolveSweep();
+		void resolveLoads();
+		void resolveDaemon();
+		void resolveProbe();
+		void resolveAttribution();
+		void resolveInversion();
+		void resolvePingPong();
+		void resolveTimer();
+		void resolveBaseline();
+		void resolvePower();
+		void resolveWork();
 		void checkMoreParametersAvailable();
 		void processFlagPair();
 		void processHelpFlags();
 		void processIterationFlags();
 		void processPriorityClassFlags();
 		void processThreadPriorityFlags();
+		void processClockFlags();
+		void processPercentilesFlags();
+		void processThreadsFlags();
+		void processCpusFlags();
+		void processTraceFlags();
+		void processThresholdFlags();
+		void processModeFlags();
+		void processIntervalFlags();
+		void processMechanismsFlags();
+		void processTasksFlags();
+		void processSchedDeadlineFlags();
+		void processMemoryFlags();
+		void processSweepFlags();
+		void processLoadFlags();
+		void processReportIntervalFlags();
+		void processReportFormatFlags();
+		void processDaemonFlags();
+		void processWindowFlags();
+		void processDurationFlags();
+		void processAttributeFlags();
+		void processLocksFlags();
+		void processHoldFlags();
+		void processPrioritiesFlags();
+		void processPrimitivesFlags();
+		void processTimerFlags();
+		void processSaveFlags();
+		void processCompareFlags();
+		void processCpuLatencyFlags();
+		void processPowerFlags();
+		void processKernelsFlags();
+		void processStepsFlags();
+		PriorityClass parsePriorityClass(std::string_view value);
+		int parseThreadPriority(std::string_view value);
+		int parseThreadPriority(std::string_view value, PriorityClass priority_class);
 		template<class T>
-		void parseValue(string& value, T* target_ptr);
+		void parseValue(std::string_view value, T* target_ptr);
 	};
 } // End of namespace com::github::coderodde::wtpdmt::util
 #endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_COMMAND_LINE_PARSER_HPP
\ No newline at end of file
@@ -0,0 +1,347 @@
+#include "DaemonMode.h"
+#include "Histogram.h"
+#include "LiveChannel.h"
+#include "Measurement.h"
+#include "MemoryControl.h"
+#include "Report.h"
+#include "SharedMemory.h"
+#include "SharedStatisticsFormat.h"
+#include "ThreadControl.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::DaemonConfiguration;
+using com::github::coderodde::wtpdmt::SharedHistogram;
+using com::github::coderodde::wtpdmt::SharedStatisticsHeader;
+using com::github::coderodde::wtpdmt::SharedStatisticsState;
+using com::github::coderodde::wtpdmt::SharedThreadHeader;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+using com::github::coderodde::wtpdmt::util::Clock;
+using com::github::coderodde::wtpdmt::util::Histogram;
+using com::github::coderodde::wtpdmt::util::LiveChannel;
+using com::github::coderodde::wtpdmt::util::PageFaultCounts;
+using com::github::coderodde::wtpdmt::util::SharedMemory;
+
+// How long the publisher sleeps at most before looking for a stop signal,
+// and how often it checks for a swap to be acknowledged:
+static const std::chrono::milliseconds PUBLISHER_MAXIMUM_SLEEP{ 100 };
+static const std::chrono::microseconds SWAP_POLL_INTERVAL{ 100 };
+
+// Set from the signal handler:
+static std::atomic<bool> stop_signal_received{ false };
+
+static_assert(std::atomic<bool>::is_always_lock_free, "The stop flag is set from a signal handler.");
+
+static void OnStopSignal(int) {
+    stop_signal_received.store(true);
+}
+
+static uint64_t GetEpochNanoseconds() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+static uint64_t GetProcessId() {
+#ifdef _WIN32
+    return GetCurrentProcessId();
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
+static size_t GetHistogramSize() {
+    return sizeof(SharedHistogram) + Histogram::BUCKET_COUNT * sizeof(uint64_t);
+}
+
+static size_t GetThreadSize() {
+    return sizeof(SharedThreadHeader) + 3 * GetHistogramSize();
+}
+
+static void ExportHistogram(const Histogram& histogram, char* destination) {
+    SharedHistogram shared_histogram;
+    shared_histogram.count    = histogram.getCount();
+    shared_histogram.minimum  = histogram.getMinimum();
+    shared_histogram.maximum  = histogram.getMaximum();
+    shared_histogram.sum      = histogram.getSum();
+    shared_histogram.reserved = 0;
+
+    std::memcpy(destination, &shared_histogram, sizeof(shared_histogram));
+    uint64_t* counts = reinterpret_cast<uint64_t*>(destination + sizeof(shared_histogram));
+
+    for (size_t i = 0; i < Histogram::BUCKET_COUNT; i++) {
+        counts[i] = histogram.getBucketCount(i);
+    }
+}
+
+// Owns the segment and the thread that keeps it up to date. The measuring
+// threads record into a LiveChannel each; every interval the publisher
+// takes their buffers, folds them into the last-interval, window and total
+// histograms of the thread, and copies those into the segment under the
+// sequence lock.
+class StatisticsPublisher {
+private:
+
+    const DaemonConfiguration&                m_configuration;
+    const Clock&                              m_clock;
+    SharedMemory                              m_segment;
+    std::vector<std::unique_ptr<LiveChannel>> m_channels;
+    std::vector<std::unique_ptr<Histogram>>   m_last_intervals;
+    std::vector<std::unique_ptr<Histogram>>   m_interval_ring; // window_intervals per thread.
+    std::vector<std::unique_ptr<Histogram>>   m_windows;
+    std::vector<std::unique_ptr<Histogram>>   m_totals;
+    uint64_t                                  m_update_count;
+    PageFaultCounts                           m_page_faults_at_start;
+    std::atomic<bool>                         m_stop_requested; // When the measurement failed.
+    std::thread                               m_publisher_thread;
+
+public:
+
+    StatisticsPublisher(const DaemonConfiguration& configuration, const Clock& clock) :
+        m_configuration       { configuration },
+        m_clock               { clock },
+        m_segment             { configuration.segment_name,
+                                sizeof(SharedStatisticsHeader) + configuration.cpus.size() * GetThreadSize() },
+        m_update_count        { 0 },
+        m_page_faults_at_start( com::github::coderodde::wtpdmt::util::getPageFaultCounts() ),
+        m_stop_requested      { false }
+    {
+        size_t thread_count = configuration.cpus.size();
+
+        for (size_t i = 0; i < thread_count; i++) {
+            m_channels.push_back(std::make_unique<LiveChannel>());
+            m_last_intervals.push_back(std::make_unique<Histogram>());
+            m_windows.push_back(std::make_unique<Histogram>());
+            m_totals.push_back(std::make_unique<Histogram>());
+
+            for (size_t j = 0; j < configuration.window_intervals; j++) {
+                m_interval_ring.push_back(std::make_unique<Histogram>());
+            }
+        }
+
+        writeLayout();
+    }
+
+    ~StatisticsPublisher() {
+        if (m_publisher_thread.joinable()) {
+            // The measurement failed; its threads are gone, so an update
+            // in progress must not wait for them:
+            for (std::unique_ptr<LiveChannel>& channel : m_channels) {
+                channel->finish();
+            }
+
+            m_stop_requested.store(true, std::memory_order_release);
+            m_publisher_thread.join();
+        }
+    }
+
+    StatisticsPublisher(const StatisticsPublisher&) = delete;
+    StatisticsPublisher& operator=(const StatisticsPublisher&) = delete;
+
+    LiveChannel& getChannel(size_t thread_index) {
+        return *m_channels[thread_index];
+    }
+
+    uint64_t getUpdateCount() const {
+        return m_update_count;
+    }
+
+    const Histogram& getTotal(size_t thread_index) const {
+        return *m_totals[thread_index];
+    }
+
+    void start() {
+        m_publisher_thread = std::thread([this]() {
+            com::github::coderodde::wtpdmt::util::setCurrentThreadBackgroundPriority();
+
+            std::chrono::milliseconds interval{ static_cast<std::chrono::milliseconds::rep>(
+                m_configuration.interval_milliseconds) };
+            std::chrono::steady_clock::time_point next_update = std::chrono::steady_clock::now() + interval;
+
+            while (!m_stop_requested.load(std::memory_order_acquire)) {
+                if (stop_signal_received.load()) {
+                    // Also ends the measuring loops:
+                    update(true);
+                    return;
+                }
+
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+                if (now >= next_update) {
+                    update(false);
+                    next_update += interval;
+                } else {
+                    std::this_thread::sleep_for((std::min)(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(next_update - now),
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(PUBLISHER_MAXIMUM_SLEEP)));
+                }
+            }
+        });
+    }
+
+    // Call once the measuring threads are done.
+    void stop() {
+        m_publisher_thread.join();
+        publish(SharedStatisticsState::STOPPED);
+    }
+
+private:
+
+    SharedStatisticsHeader* getHeader() {
+        return reinterpret_cast<SharedStatisticsHeader*>(m_segment.getData());
+    }
+
+    // The fields that never change; the segment is not visible under its
+    // final contents before this returns, so no lock is needed.
+    void writeLayout() {
+        SharedStatisticsHeader* header = getHeader();
+        std::memcpy(header->magic, com::github::coderodde::wtpdmt::SHARED_STATISTICS_MAGIC, sizeof(header->magic));
+        header->version                = com::github::coderodde::wtpdmt::SHARED_STATISTICS_VERSION;
+        header->header_size            = sizeof(SharedStatisticsHeader);
+        header->thread_size            = static_cast<uint32_t>(GetThreadSize());
+        header->histogram_size         = static_cast<uint32_t>(GetHistogramSize());
+        header->thread_count           = static_cast<uint32_t>(m_configuration.cpus.size());
+        header->bucket_count           = static_cast<uint32_t>(Histogram::BUCKET_COUNT);
+        header->sub_bucket_bits        = Histogram::SUB_BUCKET_BITS;
+        header->clock_source           = static_cast<uint32_t>(m_configuration.clock_source);
+        header->interval_milliseconds  = static_cast<uint32_t>(m_configuration.interval_milliseconds);
+        header->window_intervals       = static_cast<uint32_t>(m_configuration.window_intervals);
+        header->nanoseconds_per_tick   = m_clock.getNanosecondsPerTick();
+        header->process_id             = GetProcessId();
+        header->start_time_nanoseconds = GetEpochNanoseconds();
+
+        for (size_t i = 0; i < m_configuration.cpus.size(); i++) {
+            SharedThreadHeader* thread_header = reinterpret_cast<SharedThreadHeader*>(
+                m_segment.getData() + sizeof(SharedStatisticsHeader) + i * GetThreadSize());
+            thread_header->cpu = m_configuration.cpus[i];
+        }
+
+        publish(SharedStatisticsState::RUNNING);
+    }
+
+    void update(bool stopping) {
+        size_t window_intervals = m_configuration.window_intervals;
+
+        for (size_t i = 0; i < m_channels.size(); i++) {
+            LiveChannel& channel = *m_channels[i];
+            uint32_t generation = stopping ? channel.requestStop() : channel.requestSwap();
+            Histogram& drained = channel.takeBuffer(generation, SWAP_POLL_INTERVAL);
+
+            Histogram& slot = *m_interval_ring[i * window_intervals + m_update_count % window_intervals];
+            slot.reset();
+            slot.add(drained);
+
+            m_last_intervals[i]->reset();
+            m_last_intervals[i]->add(drained);
+            m_totals[i]->add(drained);
+            drained.reset();
+
+            // Summing the ring is cheaper than it looks next to an
+            // interval of measuring, and needs no subtraction of extrema:
+            m_windows[i]->reset();
+
+            for (size_t j = 0; j < window_intervals; j++) {
+                m_windows[i]->add(*m_interval_ring[i * window_intervals + j]);
+            }
+        }
+
+        m_update_count++;
+        publish(SharedStatisticsState::RUNNING);
+    }
+
+    void publish(SharedStatisticsState state) {
+        SharedStatisticsHeader* header = getHeader();
+        std::atomic_ref<uint64_t> sequence{ header->sequence };
+        uint64_t sequence_before = sequence.load(std::memory_order_relaxed);
+
+        sequence.store(sequence_before + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        PageFaultCounts page_faults = com::github::coderodde::wtpdmt::util::getPageFaultCounts();
+
+        header->update_count            = m_update_count;
+        header->update_time_nanoseconds = GetEpochNanoseconds();
+        header->minor_page_faults       = page_faults.minor_faults - m_page_faults_at_start.minor_faults;
+        header->major_page_faults       = page_faults.major_faults - m_page_faults_at_start.major_faults;
+        header->state                   = static_cast<uint32_t>(state);
+
+        for (size_t i = 0; i < m_channels.size(); i++) {
+            char* histograms = m_segment.getData()
+                             + sizeof(SharedStatisticsHeader)
+                             + i * GetThreadSize()
+                             + sizeof(SharedThreadHeader);
+
+            ExportHistogram(*m_last_intervals[i], histograms);
+            ExportHistogram(*m_windows[i], histograms + GetHistogramSize());
+            ExportHistogram(*m_totals[i], histograms + 2 * GetHistogramSize());
+        }
+
+        sequence.store(sequence_before + 2, std::memory_order_release);
+    }
+};
+
+void com::github::coderodde::wtpdmt::runDaemonMode(const DaemonConfiguration& configuration,
+                                                   const util::Clock& clock) {
+    StatisticsPublisher publisher(configuration, clock);
+
+    stop_signal_received.store(false);
+    std::signal(SIGINT, OnStopSignal);
+    std::signal(SIGTERM, OnStopSignal);
+
+    publisher.start();
+
+    std::cout << "INFO: Publishing to the shared memory segment '"
+              << util::SharedMemory::getSystemName(configuration.segment_name)
+              << "' every "
+              << configuration.interval_milliseconds
+              << " ms; stop with SIGINT or SIGTERM.\n";
+    std::cout.flush();
+
+    // The loops run until the publisher passes on the stop signal:
+    std::vector<std::unique_ptr<ThreadStatistics>> statistics =
+        runOnThreads(configuration.cpus,
+                     configuration.thread_priority,
+                     [&](size_t thread_index, ThreadStatistics&) {
+        util::Clock::dispatch(configuration.clock_source, [&](auto reader) {
+            LiveRecorder recorder{ publisher.getChannel(thread_index) };
+            runGapLoop<decltype(reader)>(SIZE_MAX, recorder);
+        });
+    });
+
+    publisher.stop();
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+
+    std::unique_ptr<Histogram> aggregate = std::make_unique<Histogram>();
+
+    for (size_t i = 0; i < statistics.size(); i++) {
+        statistics[i]->histogram.add(publisher.getTotal(i));
+        aggregate->add(statistics[i]->histogram);
+    }
+
+    std::cout << "\nINFO: Published "
+              << publisher.getUpdateCount()
+              << " intervals.\n\n";
+
+    if (statistics.size() > 1) {
+        printThreadTable(statistics, *aggregate, clock, configuration.percentiles);
+    }
+
+    printGapStatistics(*aggregate, clock, configuration.percentiles);
+}
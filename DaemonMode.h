@@ -0,0 +1,28 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_DAEMON_MODE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_DAEMON_MODE_HPP
+
+#include "Clock.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	struct DaemonConfiguration {
+		util::ClockSource   clock_source;
+		int                 thread_priority;
+		std::vector<int>    cpus;                  // One measuring thread per entry.
+		std::string         segment_name;
+		uint64_t            interval_milliseconds; // Between two updates of the segment.
+		size_t              window_intervals;      // Intervals in the rolling window.
+		std::vector<double> percentiles;           // For the summary at exit.
+	};
+
+	// Measures gaps until SIGINT or SIGTERM arrives and publishes them into
+	// a shared memory segment (see SharedStatisticsFormat.h) once every
+	// interval. A background thread does the publishing; reading the
+	// segment costs the daemon nothing.
+	void runDaemonMode(const DaemonConfiguration& configuration, const util::Clock& clock);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_DAEMON_MODE_HPP
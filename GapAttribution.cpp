@@ -0,0 +1,346 @@
+#include "GapAttribution.h"
+#include "Clock.h"
+#include "SystemError.h"
+#include "ThreadControl.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::GapCause;
+using com::github::coderodde::wtpdmt::ThreadActivity;
+using com::github::coderodde::wtpdmt::util::throwSystemError;
+
+static const string GAP_CAUSE_DESCHEDULED_STR = "descheduled";
+static const string GAP_CAUSE_INTERRUPT_STR   = "interrupt/SMI-like";
+static const string GAP_CAUSE_STEAL_STR       = "steal";
+
+// Enough for /proc/interrupts of a few hundred CPUs; the buffer grows if
+// it is not, which allocates once.
+static const size_t INITIAL_PROC_BUFFER_SIZE = 256 * 1024;
+
+string com::github::coderodde::wtpdmt::getGapCauseName(GapCause cause) {
+    switch (cause) {
+    case GapCause::DESCHEDULED:
+        return GAP_CAUSE_DESCHEDULED_STR;
+
+    case GapCause::INTERRUPT:
+        return GAP_CAUSE_INTERRUPT_STR;
+
+    case GapCause::STEAL:
+        return GAP_CAUSE_STEAL_STR;
+    }
+
+    return "unknown";
+}
+
+#ifdef _WIN32
+static uint64_t ReadQpcNanoseconds() {
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return static_cast<uint64_t>(static_cast<double>(counter.QuadPart) * 1e9
+                               / static_cast<double>(frequency.QuadPart));
+}
+
+static uint64_t ReadThreadCycles() {
+    ULONG64 cycles = 0;
+    QueryThreadCycleTime(GetCurrentThread(), &cycles);
+    return static_cast<uint64_t>(cycles);
+}
+
+// Thread cycles tick at the TSC rate, which Windows does not tell; spin
+// for a few milliseconds against QPC to find it.
+static double CalibrateCyclesPerNanosecond() {
+    uint64_t start_nanoseconds = ReadQpcNanoseconds();
+    uint64_t start_cycles = ReadThreadCycles();
+    uint64_t now_nanoseconds = start_nanoseconds;
+
+    while (now_nanoseconds - start_nanoseconds < 5 * 1000 * 1000) {
+        now_nanoseconds = ReadQpcNanoseconds();
+    }
+
+    return static_cast<double>(ReadThreadCycles() - start_cycles)
+         / static_cast<double>(now_nanoseconds - start_nanoseconds);
+}
+#else
+static const char* SkipSpaces(const char* position, const char* end) {
+    while (position < end && (*position == ' ' || *position == '\t')) {
+        position++;
+    }
+
+    return position;
+}
+
+static const char* SkipLine(const char* position, const char* end) {
+    while (position < end && *position != '\n') {
+        position++;
+    }
+
+    return position < end ? position + 1 : end;
+}
+
+// Parses the decimal number at 'position', or returns false if there is
+// none.
+static bool ParseNumber(const char** position, const char* end, uint64_t* value) {
+    const char* p = SkipSpaces(*position, end);
+
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+
+    uint64_t number = 0;
+
+    while (p < end && *p >= '0' && *p <= '9') {
+        number = number * 10 + static_cast<uint64_t>(*p - '0');
+        p++;
+    }
+
+    *position = p;
+    *value = number;
+    return true;
+}
+#endif
+
+com::github::coderodde::wtpdmt::GapAttributor::GapAttributor(double nanoseconds_per_tick) :
+    m_nanoseconds_per_tick{ nanoseconds_per_tick },
+    m_last_activity       {},
+    m_statistics          {},
+#ifdef _WIN32
+    m_cycles_per_nanosecond{ CalibrateCyclesPerNanosecond() }
+#else
+    m_buffer       (INITIAL_PROC_BUFFER_SIZE),
+    m_interrupts_fd{ open("/proc/interrupts", O_RDONLY | O_CLOEXEC) },
+    m_stat_fd      { open("/proc/stat", O_RDONLY | O_CLOEXEC) }
+#endif
+{
+#ifndef _WIN32
+    if (m_interrupts_fd < 0 || m_stat_fd < 0) {
+        int error = errno;
+
+        if (m_interrupts_fd >= 0) {
+            close(m_interrupts_fd);
+        }
+
+        if (m_stat_fd >= 0) {
+            close(m_stat_fd);
+        }
+
+        errno = error;
+        throwSystemError("open /proc/interrupts and /proc/stat");
+    }
+#endif
+}
+
+com::github::coderodde::wtpdmt::GapAttributor::~GapAttributor() {
+#ifndef _WIN32
+    close(m_interrupts_fd);
+    close(m_stat_fd);
+#endif
+}
+
+void com::github::coderodde::wtpdmt::GapAttributor::start() {
+    m_last_activity = sample();
+}
+
+void com::github::coderodde::wtpdmt::GapAttributor::attribute(uint64_t gap_ticks) {
+    ThreadActivity activity = sample();
+    double gap_nanoseconds = static_cast<double>(gap_ticks) * m_nanoseconds_per_tick;
+    double off_cpu_nanoseconds = static_cast<double>(activity.wall_nanoseconds - m_last_activity.wall_nanoseconds)
+                               - static_cast<double>(activity.cpu_nanoseconds - m_last_activity.cpu_nanoseconds);
+    bool switched = activity.voluntary_switches != m_last_activity.voluntary_switches ||
+                    activity.involuntary_switches != m_last_activity.involuntary_switches ||
+                    activity.cpu != m_last_activity.cpu;
+    uint64_t interrupts = activity.cpu == m_last_activity.cpu
+                        ? activity.interrupts - m_last_activity.interrupts
+                        : 0;
+    GapCause cause;
+
+    if (switched) {
+        cause = GapCause::DESCHEDULED;
+    } else if (off_cpu_nanoseconds * 2.0 < gap_nanoseconds) {
+        // The thread was charged for the gap: an interrupt whose time the
+        // kernel does not account separately, or an SMI.
+        cause = GapCause::INTERRUPT;
+    } else {
+#ifdef _WIN32
+        // Without switch counts, time taken away looks like a switch:
+        cause = GapCause::DESCHEDULED;
+#else
+        // Interrupt time accounted apart from the thread, unless the
+        // hypervisor reports steal for the CPU:
+        cause = activity.steal_jiffies != m_last_activity.steal_jiffies || interrupts == 0
+              ? GapCause::STEAL
+              : GapCause::INTERRUPT;
+#endif
+    }
+
+    size_t index = static_cast<size_t>(cause);
+    m_statistics.gaps[index]++;
+    m_statistics.gap_ticks[index] += gap_ticks;
+    m_statistics.largest_gap_ticks[index] = gap_ticks > m_statistics.largest_gap_ticks[index]
+                                          ? gap_ticks
+                                          : m_statistics.largest_gap_ticks[index];
+    m_statistics.interrupts[index] += interrupts;
+
+    m_last_activity = activity;
+}
+
+const com::github::coderodde::wtpdmt::GapAttributionStatistics&
+com::github::coderodde::wtpdmt::GapAttributor::getStatistics() const {
+    return m_statistics;
+}
+
+ThreadActivity com::github::coderodde::wtpdmt::GapAttributor::sample() {
+    ThreadActivity activity{};
+    activity.cpu = util::getCurrentCpu();
+
+#ifdef _WIN32
+    activity.wall_nanoseconds = ReadQpcNanoseconds();
+    activity.cpu_nanoseconds  = static_cast<uint64_t>(static_cast<double>(ReadThreadCycles())
+                                                      / m_cycles_per_nanosecond);
+#else
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+
+    activity.wall_nanoseconds     = util::MonotonicReader::read();
+    activity.cpu_nanoseconds      = util::ThreadCpuTimeReader::read();
+    activity.voluntary_switches   = static_cast<uint64_t>(usage.ru_nvcsw);
+    activity.involuntary_switches = static_cast<uint64_t>(usage.ru_nivcsw);
+    activity.interrupts           = readInterruptCount(activity.cpu);
+    activity.steal_jiffies        = readStealJiffies(activity.cpu);
+#endif
+
+    return activity;
+}
+
+#ifndef _WIN32
+const char* com::github::coderodde::wtpdmt::GapAttributor::readProcFile(int fd, size_t* length) {
+    while (true) {
+        size_t size = 0;
+        ssize_t count;
+
+        // Reading from offset 0 makes the kernel generate the file anew:
+        while ((count = pread(fd, m_buffer.data() + size, m_buffer.size() - size, static_cast<off_t>(size))) > 0) {
+            size += static_cast<size_t>(count);
+
+            if (size == m_buffer.size()) {
+                break;
+            }
+        }
+
+        if (count < 0) {
+            throwSystemError("read a /proc file");
+        }
+
+        if (size < m_buffer.size()) {
+            *length = size;
+            return m_buffer.data();
+        }
+
+        m_buffer.resize(m_buffer.size() * 2);
+    }
+}
+
+// Sums the column of 'cpu' over all rows of /proc/interrupts. The header
+// row names the columns, which skip offline CPUs.
+uint64_t com::github::coderodde::wtpdmt::GapAttributor::readInterruptCount(int cpu) {
+    size_t length;
+    const char* position = readProcFile(m_interrupts_fd, &length);
+    const char* end = position + length;
+    char column_name[32];
+    std::snprintf(column_name, sizeof(column_name), "CPU%d", cpu);
+    size_t column_name_length = std::strlen(column_name);
+    size_t column = 0;
+    bool column_found = false;
+
+    while (position < end && *position != '\n') {
+        position = SkipSpaces(position, end);
+        const char* name = position;
+
+        while (position < end && *position != ' ' && *position != '\n') {
+            position++;
+        }
+
+        if (static_cast<size_t>(position - name) == column_name_length &&
+            std::memcmp(name, column_name, column_name_length) == 0) {
+            column_found = true;
+            break;
+        }
+
+        column++;
+    }
+
+    if (!column_found) {
+        return 0;
+    }
+
+    uint64_t total = 0;
+    position = SkipLine(position, end);
+
+    while (position < end) {
+        // Skip the "NN:" label:
+        while (position < end && *position != ':' && *position != '\n') {
+            position++;
+        }
+
+        if (position < end && *position == ':') {
+            position++;
+            uint64_t value = 0;
+
+            for (size_t i = 0; i <= column && ParseNumber(&position, end, &value); i++) {
+                if (i == column) {
+                    total += value;
+                }
+            }
+        }
+
+        position = SkipLine(position, end);
+    }
+
+    return total;
+}
+
+// The eighth value of the "cpuN" row of /proc/stat.
+uint64_t com::github::coderodde::wtpdmt::GapAttributor::readStealJiffies(int cpu) {
+    size_t length;
+    const char* position = readProcFile(m_stat_fd, &length);
+    const char* end = position + length;
+    char row_name[32];
+    std::snprintf(row_name, sizeof(row_name), "cpu%d ", cpu);
+    size_t row_name_length = std::strlen(row_name);
+
+    while (position < end) {
+        if (static_cast<size_t>(end - position) > row_name_length &&
+            std::memcmp(position, row_name, row_name_length) == 0) {
+            position += row_name_length;
+            uint64_t value = 0;
+
+            for (size_t i = 0; i < 8; i++) {
+                if (!ParseNumber(&position, end, &value)) {
+                    return 0;
+                }
+            }
+
+            return value;
+        }
+
+        position = SkipLine(position, end);
+    }
+
+    return 0;
+}
+#endif
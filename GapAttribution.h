@@ -0,0 +1,92 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_GAP_ATTRIBUTION_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_GAP_ATTRIBUTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using std::string;
+
+	enum class GapCause {
+		DESCHEDULED, // The thread switched out: preempted or blocked
+		INTERRUPT,   // No switch; an interrupt, or an SMI the OS never sees
+		STEAL        // No switch, no interrupt; the hypervisor ran someone else
+	};
+
+	constexpr size_t GAP_CAUSE_COUNT = 3;
+
+	string getGapCauseName(GapCause cause);
+
+	struct GapAttributionStatistics {
+		uint64_t gaps[GAP_CAUSE_COUNT];
+		uint64_t gap_ticks[GAP_CAUSE_COUNT];
+		uint64_t largest_gap_ticks[GAP_CAUSE_COUNT];
+		uint64_t interrupts[GAP_CAUSE_COUNT]; // On the thread's CPU; 0 on Windows.
+	};
+
+	// What the calling thread's counters say about the time since the last
+	// sample. Linux reads CLOCK_THREAD_CPUTIME_ID, getrusage(RUSAGE_THREAD),
+	// and the current CPU's rows of /proc/interrupts and /proc/stat.
+	// Windows has QueryThreadCycleTime() only, so there a gap the thread
+	// was not charged for counts as DESCHEDULED and STEAL never shows up.
+	struct ThreadActivity {
+		int      cpu;
+		uint64_t wall_nanoseconds;
+		uint64_t cpu_nanoseconds;
+		uint64_t voluntary_switches;
+		uint64_t involuntary_switches;
+		uint64_t interrupts;
+		uint64_t steal_jiffies;
+	};
+
+	// Classifies the gaps of one measuring thread. Sampling takes tens of
+	// microseconds, so only gaps over the threshold pay for it and the
+	// loop restarts its clock afterwards. Each gap is judged by what
+	// changed since the previous sample, which covers the shorter gaps in
+	// between as well; those are too short to hide a switch.
+	class GapAttributor {
+	private:
+
+		double                   m_nanoseconds_per_tick;
+		ThreadActivity           m_last_activity;
+		GapAttributionStatistics m_statistics;
+#ifdef _WIN32
+		double                   m_cycles_per_nanosecond;
+#else
+		std::vector<char>        m_buffer; // For the /proc files.
+		int                      m_interrupts_fd;
+		int                      m_stat_fd;
+#endif
+
+	public:
+
+		// Opens and sizes everything up front; call it on the measuring
+		// thread, which start() and attribute() must run on too.
+		explicit GapAttributor(double nanoseconds_per_tick);
+		~GapAttributor();
+
+		GapAttributor(const GapAttributor&) = delete;
+		GapAttributor& operator=(const GapAttributor&) = delete;
+
+		// Takes the first sample.
+		void start();
+
+		// Attributes a gap that just ended and takes the next sample.
+		void attribute(uint64_t gap_ticks);
+
+		const GapAttributionStatistics& getStatistics() const;
+
+	private:
+
+		ThreadActivity sample();
+#ifndef _WIN32
+		const char* readProcFile(int fd, size_t* length);
+		uint64_t readInterruptCount(int cpu);
+		uint64_t readStealJiffies(int cpu);
+#endif
+	};
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_GAP_ATTRIBUTION_HPP
@@ -0,0 +1,184 @@
+#include "Histogram.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Values recordAll() bins before it touches the counts; the indices stay
+// in L1.
+static const size_t RECORD_BLOCK_SIZE = 256;
+
+// A block whose values are all at most this sums exactly in 64 bits.
+static const uint64_t EXACT_BLOCK_SUM_LIMIT = UINT64_MAX / RECORD_BLOCK_SIZE;
+
+com::github::coderodde::wtpdmt::util::Histogram::Histogram() {
+    reset();
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::Histogram::getBucketLowestValue(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    unsigned int shift = static_cast<unsigned int>(index >> (SUB_BUCKET_BITS - 1)) - 1;
+    uint64_t sub_bucket = index - (static_cast<size_t>(shift) << (SUB_BUCKET_BITS - 1));
+    return sub_bucket << shift;
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::Histogram::getBucketHighestValue(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    unsigned int shift = static_cast<unsigned int>(index >> (SUB_BUCKET_BITS - 1)) - 1;
+    return getBucketLowestValue(index) + ((uint64_t(1) << shift) - 1);
+}
+
+void com::github::coderodde::wtpdmt::util::Histogram::reset() {
+    std::memset(m_counts, 0, sizeof(m_counts));
+    m_count   = 0;
+    m_minimum = UINT64_MAX;
+    m_maximum = 0;
+    m_sum     = 0.0;
+}
+
+void com::github::coderodde::wtpdmt::util::Histogram::recordAll(const uint64_t* values, size_t count) {
+    uint32_t indices[RECORD_BLOCK_SIZE];
+
+    for (size_t start = 0; start < count; start += RECORD_BLOCK_SIZE) {
+        const uint64_t* block = values + start;
+        size_t block_size = count - start < RECORD_BLOCK_SIZE ? count - start : RECORD_BLOCK_SIZE;
+        uint64_t minimum = m_minimum;
+        uint64_t maximum = 0;
+        uint64_t sum = 0;
+
+        // Integer additions vectorize where a double sum would have to
+        // keep its order.
+        for (size_t i = 0; i < block_size; i++) {
+            indices[i] = static_cast<uint32_t>(getBucketIndex(block[i]));
+            minimum = block[i] < minimum ? block[i] : minimum;
+            maximum = block[i] > maximum ? block[i] : maximum;
+            sum += block[i];
+        }
+
+        if (maximum <= EXACT_BLOCK_SUM_LIMIT) {
+            m_sum += static_cast<double>(sum);
+        } else {
+            // The integer sum may have wrapped:
+            for (size_t i = 0; i < block_size; i++) {
+                m_sum += static_cast<double>(block[i]);
+            }
+        }
+
+        for (size_t i = 0; i < block_size; i++) {
+            m_counts[indices[i]]++;
+        }
+
+        m_count += block_size;
+        m_minimum = minimum;
+        m_maximum = maximum > m_maximum ? maximum : m_maximum;
+    }
+}
+
+void com::github::coderodde::wtpdmt::util::Histogram::add(const Histogram& other) {
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        m_counts[i] += other.m_counts[i];
+    }
+
+    m_count += other.m_count;
+    m_minimum = other.m_minimum < m_minimum ? other.m_minimum : m_minimum;
+    m_maximum = other.m_maximum > m_maximum ? other.m_maximum : m_maximum;
+    m_sum += other.m_sum;
+}
+
+void com::github::coderodde::wtpdmt::util::Histogram::restore(const uint64_t* counts,
+                                                             uint64_t minimum,
+                                                             uint64_t maximum,
+                                                             double sum) {
+    std::memcpy(m_counts, counts, sizeof(m_counts));
+    m_count = 0;
+
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        m_count += m_counts[i];
+    }
+
+    m_minimum = m_count == 0 ? UINT64_MAX : minimum;
+    m_maximum = maximum;
+    m_sum     = sum;
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::Histogram::getBucketCount(size_t index) const {
+    return m_counts[index];
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::Histogram::getCount() const {
+    return m_count;
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::Histogram::getMinimum() const {
+    return m_count == 0 ? 0 : m_minimum;
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::Histogram::getMaximum() const {
+    return m_maximum;
+}
+
+double com::github::coderodde::wtpdmt::util::Histogram::getSum() const {
+    return m_sum;
+}
+
+double com::github::coderodde::wtpdmt::util::Histogram::getMean() const {
+    return m_count == 0 ? 0.0 : m_sum / static_cast<double>(m_count);
+}
+
+double com::github::coderodde::wtpdmt::util::Histogram::getStandardDeviation() const {
+    if (m_count == 0) {
+        return 0.0;
+    }
+
+    // Each value counts as the middle of its bucket, clamped to the values
+    // seen; the deviations are taken from the exact mean.
+    double mean = getMean();
+    double sum_of_squared_deviations = 0.0;
+
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        if (m_counts[i] == 0) {
+            continue;
+        }
+
+        uint64_t lowest = getBucketLowestValue(i);
+        uint64_t value = lowest + (getBucketHighestValue(i) - lowest) / 2;
+        value = value > m_maximum ? m_maximum : value;
+        value = value < m_minimum ? m_minimum : value;
+
+        double deviation = static_cast<double>(value) - mean;
+        sum_of_squared_deviations += static_cast<double>(m_counts[i]) * deviation * deviation;
+    }
+
+    return std::sqrt(sum_of_squared_deviations / static_cast<double>(m_count));
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::Histogram::getValueAtPercentile(double percentile) const {
+    if (m_count == 0) {
+        return 0;
+    }
+
+    // The rank of the requested sample, 1-based:
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count)));
+    rank = rank == 0 ? 1 : rank;
+
+    uint64_t cumulative_count = 0;
+
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        cumulative_count += m_counts[i];
+
+        if (cumulative_count >= rank) {
+            // Report the highest value equivalent to the bucket, clamped to
+            // the values actually seen:
+            uint64_t value = getBucketHighestValue(i);
+            value = value > m_maximum ? m_maximum : value;
+            return value < m_minimum ? m_minimum : value;
+        }
+    }
+
+    return m_maximum;
+}
@@ -0,0 +1,85 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_HISTOGRAM_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_HISTOGRAM_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	// A log-linear (HDR-style) histogram over 64-bit values. Values below
+	// SUB_BUCKET_COUNT get an exact bucket each; above that, every power of
+	// two is split into HALF_SUB_BUCKET_COUNT linear buckets, which bounds
+	// the relative error of a bucket by 1 / HALF_SUB_BUCKET_COUNT. The
+	// bucket array has a fixed size, so recording never allocates.
+	class Histogram {
+	public:
+
+		static constexpr unsigned int SUB_BUCKET_BITS       = 7;
+		static constexpr size_t       SUB_BUCKET_COUNT      = size_t(1) << SUB_BUCKET_BITS;
+		static constexpr size_t       HALF_SUB_BUCKET_COUNT = SUB_BUCKET_COUNT / 2;
+		static constexpr size_t       BUCKET_COUNT          = (64 - SUB_BUCKET_BITS + 2) * HALF_SUB_BUCKET_COUNT;
+
+	private:
+
+		uint64_t m_counts[BUCKET_COUNT];
+		uint64_t m_count;
+		uint64_t m_minimum;
+		uint64_t m_maximum;
+		double   m_sum;
+
+	public:
+
+		Histogram();
+
+		// The hot path: one bucket computation (bit_width compiles to
+		// lzcnt/bsr) and conditional moves for the extrema.
+		void record(uint64_t value) {
+			m_counts[getBucketIndex(value)]++;
+			m_count++;
+			m_minimum = value < m_minimum ? value : m_minimum;
+			m_maximum = value > m_maximum ? value : m_maximum;
+			m_sum += static_cast<double>(value);
+		}
+
+		// Records 'count' values a block at a time: bucket indices,
+		// extrema and an integer sum first, in loops with no stores to the
+		// counts, then the increments. For bulk data such as trace files.
+		void recordAll(const uint64_t* values, size_t count);
+
+		static size_t getBucketIndex(uint64_t value) {
+			unsigned int shift = static_cast<unsigned int>(
+				std::bit_width(value | (SUB_BUCKET_COUNT - 1))) - SUB_BUCKET_BITS;
+
+			return (static_cast<size_t>(shift) << (SUB_BUCKET_BITS - 1))
+				 + static_cast<size_t>(value >> shift);
+		}
+
+		static uint64_t getBucketLowestValue(size_t index);
+		static uint64_t getBucketHighestValue(size_t index);
+
+		void reset();
+		void add(const Histogram& other);
+
+		// Replaces the contents with state exported through the getters,
+		// for example by another process. 'counts' holds BUCKET_COUNT
+		// entries.
+		void restore(const uint64_t* counts,
+					 uint64_t minimum,
+					 uint64_t maximum,
+					 double sum);
+
+		uint64_t getBucketCount(size_t index) const;
+		uint64_t getCount() const;
+		uint64_t getMinimum() const;
+		uint64_t getMaximum() const;
+		double getSum() const;
+		double getMean() const;
+
+		// From the bucket counts, like the percentiles: a sum of squares
+		// would cancel catastrophically over billions of samples.
+		double getStandardDeviation() const;
+		uint64_t getValueAtPercentile(double percentile) const;
+	};
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_HISTOGRAM_HPP
@@ -0,0 +1,434 @@
+#include "InversionMode.h"
+#include "Measurement.h"
+#include "PriorityNames.h"
+#include "Report.h"
+#include "SystemError.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#pragma comment(lib, "Synchronization.lib")
+#else
+#include <cerrno>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::LockKind;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+using com::github::coderodde::wtpdmt::util::Histogram;
+using com::github::coderodde::wtpdmt::util::throwSystemError;
+
+// Lock names as accepted by --locks:
+static const string LOCK_MUTEX_STR            = "mutex";
+static const string LOCK_CRITICAL_SECTION_STR = "critical-section";
+static const string LOCK_SRWLOCK_STR          = "srwlock";
+static const string LOCK_SPINLOCK_STR         = "spinlock";
+static const string LOCK_PI_MUTEX_STR         = "pi-mutex";
+#ifdef _WIN32
+static const string LOCK_FUTEX_STR            = "wait-on-address";
+#else
+static const string LOCK_FUTEX_STR            = "futex";
+#endif
+
+static const char* const ROLE_NAMES[com::github::coderodde::wtpdmt::INVERSION_THREAD_COUNT] = {
+    "Low", "Medium", "High"
+};
+
+static const size_t LOW_THREAD_INDEX    = 0;
+static const size_t MEDIUM_THREAD_INDEX = 1;
+static const size_t HIGH_THREAD_INDEX   = 2;
+
+// How long the medium thread runs, in hold times:
+static const uint64_t MEDIUM_RUN_HOLDS = 10;
+
+// A spinlock waiter that outranks the holder on the holder's CPU would
+// spin forever, so after this many spins it sleeps briefly. The wait it
+// measures is then as long as whatever runs in its place. Much shorter
+// sleeps end before the holder gets anything done.
+static const unsigned SPINLOCK_SPINS_BEFORE_SLEEP = 4096;
+static const std::chrono::microseconds SPINLOCK_SLEEP{ 10 };
+
+// One instance of a lock, shared by the three threads of a scenario.
+class InversionLock {
+public:
+
+    virtual ~InversionLock() = default;
+
+    virtual void lock() = 0;
+    virtual void unlock() = 0;
+};
+
+class MutexLock : public InversionLock {
+private:
+
+    std::mutex m_mutex;
+
+public:
+
+    void lock() override {
+        m_mutex.lock();
+    }
+
+    void unlock() override {
+        m_mutex.unlock();
+    }
+};
+
+class SpinLock : public InversionLock {
+private:
+
+    std::atomic<bool> m_locked{ false };
+
+public:
+
+    void lock() override {
+        unsigned spins = 0;
+
+        while (m_locked.exchange(true, std::memory_order_acquire)) {
+            while (m_locked.load(std::memory_order_relaxed)) {
+                if (++spins == SPINLOCK_SPINS_BEFORE_SLEEP) {
+                    std::this_thread::sleep_for(SPINLOCK_SLEEP);
+                    spins = 0;
+                }
+            }
+        }
+    }
+
+    void unlock() override {
+        m_locked.store(false, std::memory_order_release);
+    }
+};
+
+#ifdef _WIN32
+class CriticalSectionLock : public InversionLock {
+private:
+
+    CRITICAL_SECTION m_critical_section;
+
+public:
+
+    CriticalSectionLock() {
+        InitializeCriticalSection(&m_critical_section);
+    }
+
+    ~CriticalSectionLock() {
+        DeleteCriticalSection(&m_critical_section);
+    }
+
+    void lock() override {
+        EnterCriticalSection(&m_critical_section);
+    }
+
+    void unlock() override {
+        LeaveCriticalSection(&m_critical_section);
+    }
+};
+
+class SrwLock : public InversionLock {
+private:
+
+    SRWLOCK m_lock = SRWLOCK_INIT;
+
+public:
+
+    void lock() override {
+        AcquireSRWLockExclusive(&m_lock);
+    }
+
+    void unlock() override {
+        ReleaseSRWLockExclusive(&m_lock);
+    }
+};
+#else
+class PiMutexLock : public InversionLock {
+private:
+
+    pthread_mutex_t m_mutex;
+
+public:
+
+    PiMutexLock() {
+        pthread_mutexattr_t attributes;
+        pthread_mutexattr_init(&attributes);
+        int result = pthread_mutexattr_setprotocol(&attributes, PTHREAD_PRIO_INHERIT);
+
+        if (result == 0) {
+            result = pthread_mutex_init(&m_mutex, &attributes);
+        }
+
+        pthread_mutexattr_destroy(&attributes);
+
+        if (result != 0) {
+            errno = result;
+            throwSystemError("create a priority-inheriting mutex");
+        }
+    }
+
+    ~PiMutexLock() {
+        pthread_mutex_destroy(&m_mutex);
+    }
+
+    void lock() override {
+        pthread_mutex_lock(&m_mutex);
+    }
+
+    void unlock() override {
+        pthread_mutex_unlock(&m_mutex);
+    }
+};
+#endif
+
+// The three-state lock from Drepper's "Futexes Are Tricky": 0 is free,
+// 1 is taken, 2 is taken with waiters. The kernel learns nothing of the
+// owner, so there is no inheritance either.
+class FutexLock : public InversionLock {
+private:
+
+    std::atomic<uint32_t> m_state{ 0 };
+
+    void wait() {
+#ifdef _WIN32
+        uint32_t taken_with_waiters = 2;
+        WaitOnAddress(&m_state, &taken_with_waiters, sizeof(taken_with_waiters), INFINITE);
+#else
+        syscall(SYS_futex, &m_state, FUTEX_WAIT_PRIVATE, 2, nullptr, nullptr, 0);
+#endif
+    }
+
+    void wakeOne() {
+#ifdef _WIN32
+        WakeByAddressSingle(&m_state);
+#else
+        syscall(SYS_futex, &m_state, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+    }
+
+public:
+
+    void lock() override {
+        uint32_t state = 0;
+
+        if (m_state.compare_exchange_strong(state, 1, std::memory_order_acquire)) {
+            return;
+        }
+
+        if (state != 2) {
+            state = m_state.exchange(2, std::memory_order_acquire);
+        }
+
+        while (state != 0) {
+            wait();
+            state = m_state.exchange(2, std::memory_order_acquire);
+        }
+    }
+
+    void unlock() override {
+        if (m_state.exchange(0, std::memory_order_release) == 2) {
+            wakeOne();
+        }
+    }
+};
+
+static std::unique_ptr<InversionLock> CreateLock(LockKind kind) {
+    switch (kind) {
+    case LockKind::MUTEX:
+        return std::make_unique<MutexLock>();
+
+    case LockKind::SPINLOCK:
+        return std::make_unique<SpinLock>();
+
+    case LockKind::FUTEX:
+        return std::make_unique<FutexLock>();
+
+#ifdef _WIN32
+    case LockKind::CRITICAL_SECTION:
+        return std::make_unique<CriticalSectionLock>();
+
+    case LockKind::SRWLOCK:
+        return std::make_unique<SrwLock>();
+#else
+    case LockKind::PI_MUTEX:
+        return std::make_unique<PiMutexLock>();
+#endif
+
+    default:
+        throw std::logic_error{ "The lock '"
+                              + com::github::coderodde::wtpdmt::getLockKindName(kind)
+                              + "' is not supported on this platform." };
+    }
+}
+
+#ifdef _WIN32
+static constexpr LockKind SUPPORTED_LOCK_KINDS[] = {
+    LockKind::MUTEX,
+    LockKind::CRITICAL_SECTION,
+    LockKind::SRWLOCK,
+    LockKind::SPINLOCK,
+    LockKind::FUTEX
+};
+#else
+static constexpr LockKind SUPPORTED_LOCK_KINDS[] = {
+    LockKind::MUTEX,
+    LockKind::SPINLOCK,
+    LockKind::PI_MUTEX,
+    LockKind::FUTEX
+};
+#endif
+
+std::span<const LockKind> com::github::coderodde::wtpdmt::getSupportedLockKinds() {
+    return SUPPORTED_LOCK_KINDS;
+}
+
+string com::github::coderodde::wtpdmt::getLockKindName(LockKind kind) {
+    switch (kind) {
+    case LockKind::MUTEX:            return LOCK_MUTEX_STR;
+    case LockKind::CRITICAL_SECTION: return LOCK_CRITICAL_SECTION_STR;
+    case LockKind::SRWLOCK:          return LOCK_SRWLOCK_STR;
+    case LockKind::SPINLOCK:         return LOCK_SPINLOCK_STR;
+    case LockKind::PI_MUTEX:         return LOCK_PI_MUTEX_STR;
+    case LockKind::FUTEX:            return LOCK_FUTEX_STR;
+    }
+
+    throw std::logic_error{ "Unknown lock kind." };
+}
+
+bool com::github::coderodde::wtpdmt::findLockKind(std::string_view name, LockKind* kind_ptr) {
+    for (LockKind kind : getSupportedLockKinds()) {
+        if (getLockKindName(kind) == name) {
+            *kind_ptr = kind;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+struct InversionScenario {
+    std::unique_ptr<InversionLock> lock;
+    std::binary_semaphore          medium_go{ 0 };
+    std::binary_semaphore          high_go{ 0 };
+    std::counting_semaphore<2>     round_done{ 0 };
+};
+
+template<class Reader>
+static void SpinFor(uint64_t ticks) {
+    uint64_t start = Reader::read();
+
+    while (Reader::read() - start < ticks) {
+    }
+}
+
+// One round per iteration. The low thread wakes the others only once it
+// holds the lock; on a shared CPU the high thread then preempts it and
+// blocks, and the medium thread preempts it next.
+template<class Reader>
+static void RunRole(size_t thread_index,
+                    size_t iterations,
+                    uint64_t hold_ticks,
+                    InversionScenario& scenario,
+                    ThreadStatistics& thread_statistics) {
+    for (size_t i = 0; i < iterations; i++) {
+        switch (thread_index) {
+        case LOW_THREAD_INDEX:
+            scenario.lock->lock();
+            scenario.high_go.release();
+            scenario.medium_go.release();
+            SpinFor<Reader>(hold_ticks);
+            scenario.lock->unlock();
+
+            scenario.round_done.acquire();
+            scenario.round_done.acquire();
+            break;
+
+        case MEDIUM_THREAD_INDEX:
+            scenario.medium_go.acquire();
+            SpinFor<Reader>(hold_ticks * MEDIUM_RUN_HOLDS);
+            scenario.round_done.release();
+            break;
+
+        case HIGH_THREAD_INDEX: {
+            scenario.high_go.acquire();
+            uint64_t ta = Reader::read();
+            scenario.lock->lock();
+            uint64_t tb = Reader::read();
+            scenario.lock->unlock();
+
+            thread_statistics.histogram.record(tb - ta);
+            scenario.round_done.release();
+            break;
+        }
+        }
+    }
+}
+
+void com::github::coderodde::wtpdmt::runInversionMode(const InversionConfiguration& configuration,
+                                                      const util::Clock& clock) {
+    // Inversion needs the three threads to compete for one CPU:
+    int cpu = configuration.cpu == UNPINNED_CPU ? 0 : configuration.cpu;
+    std::vector<int> cpus(INVERSION_THREAD_COUNT, cpu);
+    std::vector<int> thread_priorities(configuration.thread_priorities,
+                                       configuration.thread_priorities + INVERSION_THREAD_COUNT);
+    uint64_t hold_ticks = static_cast<uint64_t>(
+        static_cast<double>(configuration.hold_nanoseconds) / clock.getNanosecondsPerTick());
+
+    for (size_t i = 0; i < INVERSION_THREAD_COUNT; i++) {
+        std::cout << "INFO: " << ROLE_NAMES[i] << " thread priority is "
+                  << util::getThreadPriorityName(util::getProcessPriorityClass(), thread_priorities[i])
+                  << ".\n";
+    }
+
+    std::cout << "INFO: On CPU " << cpu << ", the low thread holds the lock for "
+              << configuration.hold_nanoseconds << " ns and the medium thread runs for "
+              << configuration.hold_nanoseconds * MEDIUM_RUN_HOLDS << " ns, "
+              << configuration.iterations << " times per lock.\n";
+
+    std::vector<string> labels;
+    std::vector<std::vector<std::unique_ptr<ThreadStatistics>>> all_statistics;
+    std::vector<const Histogram*> histograms;
+
+    for (LockKind kind : configuration.locks) {
+        string name = getLockKindName(kind);
+        InversionScenario scenario;
+        std::vector<std::unique_ptr<ThreadStatistics>> statistics;
+
+        try {
+            scenario.lock = CreateLock(kind);
+            statistics = runOnThreads(cpus,
+                                      thread_priorities,
+                                      [&](size_t thread_index, ThreadStatistics& thread_statistics) {
+                util::Clock::dispatch(configuration.clock_source, [&](auto reader) {
+                    RunRole<decltype(reader)>(thread_index,
+                                              configuration.iterations,
+                                              hold_ticks,
+                                              scenario,
+                                              thread_statistics);
+                });
+            });
+        } catch (std::runtime_error& err) {
+            std::cout << "WARNING: Skipping " << name << ": " << err.what() << "\n";
+            continue;
+        }
+
+        labels.push_back(name);
+        histograms.push_back(&statistics[HIGH_THREAD_INDEX]->histogram);
+        all_statistics.push_back(std::move(statistics));
+    }
+
+    std::cout << "\nTime the high thread waited for the lock; anything beyond the hold is inversion:\n";
+    printHistogramTable("Lock", labels, histograms, clock, configuration.percentiles);
+}
@@ -0,0 +1,49 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_INVERSION_MODE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_INVERSION_MODE_HPP
+
+#include "Clock.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using std::string;
+
+	enum class LockKind {
+		MUTEX,            // std::mutex
+		CRITICAL_SECTION, // EnterCriticalSection()
+		SRWLOCK,          // AcquireSRWLockExclusive()
+		SPINLOCK,         // Test-and-test-and-set on an atomic flag
+		PI_MUTEX,         // pthread mutex with PTHREAD_PRIO_INHERIT
+		FUTEX             // Three-state lock on a futex (WaitOnAddress() on Windows)
+	};
+
+	std::span<const LockKind> getSupportedLockKinds();
+	string getLockKindName(LockKind kind);
+	bool findLockKind(std::string_view name, LockKind* kind_ptr);
+
+	// The scenario's threads, lowest priority first.
+	constexpr size_t INVERSION_THREAD_COUNT = 3;
+
+	struct InversionConfiguration {
+		util::ClockSource     clock_source;
+		size_t                iterations;
+		uint64_t              hold_nanoseconds; // How long the low thread holds the lock.
+		int                   thread_priorities[INVERSION_THREAD_COUNT];
+		int                   cpu; // UNPINNED_CPU for CPU 0.
+		std::vector<LockKind> locks;
+		std::vector<double>   percentiles;
+	};
+
+	// Runs the classic inversion for every lock: the low thread takes the
+	// lock and wakes the high thread, which blocks on it, and the medium
+	// thread, which spins for ten hold times on the same CPU. Without
+	// priority inheritance the medium thread keeps the holder from
+	// finishing. Prints how long the high thread waited for the lock.
+	void runInversionMode(const InversionConfiguration& configuration, const util::Clock& clock);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_INVERSION_MODE_HPP
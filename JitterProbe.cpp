@@ -0,0 +1,214 @@
+#include "JitterProbe.h"
+#include "MemoryControl.h"
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using com::github::coderodde::wtpdmt::JitterProbeEvent;
+using com::github::coderodde::wtpdmt::JitterSnapshot;
+using com::github::coderodde::wtpdmt::JitterStatistics;
+using com::github::coderodde::wtpdmt::util::Histogram;
+using com::github::coderodde::wtpdmt::util::LiveChannel;
+
+static const std::chrono::microseconds SWAP_POLL_INTERVAL{ 100 };
+
+// The loop of runGapLoop() with a LiveRecorder, plus a callback.
+// The callback runs between two reads, so the next gap starts after it.
+template<class Reader>
+static void ProbeGaps(LiveChannel& channel,
+                      uint64_t threshold_ticks,
+                      double nanoseconds_per_tick,
+                      const com::github::coderodde::wtpdmt::JitterCallback& callback,
+                      std::atomic<uint64_t>& threshold_exceeded) {
+    uint32_t generation = 0;
+    Histogram* histogram = &channel.getBuffer(generation);
+    uint64_t ta = Reader::read();
+
+    while (true) {
+        uint64_t tb = Reader::read();
+        uint64_t gap = tb - ta;
+        histogram->record(gap);
+
+        if (gap >= threshold_ticks) {
+            // The probe thread is the only writer:
+            threshold_exceeded.store(threshold_exceeded.load(std::memory_order_relaxed) + 1,
+                                     std::memory_order_relaxed);
+
+            callback(JitterProbeEvent{
+                static_cast<uint64_t>(static_cast<double>(gap) * nanoseconds_per_tick + 0.5),
+                tb });
+
+            tb = Reader::read();
+        }
+
+        if (channel.swapRequested(generation)) {
+            generation = channel.acknowledgeSwap();
+            histogram = &channel.getBuffer(generation);
+
+            if (LiveChannel::isStopGeneration(generation)) {
+                break;
+            }
+        }
+
+        ta = tb;
+    }
+}
+
+com::github::coderodde::wtpdmt::JitterProbe::JitterProbe(const JitterProbeOptions& options) :
+    m_options                            { options },
+    m_clock                              { options.clock_source },
+    m_threshold_ticks                    { UINT64_MAX },
+    m_channel                            { std::make_unique<LiveChannel>() },
+    m_since_start                        { std::make_unique<Histogram>() },
+    m_since_last_snapshot                { std::make_unique<Histogram>() },
+    m_threshold_exceeded_at_last_snapshot{ 0 },
+    m_generation                         { 0 },
+    m_ready_latch                        { 1 },
+    m_started                            { false },
+    m_stopped                            { false },
+    m_threshold_exceeded                 { 0 }
+{
+    if (options.threshold_nanoseconds > 0) {
+        if (!options.on_threshold_exceeded) {
+            throw std::logic_error{ "A jitter probe with a threshold needs a callback." };
+        }
+
+        m_threshold_ticks = static_cast<uint64_t>(options.threshold_nanoseconds / m_clock.getNanosecondsPerTick());
+    }
+}
+
+com::github::coderodde::wtpdmt::JitterProbe::~JitterProbe() {
+    try {
+        stop();
+    } catch (...) {
+        // A failed probe has nothing left to clean up.
+    }
+}
+
+void com::github::coderodde::wtpdmt::JitterProbe::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_started) {
+        throw std::logic_error{ "A jitter probe runs only once." };
+    }
+
+    m_started = true;
+    m_thread = std::thread(&JitterProbe::run, this);
+    m_ready_latch.wait();
+
+    if (m_error) {
+        m_thread.join();
+        m_stopped = true;
+        std::rethrow_exception(m_error);
+    }
+}
+
+void com::github::coderodde::wtpdmt::JitterProbe::stop() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_started || m_stopped) {
+        return;
+    }
+
+    m_generation = m_channel->requestStop();
+    m_thread.join();
+    m_stopped = true;
+    drain(m_channel->takeBuffer(m_generation, SWAP_POLL_INTERVAL));
+
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+}
+
+JitterSnapshot com::github::coderodde::wtpdmt::JitterProbe::snapshot() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_started && !m_stopped) {
+        m_generation = m_channel->requestSwap();
+        drain(m_channel->takeBuffer(m_generation, SWAP_POLL_INTERVAL));
+    }
+
+    uint64_t threshold_exceeded = m_threshold_exceeded.load(std::memory_order_relaxed);
+
+    JitterSnapshot snapshot;
+    snapshot.since_start         = getStatistics(*m_since_start, threshold_exceeded);
+    snapshot.since_last_snapshot = getStatistics(*m_since_last_snapshot,
+                                                 threshold_exceeded - m_threshold_exceeded_at_last_snapshot);
+
+    m_since_last_snapshot->reset();
+    m_threshold_exceeded_at_last_snapshot = threshold_exceeded;
+    return snapshot;
+}
+
+bool com::github::coderodde::wtpdmt::JitterProbe::isRunning() const {
+    return m_started && !m_stopped;
+}
+
+const com::github::coderodde::wtpdmt::util::Clock& com::github::coderodde::wtpdmt::JitterProbe::getClock() const {
+    return m_clock;
+}
+
+void com::github::coderodde::wtpdmt::JitterProbe::run() {
+    try {
+        if (m_options.cpu != UNPINNED_PROBE_CPU) {
+            util::pinCurrentThreadToCpu(m_options.cpu);
+        }
+
+        util::setCurrentThreadPriority(m_options.priority_class, m_options.thread_priority);
+
+        if (util::getMemoryPolicy().prefault) {
+            util::prefaultCurrentStack();
+        }
+    } catch (...) {
+        m_error = std::current_exception();
+    }
+
+    m_ready_latch.count_down();
+
+    if (m_error) {
+        return;
+    }
+
+    try {
+        util::Clock::dispatch(m_clock.getSource(), [this](auto reader) {
+            ProbeGaps<decltype(reader)>(*m_channel,
+                                        m_threshold_ticks,
+                                        m_clock.getNanosecondsPerTick(),
+                                        m_options.on_threshold_exceeded,
+                                        m_threshold_exceeded);
+        });
+    } catch (...) {
+        m_error = std::current_exception();
+    }
+
+    m_channel->finish();
+}
+
+// Takes over a buffer the probe thread has left; the thread will record
+// into it again after the next swap.
+void com::github::coderodde::wtpdmt::JitterProbe::drain(Histogram& buffer) {
+    m_since_start->add(buffer);
+    m_since_last_snapshot->add(buffer);
+    buffer.reset();
+}
+
+JitterStatistics com::github::coderodde::wtpdmt::JitterProbe::getStatistics(const Histogram& histogram,
+                                                                            uint64_t threshold_exceeded) const {
+    JitterStatistics statistics;
+    statistics.samples                        = histogram.getCount();
+    statistics.minimum_nanoseconds            = m_clock.ticksToNanoseconds(histogram.getMinimum());
+    statistics.mean_nanoseconds               = histogram.getMean() * m_clock.getNanosecondsPerTick();
+    statistics.standard_deviation_nanoseconds = histogram.getStandardDeviation() * m_clock.getNanosecondsPerTick();
+    statistics.p50_nanoseconds                = m_clock.ticksToNanoseconds(histogram.getValueAtPercentile(50.0));
+    statistics.p90_nanoseconds                = m_clock.ticksToNanoseconds(histogram.getValueAtPercentile(90.0));
+    statistics.p99_nanoseconds                = m_clock.ticksToNanoseconds(histogram.getValueAtPercentile(99.0));
+    statistics.p99_9_nanoseconds              = m_clock.ticksToNanoseconds(histogram.getValueAtPercentile(99.9));
+    statistics.p99_99_nanoseconds             = m_clock.ticksToNanoseconds(histogram.getValueAtPercentile(99.99));
+    statistics.maximum_nanoseconds            = m_clock.ticksToNanoseconds(histogram.getMaximum());
+    statistics.threshold_exceeded             = threshold_exceeded;
+    return statistics;
+}
@@ -0,0 +1,127 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_JITTER_PROBE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_JITTER_PROBE_HPP
+
+#include "Clock.h"
+#include "Histogram.h"
+#include "LiveChannel.h"
+#include "ThreadControl.h"
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace com::github::coderodde::wtpdmt {
+
+	// A gap of at least the threshold, as handed to the callback.
+	struct JitterProbeEvent {
+		uint64_t gap_nanoseconds;
+		uint64_t end_ticks; // Clock reading that closed the gap.
+	};
+
+	// Runs on the probe thread, between two samples. It must not throw;
+	// the time it takes is left out of the following gap.
+	using JitterCallback = std::function<void(const JitterProbeEvent&)>;
+
+	struct JitterProbeOptions {
+		util::ClockSource   clock_source;
+		int                 cpu;             // UNPINNED_PROBE_CPU leaves the thread to the scheduler.
+		util::PriorityClass priority_class;  // See util::PriorityClass; PriorityNames.h maps the names.
+		int                 thread_priority;
+		uint64_t            threshold_nanoseconds; // 0 for no callback.
+		JitterCallback      on_threshold_exceeded;
+	};
+
+	constexpr int UNPINNED_PROBE_CPU = -1;
+
+	struct JitterStatistics {
+		uint64_t samples;
+		uint64_t minimum_nanoseconds;
+		double   mean_nanoseconds;
+		double   standard_deviation_nanoseconds;
+		uint64_t p50_nanoseconds;
+		uint64_t p90_nanoseconds;
+		uint64_t p99_nanoseconds;
+		uint64_t p99_9_nanoseconds;
+		uint64_t p99_99_nanoseconds;
+		uint64_t maximum_nanoseconds;
+		uint64_t threshold_exceeded;
+	};
+
+	struct JitterSnapshot {
+		JitterStatistics since_start;
+		JitterStatistics since_last_snapshot;
+	};
+
+	// A watchdog thread for embedding into a latency-critical process: it
+	// spins on one core, reads the clock back to back and records every
+	// gap, the same way the gaps mode of wt does.
+	//
+	// Overhead:
+	//  - The probe keeps its core 100% busy; give it a core of its own. A
+	//    real-time probe on a shared core leaves the threads calling
+	//    snapshot() and stop() only what real-time throttling allows.
+	//  - Per sample it costs one clock read (see
+	//    Clock::getReadCostNanoseconds()), one histogram record, one
+	//    acquire load of a cache line that only snapshot() writes, and
+	//    one compare against the threshold.
+	//  - The constructor calibrates the clock (tens of milliseconds) and
+	//    allocates three histograms of about 30 KiB each; start() creates
+	//    the thread. After start() returns, neither the probe thread nor
+	//    snapshot() nor stop() allocates; only the callback may.
+	//  - snapshot() makes the probe switch buffers and polls every 100 µs
+	//    until it has, so a snapshot takes at least that long. The probe
+	//    never waits for it.
+	class JitterProbe {
+	private:
+
+		JitterProbeOptions                 m_options;
+		util::Clock                        m_clock;
+		uint64_t                           m_threshold_ticks; // UINT64_MAX for no callback.
+		std::unique_ptr<util::LiveChannel> m_channel;
+		std::unique_ptr<util::Histogram>   m_since_start;
+		std::unique_ptr<util::Histogram>   m_since_last_snapshot;
+		uint64_t                           m_threshold_exceeded_at_last_snapshot;
+		uint32_t                           m_generation;
+		std::latch                         m_ready_latch;
+		std::exception_ptr                 m_error;
+		std::mutex                         m_mutex;
+		std::thread                        m_thread;
+		bool                               m_started;
+		bool                               m_stopped;
+
+		alignas(util::CACHE_LINE_SIZE) std::atomic<uint64_t> m_threshold_exceeded;
+
+	public:
+
+		explicit JitterProbe(const JitterProbeOptions& options);
+		~JitterProbe();
+
+		JitterProbe(const JitterProbe&) = delete;
+		JitterProbe& operator=(const JitterProbe&) = delete;
+
+		// Starts the probe thread and returns once it is pinned and at its
+		// priority. Throws what setting up the thread threw. A probe runs
+		// once.
+		void start();
+
+		// Stops and joins the probe thread. Snapshots still work after.
+		void stop();
+
+		// Everything since start() and since the previous snapshot.
+		JitterSnapshot snapshot();
+
+		bool isRunning() const;
+		const util::Clock& getClock() const;
+
+	private:
+
+		void run();
+		void drain(util::Histogram& buffer);
+		JitterStatistics getStatistics(const util::Histogram& histogram, uint64_t threshold_exceeded) const;
+	};
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_JITTER_PROBE_HPP
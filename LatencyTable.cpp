@@ -0,0 +1,99 @@
+#include "LatencyTable.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::LatencySummary;
+using com::github::coderodde::wtpdmt::util::Histogram;
+
+static const int TABLE_COLUMN_WIDTH = 12;
+
+static uint64_t ToNanoseconds(uint64_t ticks, double nanoseconds_per_tick) {
+    return static_cast<uint64_t>(static_cast<double>(ticks) * nanoseconds_per_tick + 0.5);
+}
+
+string com::github::coderodde::wtpdmt::getPercentileLabel(double percentile) {
+    std::stringstream label;
+    label << "p" << percentile;
+    return label.str();
+}
+
+LatencySummary com::github::coderodde::wtpdmt::summarizeHistogram(const Histogram& histogram,
+                                                                  double nanoseconds_per_tick,
+                                                                  const std::vector<double>& percentiles) {
+    LatencySummary summary;
+    summary.samples                        = histogram.getCount();
+    summary.minimum_nanoseconds            = ToNanoseconds(histogram.getMinimum(), nanoseconds_per_tick);
+    summary.mean_nanoseconds               = histogram.getMean() * nanoseconds_per_tick;
+    summary.standard_deviation_nanoseconds = histogram.getStandardDeviation() * nanoseconds_per_tick;
+    summary.maximum_nanoseconds            = ToNanoseconds(histogram.getMaximum(), nanoseconds_per_tick);
+
+    for (double percentile : percentiles) {
+        summary.percentile_nanoseconds.push_back(
+            ToNanoseconds(histogram.getValueAtPercentile(percentile), nanoseconds_per_tick));
+    }
+
+    return summary;
+}
+
+void com::github::coderodde::wtpdmt::printLatencyTable(const string& label_title,
+                                                       const std::vector<string>& labels,
+                                                       const std::vector<LatencySummary>& rows,
+                                                       const std::vector<double>& percentiles) {
+    // Widen the label column for long labels such as mechanism names:
+    int label_width = (std::max)(TABLE_COLUMN_WIDTH, static_cast<int>(label_title.length()) + 2);
+
+    for (const string& label : labels) {
+        label_width = (std::max)(label_width, static_cast<int>(label.length()) + 2);
+    }
+
+    std::cout << std::fixed << std::setprecision(1) << std::right << std::setfill(' ');
+
+    std::cout << std::setw(label_width) << label_title
+              << std::setw(TABLE_COLUMN_WIDTH) << "Samples"
+              << std::setw(TABLE_COLUMN_WIDTH) << "Min"
+              << std::setw(TABLE_COLUMN_WIDTH) << "Mean"
+              << std::setw(TABLE_COLUMN_WIDTH) << "StdDev";
+
+    for (double percentile : percentiles) {
+        std::cout << std::setw(TABLE_COLUMN_WIDTH) << getPercentileLabel(percentile);
+    }
+
+    std::cout << std::setw(TABLE_COLUMN_WIDTH) << "Max" << "  (ns)\n";
+
+    for (size_t i = 0; i < rows.size(); i++) {
+        const LatencySummary& row = rows[i];
+
+        std::cout << std::setw(label_width) << labels[i]
+                  << std::setw(TABLE_COLUMN_WIDTH) << row.samples
+                  << std::setw(TABLE_COLUMN_WIDTH) << row.minimum_nanoseconds
+                  << std::setw(TABLE_COLUMN_WIDTH) << row.mean_nanoseconds
+                  << std::setw(TABLE_COLUMN_WIDTH) << row.standard_deviation_nanoseconds;
+
+        for (uint64_t value : row.percentile_nanoseconds) {
+            std::cout << std::setw(TABLE_COLUMN_WIDTH) << value;
+        }
+
+        std::cout << std::setw(TABLE_COLUMN_WIDTH) << row.maximum_nanoseconds << "\n";
+    }
+
+    std::cout << std::defaultfloat;
+}
+
+void com::github::coderodde::wtpdmt::printHistogramTable(const string& label_title,
+                                                         const std::vector<string>& labels,
+                                                         const std::vector<const Histogram*>& histograms,
+                                                         double nanoseconds_per_tick,
+                                                         const std::vector<double>& percentiles) {
+    std::vector<LatencySummary> rows;
+
+    for (const Histogram* histogram : histograms) {
+        rows.push_back(summarizeHistogram(*histogram, nanoseconds_per_tick, percentiles));
+    }
+
+    printLatencyTable(label_title, labels, rows, percentiles);
+}
@@ -0,0 +1,43 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_LATENCY_TABLE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_LATENCY_TABLE_HPP
+
+#include "Histogram.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	// One row of a latency table, in nanoseconds.
+	struct LatencySummary {
+		uint64_t              samples;
+		uint64_t              minimum_nanoseconds;
+		double                mean_nanoseconds;
+		double                standard_deviation_nanoseconds;
+		std::vector<uint64_t> percentile_nanoseconds; // One per percentile of the table.
+		uint64_t              maximum_nanoseconds;
+	};
+
+	std::string getPercentileLabel(double percentile);
+
+	// Summarizes a histogram of ticks; 'nanoseconds_per_tick' is 1 for a
+	// histogram of nanoseconds.
+	LatencySummary summarizeHistogram(const util::Histogram& histogram,
+									  double nanoseconds_per_tick,
+									  const std::vector<double>& percentiles);
+
+	// The table the modes, wtshm and wtanalyze share: a label column, then
+	// the samples, minimum, mean, standard deviation, percentiles and
+	// maximum of each row.
+	void printLatencyTable(const std::string& label_title,
+						   const std::vector<std::string>& labels,
+						   const std::vector<LatencySummary>& rows,
+						   const std::vector<double>& percentiles);
+
+	void printHistogramTable(const std::string& label_title,
+							 const std::vector<std::string>& labels,
+							 const std::vector<const util::Histogram*>& histograms,
+							 double nanoseconds_per_tick,
+							 const std::vector<double>& percentiles);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_LATENCY_TABLE_HPP
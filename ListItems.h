@@ -0,0 +1,25 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_LIST_ITEMS_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_LIST_ITEMS_HPP
+
+#include <cstddef>
+#include <string_view>
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	// Takes the next item of a list separated by 'separator' off the front
+	// of 'list' without copying it, as std::getline() would read it from a
+	// stream: "a,,b" has an empty item in the middle, "a," only the one.
+	// Returns false, with an empty item, once the list is used up.
+	inline bool nextListItem(std::string_view& list, char separator, std::string_view* item) {
+		if (list.empty()) {
+			*item = {};
+			return false;
+		}
+
+		size_t end = list.find(separator);
+		*item = list.substr(0, end);
+		list = end == std::string_view::npos ? std::string_view{} : list.substr(end + 1);
+		return true;
+	}
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_LIST_ITEMS_HPP
@@ -0,0 +1,116 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_LIVE_CHANNEL_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_LIVE_CHANNEL_HPP
+
+#include "Histogram.h"
+#include "MemoryControl.h"
+#include "ThreadControl.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	// Hands the histogram of a running measurement to a reader without
+	// stopping it. The writer records into one of two buffers; the reader
+	// asks for a swap and, once the writer acknowledges it, owns the other
+	// buffer until it asks again. The writer pays one load of a rarely
+	// written cache line per sample and never waits, locks or calls into
+	// the kernel.
+	class alignas(CACHE_LINE_SIZE) LiveChannel {
+	public:
+
+		// Set in a requested generation to also ask the writer to stop.
+		// It rides on the swap request so that stopping adds nothing to
+		// the loop.
+		static constexpr uint32_t STOP_GENERATION_BIT = uint32_t(1) << 31;
+
+	private:
+
+		Histogram m_buffers[2];
+
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> m_requested_generation;    // Written by the reader.
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> m_acknowledged_generation; // Written by the writer.
+		std::atomic<bool>                              m_finished;                // Written by the writer.
+
+	public:
+
+		LiveChannel() :
+			m_requested_generation   { 0 },
+			m_acknowledged_generation{ 0 },
+			m_finished               { false }
+		{}
+
+		static void* operator new(size_t size) {
+			return allocateMeasurementMemory(size);
+		}
+
+		static void operator delete(void* data, size_t size) {
+			freeMeasurementMemory(data, size);
+		}
+
+		// The writer side:
+
+		Histogram& getBuffer(uint32_t generation) {
+			return m_buffers[generation & 1];
+		}
+
+		bool swapRequested(uint32_t generation) const {
+			return m_requested_generation.load(std::memory_order_acquire) != generation;
+		}
+
+		// Moves the writer to the requested generation's buffer and
+		// returns that generation.
+		uint32_t acknowledgeSwap() {
+			uint32_t generation = m_requested_generation.load(std::memory_order_acquire);
+			m_acknowledged_generation.store(generation, std::memory_order_release);
+			return generation;
+		}
+
+		static bool isStopGeneration(uint32_t generation) {
+			return (generation & STOP_GENERATION_BIT) != 0;
+		}
+
+		void finish() {
+			m_finished.store(true, std::memory_order_release);
+		}
+
+		// The reader side:
+
+		// Returns the generation to wait for; the buffer of the one before
+		// it is the reader's once swapCompleted() or isFinished().
+		uint32_t requestSwap() {
+			uint32_t generation = m_requested_generation.load(std::memory_order_relaxed) + 1;
+			m_requested_generation.store(generation, std::memory_order_release);
+			return generation;
+		}
+
+		// Like requestSwap(), but the writer leaves its loop once it has
+		// moved to the new buffer.
+		uint32_t requestStop() {
+			uint32_t generation = (m_requested_generation.load(std::memory_order_relaxed) + 1) | STOP_GENERATION_BIT;
+			m_requested_generation.store(generation, std::memory_order_release);
+			return generation;
+		}
+
+		bool swapCompleted(uint32_t generation) const {
+			return m_acknowledged_generation.load(std::memory_order_acquire) == generation;
+		}
+
+		bool isFinished() const {
+			return m_finished.load(std::memory_order_acquire);
+		}
+
+		// Waits, polling every 'poll_interval', until the writer has taken
+		// 'generation' or finished, and returns the buffer it left behind.
+		Histogram& takeBuffer(uint32_t generation, std::chrono::microseconds poll_interval) {
+			while (!swapCompleted(generation) && !isFinished()) {
+				std::this_thread::sleep_for(poll_interval);
+			}
+
+			return getBuffer(generation - 1);
+		}
+	};
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_LIVE_CHANNEL_HPP
@@ -0,0 +1,206 @@
+#include "LiveReporter.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::LiveReportFormat;
+using com::github::coderodde::wtpdmt::util::Histogram;
+using com::github::coderodde::wtpdmt::util::LiveChannel;
+
+// Format names as accepted by --report-format:
+static const string FORMAT_CSV_STR  = "csv";
+static const string FORMAT_JSON_STR = "json";
+
+// How long the reporter sleeps at most before looking at the stop flag,
+// and how often it checks for a swap to be acknowledged:
+static const std::chrono::milliseconds REPORTER_MAXIMUM_SLEEP{ 100 };
+static const std::chrono::microseconds SWAP_POLL_INTERVAL{ 100 };
+
+static string GetPercentileColumnName(double percentile) {
+    std::stringstream name;
+    name << "p" << percentile << "_ns";
+    return name.str();
+}
+
+string com::github::coderodde::wtpdmt::getLiveReportFormatName(LiveReportFormat format) {
+    return format == LiveReportFormat::CSV ? FORMAT_CSV_STR : FORMAT_JSON_STR;
+}
+
+bool com::github::coderodde::wtpdmt::findLiveReportFormat(const string& name, LiveReportFormat* format) {
+    if (name == FORMAT_CSV_STR) {
+        *format = LiveReportFormat::CSV;
+        return true;
+    }
+
+    if (name == FORMAT_JSON_STR) {
+        *format = LiveReportFormat::JSON;
+        return true;
+    }
+
+    return false;
+}
+
+com::github::coderodde::wtpdmt::LiveReporter::LiveReporter(const util::Clock& clock,
+                                                           const std::vector<int>& cpus,
+                                                           uint64_t interval_milliseconds,
+                                                           LiveReportFormat format,
+                                                           const std::vector<double>& percentiles) :
+    m_clock             { clock },
+    m_cpus              { cpus },
+    m_interval          { static_cast<std::chrono::milliseconds::rep>(interval_milliseconds) },
+    m_format            { format },
+    m_percentiles       { percentiles },
+    m_interval_aggregate{ std::make_unique<Histogram>() },
+    m_stop_requested    { false }
+{
+    for (size_t i = 0; i < cpus.size(); i++) {
+        m_channels.push_back(std::make_unique<LiveChannel>());
+        m_totals.push_back(std::make_unique<Histogram>());
+    }
+}
+
+com::github::coderodde::wtpdmt::LiveReporter::~LiveReporter() {
+    if (m_reporter_thread.joinable()) {
+        // Only reached when the measurement failed. Its threads are gone,
+        // some perhaps before they took their first sample, so a report in
+        // progress must not wait for them:
+        for (std::unique_ptr<LiveChannel>& channel : m_channels) {
+            channel->finish();
+        }
+
+        m_stop_requested.store(true, std::memory_order_release);
+        m_reporter_thread.join();
+    }
+}
+
+LiveChannel& com::github::coderodde::wtpdmt::LiveReporter::getChannel(size_t thread_index) {
+    return *m_channels[thread_index];
+}
+
+void com::github::coderodde::wtpdmt::LiveReporter::start() {
+    printHeader();
+    m_start_time = std::chrono::steady_clock::now();
+
+    m_reporter_thread = std::thread([this]() {
+        util::setCurrentThreadBackgroundPriority();
+
+        std::chrono::steady_clock::time_point next_report = m_start_time + m_interval;
+
+        while (!m_stop_requested.load(std::memory_order_acquire)) {
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+            if (now >= next_report) {
+                reportInterval();
+                next_report += m_interval;
+            } else {
+                std::this_thread::sleep_for((std::min)(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(next_report - now),
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(REPORTER_MAXIMUM_SLEEP)));
+            }
+        }
+    });
+}
+
+void com::github::coderodde::wtpdmt::LiveReporter::stop(std::vector<std::unique_ptr<ThreadStatistics>>& statistics) {
+    m_stop_requested.store(true, std::memory_order_release);
+    m_reporter_thread.join();
+
+    // The threads are done, so this drains whatever they recorded since
+    // the last report:
+    reportInterval();
+
+    for (size_t i = 0; i < statistics.size(); i++) {
+        statistics[i]->histogram.add(*m_totals[i]);
+    }
+}
+
+void com::github::coderodde::wtpdmt::LiveReporter::reportInterval() {
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start_time).count();
+    m_interval_aggregate->reset();
+
+    for (size_t i = 0; i < m_channels.size(); i++) {
+        LiveChannel& channel = *m_channels[i];
+        // A thread that has finished will not acknowledge, but then it
+        // does not write either:
+        Histogram& drained = channel.takeBuffer(channel.requestSwap(), SWAP_POLL_INTERVAL);
+
+        printLine(elapsed_seconds, std::to_string(i), m_cpus[i], drained);
+        m_interval_aggregate->add(drained);
+        m_totals[i]->add(drained);
+        drained.reset();
+    }
+
+    if (m_channels.size() > 1) {
+        printLine(elapsed_seconds, "all", UNPINNED_CPU, *m_interval_aggregate);
+    }
+
+    std::cout.flush();
+}
+
+void com::github::coderodde::wtpdmt::LiveReporter::printHeader() {
+    if (m_format != LiveReportFormat::CSV) {
+        return;
+    }
+
+    std::cout << "elapsed_s,thread,cpu,samples,min_ns,mean_ns";
+
+    for (double percentile : m_percentiles) {
+        std::cout << "," << GetPercentileColumnName(percentile);
+    }
+
+    std::cout << ",max_ns\n";
+}
+
+void com::github::coderodde::wtpdmt::LiveReporter::printLine(double elapsed_seconds,
+                                                             const string& thread_label,
+                                                             int cpu,
+                                                             const Histogram& histogram) {
+    bool empty = histogram.getCount() == 0;
+    uint64_t minimum = empty ? 0 : m_clock.ticksToNanoseconds(histogram.getMinimum());
+    uint64_t maximum = empty ? 0 : m_clock.ticksToNanoseconds(histogram.getMaximum());
+    double mean = histogram.getMean() * m_clock.getNanosecondsPerTick();
+    bool json = m_format == LiveReportFormat::JSON;
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    if (json) {
+        std::cout << "{\"elapsed_s\":" << elapsed_seconds
+                  << ",\"thread\":\"" << thread_label << "\""
+                  << ",\"cpu\":" << cpu
+                  << ",\"samples\":" << histogram.getCount()
+                  << ",\"min_ns\":" << minimum
+                  << ",\"mean_ns\":" << std::setprecision(1) << mean;
+    } else {
+        std::cout << elapsed_seconds
+                  << "," << thread_label
+                  << "," << cpu
+                  << "," << histogram.getCount()
+                  << "," << minimum
+                  << "," << std::setprecision(1) << mean;
+    }
+
+    for (double percentile : m_percentiles) {
+        uint64_t value = empty ? 0 : m_clock.ticksToNanoseconds(histogram.getValueAtPercentile(percentile));
+
+        if (json) {
+            std::cout << ",\"" << GetPercentileColumnName(percentile) << "\":" << value;
+        } else {
+            std::cout << "," << value;
+        }
+    }
+
+    if (json) {
+        std::cout << ",\"max_ns\":" << maximum << "}\n";
+    } else {
+        std::cout << "," << maximum << "\n";
+    }
+
+    std::cout << std::defaultfloat;
+}
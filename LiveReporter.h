@@ -0,0 +1,75 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_LIVE_REPORTER_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_LIVE_REPORTER_HPP
+
+#include "Clock.h"
+#include "Histogram.h"
+#include "LiveChannel.h"
+#include "Measurement.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using std::string;
+
+	enum class LiveReportFormat {
+		CSV, // A header line, then one line per thread and interval
+		JSON // One object per thread and interval (JSON Lines)
+	};
+
+	string getLiveReportFormatName(LiveReportFormat format);
+	bool findLiveReportFormat(const string& name, LiveReportFormat* format);
+
+	// Prints the gaps of every interval while the measurement runs. The
+	// reporter thread runs at background priority and does all the
+	// formatting and I/O; the measuring threads only record into their
+	// LiveChannel.
+	class LiveReporter {
+	private:
+
+		const util::Clock&                              m_clock;
+		std::vector<int>                                m_cpus;
+		std::chrono::milliseconds                       m_interval;
+		LiveReportFormat                                m_format;
+		std::vector<double>                             m_percentiles;
+		std::vector<std::unique_ptr<util::LiveChannel>> m_channels;
+		std::vector<std::unique_ptr<Histogram>>         m_totals; // Per thread, over the drained intervals.
+		std::unique_ptr<Histogram>                      m_interval_aggregate;
+		std::chrono::steady_clock::time_point           m_start_time;
+		std::atomic<bool>                               m_stop_requested;
+		std::thread                                     m_reporter_thread;
+
+	public:
+
+		LiveReporter(const util::Clock& clock,
+					 const std::vector<int>& cpus,
+					 uint64_t interval_milliseconds,
+					 LiveReportFormat format,
+					 const std::vector<double>& percentiles);
+		~LiveReporter();
+
+		util::LiveChannel& getChannel(size_t thread_index);
+
+		void start();
+
+		// Call once the measuring threads are done: reports the last,
+		// partial interval and adds everything the threads recorded to
+		// their histograms in 'statistics'.
+		void stop(std::vector<std::unique_ptr<ThreadStatistics>>& statistics);
+
+	private:
+
+		void reportInterval();
+		void printHeader();
+		void printLine(double elapsed_seconds,
+					   const string& thread_label,
+					   int cpu,
+					   const Histogram& histogram);
+	};
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_LIVE_REPORTER_HPP
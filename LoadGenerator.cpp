@@ -0,0 +1,341 @@
+#include "LoadGenerator.h"
+#include "Measurement.h"
+#include "SystemError.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::LoadKind;
+using com::github::coderodde::wtpdmt::LoadSpecification;
+using com::github::coderodde::wtpdmt::util::throwSystemError;
+
+// Load names as accepted by --load:
+static const string LOAD_SPIN_STR    = "spin";
+static const string LOAD_MEMORY_STR  = "memory";
+static const string LOAD_CACHE_STR   = "cache";
+static const string LOAD_SYSCALL_STR = "syscall";
+static const string LOAD_DISK_STR    = "disk";
+
+static const std::vector<std::pair<LoadKind, string>> LOAD_KIND_NAMES = {
+    { LoadKind::SPIN,    LOAD_SPIN_STR    },
+    { LoadKind::MEMORY,  LOAD_MEMORY_STR  },
+    { LoadKind::CACHE,   LOAD_CACHE_STR   },
+    { LoadKind::SYSCALL, LOAD_SYSCALL_STR },
+    { LoadKind::DISK,    LOAD_DISK_STR    },
+};
+
+// Well beyond the last-level cache of current CPUs:
+static const size_t MEMORY_BUFFER_WORDS = 64 * 1024 * 1024 / sizeof(uint64_t);
+static const size_t CACHE_BUFFER_WORDS  = 32 * 1024 * 1024 / sizeof(uint64_t);
+
+// The pointer chase visits one word per cache line:
+static const size_t CACHE_LINE_WORDS = com::github::coderodde::wtpdmt::util::CACHE_LINE_SIZE / sizeof(uint64_t);
+static const size_t CACHE_HOPS_PER_ROUND = 64 * 1024;
+
+static const size_t SPIN_ITERATIONS_PER_ROUND = 1024 * 1024;
+
+static const size_t DISK_BLOCK_WORDS = 1024 * 1024 / sizeof(uint64_t);
+static const size_t DISK_FILE_BLOCKS = 64; // The file wraps around at 64 MiB.
+
+// Links the cache lines of 'buffer' into a single cycle in random order
+// (Sattolo's algorithm), so that the prefetcher cannot guess the next one.
+static void BuildPointerChase(uint64_t* buffer, size_t words) {
+    size_t node_count = words / CACHE_LINE_WORDS;
+    std::vector<size_t> order(node_count);
+    std::mt19937_64 random;
+
+    for (size_t i = 0; i < node_count; i++) {
+        order[i] = i;
+    }
+
+    for (size_t i = node_count - 1; i > 0; i--) {
+        std::uniform_int_distribution<size_t> distribution(0, i - 1);
+        std::swap(order[i], order[distribution(random)]);
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        buffer[order[i] * CACHE_LINE_WORDS] = order[(i + 1) % node_count] * CACHE_LINE_WORDS;
+    }
+}
+
+static size_t GetBufferWords(LoadKind kind) {
+    switch (kind) {
+        case LoadKind::MEMORY:
+            return MEMORY_BUFFER_WORDS;
+
+        case LoadKind::CACHE:
+            return CACHE_BUFFER_WORDS;
+
+        case LoadKind::DISK:
+            return DISK_BLOCK_WORDS;
+
+        default:
+            return 0;
+    }
+}
+
+// Writes and flushes one block per round to a scratch file that wraps
+// around, so that the disk stays busy without filling up.
+class ScratchFile {
+private:
+
+#ifdef _WIN32
+    HANDLE m_handle;
+#else
+    int    m_descriptor;
+#endif
+    size_t m_block_index;
+
+public:
+
+    explicit ScratchFile(const string& path) : m_block_index{ 0 } {
+#ifdef _WIN32
+        m_handle = CreateFileA(path.c_str(),
+                               GENERIC_WRITE,
+                               0,
+                               nullptr,
+                               CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL,
+                               nullptr);
+
+        if (m_handle == INVALID_HANDLE_VALUE) {
+            throwSystemError("create the scratch file '" + path + "'");
+        }
+#else
+        m_descriptor = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+
+        if (m_descriptor < 0) {
+            throwSystemError("create the scratch file '" + path + "'");
+        }
+#endif
+    }
+
+    ~ScratchFile() {
+#ifdef _WIN32
+        CloseHandle(m_handle);
+#else
+        close(m_descriptor);
+#endif
+    }
+
+    ScratchFile(const ScratchFile&) = delete;
+    ScratchFile& operator=(const ScratchFile&) = delete;
+
+    void writeBlock(const uint64_t* block) {
+        size_t block_size = DISK_BLOCK_WORDS * sizeof(uint64_t);
+
+#ifdef _WIN32
+        LARGE_INTEGER offset;
+        offset.QuadPart = static_cast<LONGLONG>(m_block_index * block_size);
+        DWORD written;
+
+        if (!SetFilePointerEx(m_handle, offset, nullptr, FILE_BEGIN) ||
+            !WriteFile(m_handle, block, static_cast<DWORD>(block_size), &written, nullptr) ||
+            !FlushFileBuffers(m_handle)) {
+            throwSystemError("write the scratch file");
+        }
+#else
+        if (pwrite(m_descriptor, block, block_size, static_cast<off_t>(m_block_index * block_size)) < 0 ||
+            fdatasync(m_descriptor) != 0) {
+            throwSystemError("write the scratch file");
+        }
+#endif
+
+        m_block_index = (m_block_index + 1) % DISK_FILE_BLOCKS;
+    }
+};
+
+string com::github::coderodde::wtpdmt::getLoadKindName(LoadKind kind) {
+    for (const auto& entry : LOAD_KIND_NAMES) {
+        if (entry.first == kind) {
+            return entry.second;
+        }
+    }
+
+    throw std::logic_error{ "Unknown load kind." };
+}
+
+bool com::github::coderodde::wtpdmt::findLoadKind(std::string_view name, LoadKind* kind) {
+    for (const auto& entry : LOAD_KIND_NAMES) {
+        if (entry.second == name) {
+            *kind = entry.first;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<LoadKind> com::github::coderodde::wtpdmt::getLoadKinds() {
+    std::vector<LoadKind> kinds;
+
+    for (const auto& entry : LOAD_KIND_NAMES) {
+        kinds.push_back(entry.first);
+    }
+
+    return kinds;
+}
+
+com::github::coderodde::wtpdmt::LoadGenerator::LoadGenerator(const std::vector<LoadSpecification>& loads) :
+    m_loads         { loads },
+    m_errors        ( loads.size() ),
+    m_stop_requested{ false }
+{
+    for (size_t i = 0; i < loads.size(); i++) {
+        size_t words = GetBufferWords(loads[i].kind);
+
+        // make_unique value-initializes, which also faults the pages in
+        // before the measurement starts:
+        m_counters.push_back(std::make_unique<LoadCounter>());
+        m_buffers.push_back(words == 0 ? nullptr : std::make_unique<uint64_t[]>(words));
+
+        if (loads[i].kind == LoadKind::CACHE) {
+            BuildPointerChase(m_buffers[i].get(), words);
+        }
+
+        string path;
+
+        if (loads[i].kind == LoadKind::DISK) {
+            path = (std::filesystem::temp_directory_path() / ("wtpdmt-load-" + std::to_string(i) + ".tmp")).string();
+        }
+
+        m_scratch_paths.push_back(path);
+    }
+}
+
+com::github::coderodde::wtpdmt::LoadGenerator::~LoadGenerator() {
+    if (!m_threads.empty()) {
+        m_stop_requested.store(true, std::memory_order_release);
+
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    for (const string& path : m_scratch_paths) {
+        if (!path.empty()) {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+    }
+}
+
+void com::github::coderodde::wtpdmt::LoadGenerator::start() {
+    for (size_t i = 0; i < m_loads.size(); i++) {
+        m_threads.emplace_back([this, i]() {
+            try {
+                runLoad(i);
+            } catch (...) {
+                m_errors[i] = std::current_exception();
+            }
+        });
+    }
+}
+
+void com::github::coderodde::wtpdmt::LoadGenerator::stop() {
+    m_stop_requested.store(true, std::memory_order_release);
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+
+    m_threads.clear();
+
+    for (std::exception_ptr& error : m_errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+const std::vector<LoadSpecification>& com::github::coderodde::wtpdmt::LoadGenerator::getLoads() const {
+    return m_loads;
+}
+
+uint64_t com::github::coderodde::wtpdmt::LoadGenerator::getRoundCount(size_t load_index) const {
+    return m_counters[load_index]->rounds.load(std::memory_order_relaxed);
+}
+
+void com::github::coderodde::wtpdmt::LoadGenerator::runLoad(size_t load_index) {
+    const LoadSpecification& load = m_loads[load_index];
+    std::atomic<uint64_t>& rounds = m_counters[load_index]->rounds;
+    uint64_t* buffer = m_buffers[load_index].get();
+
+    if (load.cpu != UNPINNED_CPU) {
+        util::pinCurrentThreadToCpu(load.cpu);
+    }
+
+    util::setCurrentThreadPriority(load.priority_class, load.thread_priority);
+
+    std::unique_ptr<ScratchFile> scratch_file;
+
+    if (load.kind == LoadKind::DISK) {
+        scratch_file = std::make_unique<ScratchFile>(m_scratch_paths[load_index]);
+    }
+
+    volatile uint64_t spin_counter = 0;
+    uint64_t chase_index = 0;
+
+    while (!m_stop_requested.load(std::memory_order_relaxed)) {
+        switch (load.kind) {
+            case LoadKind::SPIN:
+                for (size_t i = 0; i < SPIN_ITERATIONS_PER_ROUND; i++) {
+                    spin_counter = spin_counter + 1;
+                }
+
+                break;
+
+            case LoadKind::MEMORY:
+                for (size_t i = 0; i < MEMORY_BUFFER_WORDS; i++) {
+                    buffer[i] += i;
+                }
+
+                break;
+
+            case LoadKind::CACHE:
+                for (size_t i = 0; i < CACHE_HOPS_PER_ROUND; i++) {
+                    chase_index = buffer[chase_index];
+                }
+
+                // Keeps the chase from being optimized away:
+                spin_counter = chase_index;
+                break;
+
+            case LoadKind::SYSCALL:
+                // A yield and a short sleep, each a kernel entry and
+                // usually a context switch. Windows rounds the sleep up
+                // to its timer resolution.
+                std::this_thread::yield();
+                std::this_thread::sleep_for(std::chrono::microseconds(1));
+#ifndef _WIN32
+                syscall(SYS_getppid);
+#endif
+                break;
+
+            case LoadKind::DISK:
+                buffer[0] = rounds.load(std::memory_order_relaxed);
+                scratch_file->writeBlock(buffer);
+                break;
+        }
+
+        rounds.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_LOAD_GENERATOR_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_LOAD_GENERATOR_HPP
+
+#include "ThreadControl.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using std::string;
+
+	enum class LoadKind {
+		SPIN,    // Keeps a CPU busy without touching memory
+		MEMORY,  // Streams through a buffer far larger than the caches
+		CACHE,   // Chases pointers in random order, missing cache and TLB
+		SYSCALL, // Enters the kernel and switches context as fast as it can
+		DISK     // Writes and flushes a scratch file
+	};
+
+	// One background thread. On Linux it runs under a policy of its own;
+	// on Windows the class is the process's and only the thread priority
+	// applies.
+	struct LoadSpecification {
+		LoadKind            kind;
+		int                 cpu; // UNPINNED_CPU for none.
+		util::PriorityClass priority_class;
+		int                 thread_priority;
+	};
+
+	string getLoadKindName(LoadKind kind);
+	bool findLoadKind(std::string_view name, LoadKind* kind);
+	std::vector<LoadKind> getLoadKinds();
+
+	// Runs interference on background threads while a measurement runs.
+	// The constructor allocates everything the loads touch; start() and
+	// stop() bracket the measurement.
+	class LoadGenerator {
+	private:
+
+		// Rounds done by one load thread, on a cache line of its own so
+		// that counting does not add false sharing to the load:
+		struct alignas(util::CACHE_LINE_SIZE) LoadCounter {
+			std::atomic<uint64_t> rounds{ 0 };
+		};
+
+		std::vector<LoadSpecification>             m_loads;
+		std::vector<std::unique_ptr<LoadCounter>>  m_counters;
+		std::vector<std::unique_ptr<uint64_t[]>>   m_buffers; // Per load; empty for those without one.
+		std::vector<string>                        m_scratch_paths;
+		std::vector<std::exception_ptr>            m_errors;
+		std::vector<std::thread>                   m_threads;
+		std::atomic<bool>                          m_stop_requested;
+
+	public:
+
+		explicit LoadGenerator(const std::vector<LoadSpecification>& loads);
+		~LoadGenerator();
+
+		LoadGenerator(const LoadGenerator&) = delete;
+		LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+		void start();
+
+		// Joins the load threads and rethrows the first error one of them
+		// ran into.
+		void stop();
+
+		const std::vector<LoadSpecification>& getLoads() const;
+		uint64_t getRoundCount(size_t load_index) const;
+
+	private:
+
+		void runLoad(size_t load_index);
+	};
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_LOAD_GENERATOR_HPP
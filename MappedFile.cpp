@@ -0,0 +1,163 @@
+#include "MappedFile.h"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+
+com::github::coderodde::wtpdmt::util::MappedFile::MappedFile(const string& path) :
+    m_path    { path },
+    m_capacity{ 0 },
+    m_data    { nullptr }
+{
+#ifdef _WIN32
+    m_mapping_handle = nullptr;
+    m_file_handle = CreateFileA(path.c_str(),
+                                GENERIC_READ | GENERIC_WRITE,
+                                FILE_SHARE_READ,
+                                nullptr,
+                                CREATE_ALWAYS,
+                                FILE_ATTRIBUTE_NORMAL,
+                                nullptr);
+
+    if (m_file_handle == INVALID_HANDLE_VALUE) {
+        throwSystemError("create");
+    }
+#else
+    m_file_descriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (m_file_descriptor < 0) {
+        throwSystemError("create");
+    }
+#endif
+}
+
+com::github::coderodde::wtpdmt::util::MappedFile::~MappedFile() {
+    unmap();
+#ifdef _WIN32
+    if (m_file_handle != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file_handle);
+    }
+#else
+    if (m_file_descriptor >= 0) {
+        close(m_file_descriptor);
+    }
+#endif
+}
+
+char* com::github::coderodde::wtpdmt::util::MappedFile::getData() {
+    return m_data;
+}
+
+size_t com::github::coderodde::wtpdmt::util::MappedFile::getCapacity() const {
+    return m_capacity;
+}
+
+void com::github::coderodde::wtpdmt::util::MappedFile::reserve(size_t capacity) {
+    if (capacity <= m_capacity) {
+        return;
+    }
+
+    unmap();
+    map(capacity);
+}
+
+void com::github::coderodde::wtpdmt::util::MappedFile::finish(size_t size) {
+    unmap();
+#ifdef _WIN32
+    LARGE_INTEGER file_size;
+    file_size.QuadPart = static_cast<LONGLONG>(size);
+
+    if (!SetFilePointerEx(m_file_handle, file_size, nullptr, FILE_BEGIN) ||
+        !SetEndOfFile(m_file_handle)) {
+        throwSystemError("truncate");
+    }
+
+    CloseHandle(m_file_handle);
+    m_file_handle = INVALID_HANDLE_VALUE;
+#else
+    if (ftruncate(m_file_descriptor, static_cast<off_t>(size)) != 0) {
+        throwSystemError("truncate");
+    }
+
+    close(m_file_descriptor);
+    m_file_descriptor = -1;
+#endif
+}
+
+void com::github::coderodde::wtpdmt::util::MappedFile::map(size_t capacity) {
+#ifdef _WIN32
+    // Creating a mapping larger than the file extends the file:
+    ULARGE_INTEGER mapping_size;
+    mapping_size.QuadPart = capacity;
+
+    m_mapping_handle = CreateFileMappingA(m_file_handle,
+                                          nullptr,
+                                          PAGE_READWRITE,
+                                          mapping_size.HighPart,
+                                          mapping_size.LowPart,
+                                          nullptr);
+
+    if (m_mapping_handle == nullptr) {
+        throwSystemError("map");
+    }
+
+    m_data = static_cast<char*>(MapViewOfFile(m_mapping_handle, FILE_MAP_WRITE, 0, 0, capacity));
+
+    if (m_data == nullptr) {
+        throwSystemError("map");
+    }
+#else
+    if (ftruncate(m_file_descriptor, static_cast<off_t>(capacity)) != 0) {
+        throwSystemError("extend");
+    }
+
+    void* data = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_file_descriptor, 0);
+
+    if (data == MAP_FAILED) {
+        throwSystemError("map");
+    }
+
+    m_data = static_cast<char*>(data);
+#endif
+    m_capacity = capacity;
+}
+
+void com::github::coderodde::wtpdmt::util::MappedFile::unmap() {
+#ifdef _WIN32
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+
+    if (m_mapping_handle != nullptr) {
+        CloseHandle(m_mapping_handle);
+        m_mapping_handle = nullptr;
+    }
+#else
+    if (m_data != nullptr) {
+        munmap(m_data, m_capacity);
+    }
+#endif
+    m_data = nullptr;
+    m_capacity = 0;
+}
+
+void com::github::coderodde::wtpdmt::util::MappedFile::throwSystemError(const string& operation) {
+    std::stringstream ss;
+    ss << "Could not " << operation << " the file '" << m_path << "', error code "
+#ifdef _WIN32
+       << GetLastError()
+#else
+       << errno
+#endif
+       << ".";
+
+    throw std::runtime_error{ ss.str() };
+}
@@ -0,0 +1,51 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_MAPPED_FILE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	using std::string;
+
+	// A file written through a shared memory mapping. The mapping grows in
+	// whole chunks on demand; finish() trims the file to the bytes that were
+	// actually used.
+	class MappedFile {
+	private:
+
+		string m_path;
+		size_t m_capacity;
+		char*  m_data;
+#ifdef _WIN32
+		HANDLE m_file_handle;
+		HANDLE m_mapping_handle;
+#else
+		int    m_file_descriptor;
+#endif
+
+	public:
+
+		explicit MappedFile(const string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		char* getData();
+		size_t getCapacity() const;
+		void reserve(size_t capacity);
+		void finish(size_t size);
+
+	private:
+
+		void map(size_t capacity);
+		void unmap();
+		void throwSystemError(const string& operation);
+	};
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_MAPPED_FILE_HPP
@@ -0,0 +1,135 @@
+#include "MappedFileView.h"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+
+com::github::coderodde::wtpdmt::util::MappedFileView::MappedFileView(const string& path) :
+    m_path{ path },
+    m_size{ 0 },
+    m_data{ nullptr }
+{
+#ifdef _WIN32
+    m_mapping_handle = nullptr;
+    m_file_handle = CreateFileA(path.c_str(),
+                                GENERIC_READ,
+                                FILE_SHARE_READ,
+                                nullptr,
+                                OPEN_EXISTING,
+                                FILE_FLAG_SEQUENTIAL_SCAN,
+                                nullptr);
+
+    if (m_file_handle == INVALID_HANDLE_VALUE) {
+        throwSystemError("open");
+    }
+
+    LARGE_INTEGER file_size;
+
+    if (!GetFileSizeEx(m_file_handle, &file_size)) {
+        CloseHandle(m_file_handle);
+        throwSystemError("size");
+    }
+
+    m_size = static_cast<size_t>(file_size.QuadPart);
+
+    // An empty file cannot be mapped:
+    if (m_size == 0) {
+        return;
+    }
+
+    m_mapping_handle = CreateFileMappingA(m_file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (m_mapping_handle == nullptr) {
+        CloseHandle(m_file_handle);
+        throwSystemError("map");
+    }
+
+    m_data = static_cast<const char*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+
+    if (m_data == nullptr) {
+        CloseHandle(m_mapping_handle);
+        CloseHandle(m_file_handle);
+        throwSystemError("map");
+    }
+#else
+    m_file_descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (m_file_descriptor < 0) {
+        throwSystemError("open");
+    }
+
+    struct stat file_status;
+
+    if (fstat(m_file_descriptor, &file_status) != 0) {
+        close(m_file_descriptor);
+        throwSystemError("size");
+    }
+
+    m_size = static_cast<size_t>(file_status.st_size);
+
+    if (m_size == 0) {
+        return;
+    }
+
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_file_descriptor, 0);
+
+    if (data == MAP_FAILED) {
+        close(m_file_descriptor);
+        throwSystemError("map");
+    }
+
+    // Only a hint; reading works without it:
+    madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(data);
+#endif
+}
+
+com::github::coderodde::wtpdmt::util::MappedFileView::~MappedFileView() {
+#ifdef _WIN32
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+
+    if (m_mapping_handle != nullptr) {
+        CloseHandle(m_mapping_handle);
+    }
+
+    CloseHandle(m_file_handle);
+#else
+    if (m_data != nullptr) {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+
+    close(m_file_descriptor);
+#endif
+}
+
+const char* com::github::coderodde::wtpdmt::util::MappedFileView::getData() const {
+    return m_data;
+}
+
+size_t com::github::coderodde::wtpdmt::util::MappedFileView::getSize() const {
+    return m_size;
+}
+
+void com::github::coderodde::wtpdmt::util::MappedFileView::throwSystemError(const string& operation) {
+    std::stringstream ss;
+    ss << "Could not " << operation << " the file '" << m_path << "', error code "
+#ifdef _WIN32
+       << GetLastError()
+#else
+       << errno
+#endif
+       << ".";
+
+    throw std::runtime_error{ ss.str() };
+}
@@ -0,0 +1,47 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_MAPPED_FILE_VIEW_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_MAPPED_FILE_VIEW_HPP
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	using std::string;
+
+	// A whole file mapped read-only, for reading files of many gigabytes
+	// without copying them. The system is told that the file will be read
+	// sequentially, so that it reads ahead.
+	class MappedFileView {
+	private:
+
+		string      m_path;
+		size_t      m_size;
+		const char* m_data;
+#ifdef _WIN32
+		HANDLE      m_file_handle;
+		HANDLE      m_mapping_handle;
+#else
+		int         m_file_descriptor;
+#endif
+
+	public:
+
+		explicit MappedFileView(const string& path);
+		~MappedFileView();
+
+		MappedFileView(const MappedFileView&) = delete;
+		MappedFileView& operator=(const MappedFileView&) = delete;
+
+		const char* getData() const;
+		size_t getSize() const;
+
+	private:
+
+		void throwSystemError(const string& operation);
+	};
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_MAPPED_FILE_VIEW_HPP
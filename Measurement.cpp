@@ -0,0 +1,188 @@
+#include "Measurement.h"
+#include "LiveReporter.h"
+#include <exception>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using com::github::coderodde::wtpdmt::AttributingRecorder;
+using com::github::coderodde::wtpdmt::GapAttributor;
+using com::github::coderodde::wtpdmt::MeasurementConfiguration;
+using com::github::coderodde::wtpdmt::PowerCounterSource;
+using com::github::coderodde::wtpdmt::PowerStateRecorder;
+using com::github::coderodde::wtpdmt::PowerStateSampler;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+
+// Runs the gap loop with 'recorder', wrapped so that the power state
+// around long gaps gets sampled if asked for.
+template<class Reader, class Recorder>
+static void RunPowerSampledGapLoop(const MeasurementConfiguration& configuration,
+                                   ThreadStatistics& thread_statistics,
+                                   Recorder& recorder) {
+    if (configuration.power_counter_source == PowerCounterSource::NONE) {
+        com::github::coderodde::wtpdmt::runGapLoop<Reader>(configuration.iterations, recorder);
+        return;
+    }
+
+    PowerStateSampler sampler(configuration.power_counter_source, configuration.nanoseconds_per_tick);
+    PowerStateRecorder<Recorder> power_state_recorder{ recorder,
+                                                       sampler,
+                                                       configuration.power_threshold_ticks };
+    sampler.start();
+    com::github::coderodde::wtpdmt::runGapLoop<Reader>(configuration.iterations, power_state_recorder);
+    thread_statistics.power_states = sampler.getStatistics();
+}
+
+// As above, and also wrapped so that long gaps get attributed if asked
+// for.
+template<class Reader, class Recorder>
+static void RunGapLoop(const MeasurementConfiguration& configuration,
+                       ThreadStatistics& thread_statistics,
+                       Recorder& recorder) {
+    if (!configuration.attribute_gaps) {
+        RunPowerSampledGapLoop<Reader>(configuration, thread_statistics, recorder);
+        return;
+    }
+
+    GapAttributor attributor(configuration.nanoseconds_per_tick);
+    AttributingRecorder<Recorder> attributing_recorder{ recorder,
+                                                        attributor,
+                                                        configuration.attribution_threshold_ticks };
+    attributor.start();
+    RunPowerSampledGapLoop<Reader>(configuration, thread_statistics, attributing_recorder);
+    thread_statistics.gap_attribution = attributor.getStatistics();
+}
+
+std::vector<std::unique_ptr<ThreadStatistics>>
+com::github::coderodde::wtpdmt::runOnThreads(const std::vector<int>& cpus,
+                                             int thread_priority,
+                                             const std::function<void(size_t, ThreadStatistics&)>& body) {
+    return runOnThreads(cpus, std::vector<int>(cpus.size(), thread_priority), body);
+}
+
+std::vector<std::unique_ptr<ThreadStatistics>>
+com::github::coderodde::wtpdmt::runOnThreads(const std::vector<int>& cpus,
+                                             const std::vector<int>& thread_priorities,
+                                             const std::function<void(size_t, ThreadStatistics&)>& body) {
+    size_t thread_count = cpus.size();
+    std::vector<std::unique_ptr<ThreadStatistics>> statistics;
+
+    for (size_t i = 0; i < thread_count; i++) {
+        std::unique_ptr<ThreadStatistics> thread_statistics = std::make_unique<ThreadStatistics>();
+        thread_statistics->requested_cpu             = cpus[i];
+        thread_statistics->first_cpu                 = UNPINNED_CPU;
+        thread_statistics->last_cpu                  = UNPINNED_CPU;
+        thread_statistics->effective_thread_priority = thread_priorities[i];
+        thread_statistics->effective_priority_class  = 0;
+        thread_statistics->dropped_trace_events      = 0;
+        thread_statistics->early_wakeups             = 0;
+        thread_statistics->loop_calibration          = LoopCalibration{ 0.0, 0 };
+        thread_statistics->gap_attribution           = GapAttributionStatistics{};
+        thread_statistics->power_states              = PowerStateStatistics{};
+        statistics.push_back(std::move(thread_statistics));
+    }
+
+    // The barrier blocks rather than spins: on a busy CPU a spinning
+    // real-time thread would starve the lower-priority thread that has to
+    // release it.
+    std::latch ready_latch{ static_cast<std::ptrdiff_t>(thread_count) };
+    std::latch start_latch{ 1 };
+    std::vector<std::exception_ptr> errors(thread_count);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < thread_count; i++) {
+        threads.emplace_back([&, i]() {
+            ThreadStatistics& thread_statistics = *statistics[i];
+
+            try {
+                if (thread_statistics.requested_cpu != UNPINNED_CPU) {
+                    util::pinCurrentThreadToCpu(thread_statistics.requested_cpu);
+                }
+
+                util::setCurrentThreadPriority(thread_priorities[i]);
+                thread_statistics.effective_thread_priority = util::getCurrentThreadPriority();
+                thread_statistics.effective_priority_class  = util::getCurrentThreadPriorityClass();
+
+                if (util::getMemoryPolicy().prefault) {
+                    util::prefaultCurrentStack();
+                }
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+
+            ready_latch.count_down();
+
+            if (errors[i]) {
+                return;
+            }
+
+            // Start all threads at once so that their samples cover the
+            // same period of time:
+            start_latch.wait();
+
+            thread_statistics.first_cpu = util::getCurrentCpu();
+
+            try {
+                body(i, thread_statistics);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+
+            thread_statistics.last_cpu = util::getCurrentCpu();
+        });
+    }
+
+    ready_latch.wait();
+    start_latch.count_down();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    return statistics;
+}
+
+std::vector<std::unique_ptr<ThreadStatistics>>
+com::github::coderodde::wtpdmt::runMeasurement(const MeasurementConfiguration& configuration) {
+    return runOnThreads(configuration.cpus,
+                        configuration.thread_priority,
+                        [&configuration](size_t thread_index, ThreadStatistics& thread_statistics) {
+        util::Clock::dispatch(configuration.clock_source, [&](auto reader) {
+            using Reader = decltype(reader);
+
+            thread_statistics.loop_calibration = calibrateGapLoop<Reader>();
+
+            TraceWriter* trace_writer = configuration.trace_writer;
+            LiveReporter* live_reporter = configuration.live_reporter;
+
+            // Pick the recorder once; the loop is compiled for each:
+            if (live_reporter != nullptr && trace_writer != nullptr) {
+                LiveTracingRecorder recorder{ LiveRecorder{ live_reporter->getChannel(thread_index) },
+                                              trace_writer->getRing(thread_index),
+                                              trace_writer->getThresholdTicks(),
+                                              thread_statistics.dropped_trace_events };
+                RunGapLoop<Reader>(configuration, thread_statistics, recorder);
+            } else if (live_reporter != nullptr) {
+                LiveRecorder recorder{ live_reporter->getChannel(thread_index) };
+                RunGapLoop<Reader>(configuration, thread_statistics, recorder);
+            } else if (trace_writer != nullptr) {
+                TracingRecorder recorder{ thread_statistics.histogram,
+                                          trace_writer->getRing(thread_index),
+                                          trace_writer->getThresholdTicks(),
+                                          thread_statistics.dropped_trace_events };
+                RunGapLoop<Reader>(configuration, thread_statistics, recorder);
+            } else {
+                HistogramRecorder recorder{ thread_statistics.histogram };
+                RunGapLoop<Reader>(configuration, thread_statistics, recorder);
+            }
+        });
+    });
+}
@@ -0,0 +1,287 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_MEASUREMENT_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_MEASUREMENT_HPP
+
+#include "Clock.h"
+#include "GapAttribution.h"
+#include "Histogram.h"
+#include "LiveChannel.h"
+#include "MemoryControl.h"
+#include "PowerStates.h"
+#include "SpscRing.h"
+#include "ThreadControl.h"
+#include "TraceWriter.h"
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using util::ClockSource;
+	using util::Histogram;
+
+	constexpr int UNPINNED_CPU = -1;
+
+	class LiveReporter;
+
+	// What the measuring loop itself costs. Every gap it reports is at
+	// least 'minimum_gap_ticks', and about 'iteration_ticks' of each gap is
+	// the loop rather than the system.
+	struct LoopCalibration {
+		double   iteration_ticks;
+		uint64_t minimum_gap_ticks;
+	};
+
+	// Everything a measuring thread writes during a run. Each instance is
+	// allocated on its own pages, so the threads share no writable memory
+	// until the results are merged, and the pages follow the memory policy.
+	struct alignas(util::CACHE_LINE_SIZE) ThreadStatistics {
+		static void* operator new(size_t size) {
+			return util::allocateMeasurementMemory(size);
+		}
+
+		static void operator delete(void* data, size_t size) {
+			util::freeMeasurementMemory(data, size);
+		}
+
+		Histogram           histogram;
+		int                 requested_cpu;
+		int                 first_cpu;
+		int                 last_cpu;
+		int                 effective_thread_priority;
+		util::PriorityClass effective_priority_class;
+		uint64_t            dropped_trace_events;
+		uint64_t            early_wakeups;
+		LoopCalibration     loop_calibration; // Zero unless the gaps mode calibrated it.
+		GapAttributionStatistics gap_attribution;
+		PowerStateStatistics     power_states;
+	};
+
+	struct MeasurementConfiguration {
+		ClockSource        clock_source;
+		size_t             iterations;
+		int                thread_priority;
+		std::vector<int>   cpus; // One measuring thread per entry.
+		TraceWriter*       trace_writer;  // Null unless gaps are traced.
+		LiveReporter*      live_reporter; // Null unless reported while running.
+		bool               attribute_gaps;
+		uint64_t           attribution_threshold_ticks; // Used only if gaps are attributed.
+		PowerCounterSource power_counter_source;        // NONE unless power states are sampled.
+		uint64_t           power_threshold_ticks;       // Used only if power states are sampled.
+		double             nanoseconds_per_tick;        // Used only if either of the above is on.
+	};
+
+	// Runs 'body' on one thread per entry of 'cpus', pinned to that CPU
+	// (unless it is UNPINNED_CPU) and at 'thread_priority'. The threads are
+	// released together once all of them are set up.
+	std::vector<std::unique_ptr<ThreadStatistics>>
+	runOnThreads(const std::vector<int>& cpus,
+				 int thread_priority,
+				 const std::function<void(size_t, ThreadStatistics&)>& body);
+
+	// As above, but thread i runs at 'thread_priorities[i]'.
+	std::vector<std::unique_ptr<ThreadStatistics>>
+	runOnThreads(const std::vector<int>& cpus,
+				 const std::vector<int>& thread_priorities,
+				 const std::function<void(size_t, ThreadStatistics&)>& body);
+
+	std::vector<std::unique_ptr<ThreadStatistics>>
+	runMeasurement(const MeasurementConfiguration& configuration);
+
+	enum class GapLoopAction {
+		CONTINUE,
+		RESTART, // The recorder took its time; the next gap starts after it.
+		STOP
+	};
+
+	// Recorder policies for runGapLoop(). record() takes a gap and the
+	// reading that closed it and tells the loop how to go on; finish()
+	// runs once the loop is over. Each policy is a separate
+	// type, so the loop is compiled once per clock source and policy and
+	// the per-sample path holds no virtual call and no branch on the
+	// configuration.
+
+	struct HistogramRecorder {
+		Histogram& histogram;
+
+		GapLoopAction record(uint64_t gap, uint64_t) {
+			histogram.record(gap);
+			return GapLoopAction::CONTINUE;
+		}
+
+		void finish() {}
+	};
+
+	// Also hands every gap of at least 'threshold_ticks' to the trace
+	// ring. A full ring drops the event rather than stall the measurement.
+	struct TracingRecorder {
+		Histogram&                histogram;
+		util::SpscRing<GapEvent>& ring;
+		uint64_t                  threshold_ticks;
+		uint64_t&                 dropped_events;
+
+		GapLoopAction record(uint64_t gap, uint64_t end_ticks) {
+			histogram.record(gap);
+
+			if (gap >= threshold_ticks && !ring.tryPush(GapEvent{ end_ticks, gap })) {
+				dropped_events++;
+			}
+
+			return GapLoopAction::CONTINUE;
+		}
+
+		void finish() {}
+	};
+
+	// Records into 'channel' so that a reader can take the histogram of
+	// each interval while the loop runs, and ends the loop once the reader
+	// asks it to stop.
+	struct LiveRecorder {
+		util::LiveChannel& channel;
+		uint32_t           generation = 0;
+		Histogram*         histogram  = &channel.getBuffer(0);
+
+		GapLoopAction record(uint64_t gap, uint64_t) {
+			histogram->record(gap);
+
+			if (channel.swapRequested(generation)) {
+				generation = channel.acknowledgeSwap();
+				histogram = &channel.getBuffer(generation);
+
+				if (util::LiveChannel::isStopGeneration(generation)) {
+					return GapLoopAction::STOP;
+				}
+			}
+
+			return GapLoopAction::CONTINUE;
+		}
+
+		void finish() {
+			channel.finish();
+		}
+	};
+
+	// LiveRecorder plus the trace ring of TracingRecorder.
+	struct LiveTracingRecorder {
+		LiveRecorder              live;
+		util::SpscRing<GapEvent>& ring;
+		uint64_t                  threshold_ticks;
+		uint64_t&                 dropped_events;
+
+		GapLoopAction record(uint64_t gap, uint64_t end_ticks) {
+			if (gap >= threshold_ticks && !ring.tryPush(GapEvent{ end_ticks, gap })) {
+				dropped_events++;
+			}
+
+			return live.record(gap, end_ticks);
+		}
+
+		void finish() {
+			live.finish();
+		}
+	};
+
+	// Wraps another recorder and attributes every gap of at least
+	// 'threshold_ticks' to a cause. Shorter gaps cost one compare.
+	template<class Inner>
+	struct AttributingRecorder {
+		Inner&         inner;
+		GapAttributor& attributor;
+		uint64_t       threshold_ticks;
+
+		GapLoopAction record(uint64_t gap, uint64_t end_ticks) {
+			GapLoopAction action = inner.record(gap, end_ticks);
+
+			if (gap >= threshold_ticks && action != GapLoopAction::STOP) {
+				attributor.attribute(gap);
+				return GapLoopAction::RESTART;
+			}
+
+			return action;
+		}
+
+		void finish() {
+			inner.finish();
+		}
+	};
+
+	// The same for the power state around every gap of at least
+	// 'threshold_ticks'.
+	template<class Inner>
+	struct PowerStateRecorder {
+		Inner&             inner;
+		PowerStateSampler& sampler;
+		uint64_t           threshold_ticks;
+
+		GapLoopAction record(uint64_t gap, uint64_t end_ticks) {
+			GapLoopAction action = inner.record(gap, end_ticks);
+
+			if (gap >= threshold_ticks && action != GapLoopAction::STOP) {
+				sampler.attribute(gap);
+				return GapLoopAction::RESTART;
+			}
+
+			return action;
+		}
+
+		void finish() {
+			inner.finish();
+		}
+	};
+
+	template<class Reader, class Recorder>
+	void runGapLoop(size_t iterations, Recorder& recorder) {
+		uint64_t ta = Reader::read();
+
+		for (size_t i = 0; i < iterations; i++) {
+			uint64_t tb = Reader::read();
+			GapLoopAction action = recorder.record(tb - ta, tb);
+
+			if (action != GapLoopAction::CONTINUE) {
+				if (action == GapLoopAction::STOP) {
+					break;
+				}
+
+				tb = Reader::read();
+			}
+
+			ta = tb;
+		}
+
+		recorder.finish();
+	}
+
+	template<class Reader>
+	void measureGaps(size_t iterations, Histogram& histogram) {
+		HistogramRecorder recorder{ histogram };
+		runGapLoop<Reader>(iterations, recorder);
+	}
+
+	constexpr size_t LOOP_CALIBRATION_BATCHES          = 200;
+	constexpr size_t LOOP_CALIBRATION_BATCH_ITERATIONS = 1000;
+
+	// Runs short batches of the plain loop and keeps the cheapest one, which
+	// is the one no interrupt or preemption hit. The tracing and live
+	// recorders add a compare or a load per sample on top of it.
+	template<class Reader>
+	LoopCalibration calibrateGapLoop() {
+		std::unique_ptr<Histogram> histogram = std::make_unique<Histogram>();
+		double cheapest_batch_ticks = (std::numeric_limits<double>::max)();
+
+		for (size_t batch = 0; batch < LOOP_CALIBRATION_BATCHES; batch++) {
+			uint64_t start_ticks = Reader::read();
+			measureGaps<Reader>(LOOP_CALIBRATION_BATCH_ITERATIONS, *histogram);
+			uint64_t end_ticks = Reader::read();
+
+			cheapest_batch_ticks = (std::min)(cheapest_batch_ticks, static_cast<double>(end_ticks - start_ticks));
+		}
+
+		LoopCalibration calibration;
+		calibration.iteration_ticks   = cheapest_batch_ticks / static_cast<double>(LOOP_CALIBRATION_BATCH_ITERATIONS);
+		calibration.minimum_gap_ticks = histogram->getMinimum();
+		return calibration;
+	}
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_MEASUREMENT_HPP
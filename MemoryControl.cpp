@@ -0,0 +1,236 @@
+#include "MemoryControl.h"
+#include "SystemError.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::util::MemoryPolicy;
+using com::github::coderodde::wtpdmt::util::throwSystemError;
+
+// How much of each measuring thread's stack prefaultCurrentStack() touches:
+static const size_t STACK_PREFAULT_SIZE = 256 * 1024;
+
+#ifdef _WIN32
+// What a locked process may keep resident beyond its usual working set:
+static const SIZE_T WORKING_SET_RESERVE = 256 * 1024 * 1024;
+#endif
+
+static MemoryPolicy memory_policy{ false, false, false };
+static size_t large_page_size = 0;
+static std::atomic<uint64_t> allocation_count{ 0 };
+static std::atomic<uint64_t> large_page_allocation_count{ 0 };
+
+static size_t RoundUp(size_t size, size_t granularity) {
+    return (size + granularity - 1) / granularity * granularity;
+}
+
+// Allocations are rounded to whole (large) pages so that
+// freeMeasurementMemory() can recompute the size of the mapping:
+static size_t GetMappingSize(size_t size) {
+    return RoundUp(size, memory_policy.large_pages && large_page_size != 0
+                         ? large_page_size
+                         : com::github::coderodde::wtpdmt::util::getPageSize());
+}
+
+static void PrefaultRange(void* data, size_t size) {
+    volatile unsigned char* bytes = static_cast<volatile unsigned char*>(data);
+    size_t page_size = com::github::coderodde::wtpdmt::util::getPageSize();
+
+    for (size_t offset = 0; offset < size; offset += page_size) {
+        bytes[offset] = 0;
+    }
+}
+
+#ifdef _WIN32
+// Large pages need SeLockMemoryPrivilege, which is granted to the account
+// by policy but has to be enabled in the token:
+static bool EnableLockMemoryPrivilege() {
+    HANDLE token_handle;
+
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token_handle)) {
+        return false;
+    }
+
+    TOKEN_PRIVILEGES privileges{};
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+    bool enabled = LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid)
+                && AdjustTokenPrivileges(token_handle, FALSE, &privileges, 0, nullptr, nullptr)
+                && GetLastError() != ERROR_NOT_ALL_ASSIGNED;
+
+    CloseHandle(token_handle);
+    return enabled;
+}
+#else
+static size_t ReadHugePageSize() {
+    std::ifstream meminfo("/proc/meminfo");
+    string key;
+
+    while (meminfo >> key) {
+        if (key == "Hugepagesize:") {
+            size_t kilobytes;
+            meminfo >> kilobytes;
+            return kilobytes * 1024;
+        }
+
+        meminfo.ignore(256, '\n');
+    }
+
+    return 0;
+}
+#endif
+
+void com::github::coderodde::wtpdmt::util::applyMemoryPolicy(const MemoryPolicy& policy) {
+    memory_policy = policy;
+
+#ifdef _WIN32
+    if (policy.lock_memory) {
+        // VirtualLock() cannot lock more than the minimum working set:
+        SIZE_T minimum_working_set;
+        SIZE_T maximum_working_set;
+
+        if (!GetProcessWorkingSetSize(GetCurrentProcess(), &minimum_working_set, &maximum_working_set) ||
+            !SetProcessWorkingSetSize(GetCurrentProcess(),
+                                      minimum_working_set + WORKING_SET_RESERVE,
+                                      maximum_working_set + WORKING_SET_RESERVE)) {
+            throwSystemError("enlarge the working set");
+        }
+    }
+
+    if (policy.large_pages && EnableLockMemoryPrivilege()) {
+        large_page_size = GetLargePageMinimum();
+    }
+#else
+    if (policy.lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        throwSystemError("lock the memory (check RLIMIT_MEMLOCK or CAP_IPC_LOCK)");
+    }
+
+    if (policy.large_pages) {
+        large_page_size = ReadHugePageSize();
+    }
+#endif
+}
+
+const MemoryPolicy& com::github::coderodde::wtpdmt::util::getMemoryPolicy() {
+    return memory_policy;
+}
+
+size_t com::github::coderodde::wtpdmt::util::getPageSize() {
+#ifdef _WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return static_cast<size_t>(system_info.dwPageSize);
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+size_t com::github::coderodde::wtpdmt::util::getLargePageSize() {
+    return large_page_size;
+}
+
+void* com::github::coderodde::wtpdmt::util::allocateMeasurementMemory(size_t size) {
+    size_t mapping_size = GetMappingSize(size);
+    bool large_pages = memory_policy.large_pages && large_page_size != 0;
+    void* data = nullptr;
+
+#ifdef _WIN32
+    // Large pages are always locked:
+    if (large_pages) {
+        data = VirtualAlloc(nullptr, mapping_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+    }
+
+    if (data == nullptr) {
+        large_pages = false;
+        data = VirtualAlloc(nullptr, mapping_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+        if (data == nullptr) {
+            throwSystemError("allocate measurement memory");
+        }
+
+        if (memory_policy.lock_memory && !VirtualLock(data, mapping_size)) {
+            throwSystemError("lock measurement memory");
+        }
+    }
+#else
+    if (large_pages) {
+        data = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        data = data == MAP_FAILED ? nullptr : data;
+    }
+
+    if (data == nullptr) {
+        data = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (data == MAP_FAILED) {
+            throwSystemError("allocate measurement memory");
+        }
+
+        // Without reserved huge pages, ask for transparent ones:
+        if (large_pages) {
+            large_pages = madvise(data, mapping_size, MADV_HUGEPAGE) == 0;
+        }
+    }
+#endif
+
+    if (memory_policy.prefault || memory_policy.lock_memory) {
+        PrefaultRange(data, mapping_size);
+    }
+
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (large_pages) {
+        large_page_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return data;
+}
+
+void com::github::coderodde::wtpdmt::util::freeMeasurementMemory(void* data, size_t size) {
+    if (data == nullptr) {
+        return;
+    }
+
+#ifdef _WIN32
+    (void) size;
+    VirtualFree(data, 0, MEM_RELEASE);
+#else
+    munmap(data, GetMappingSize(size));
+#endif
+}
+
+com::github::coderodde::wtpdmt::util::MeasurementMemoryStatistics
+com::github::coderodde::wtpdmt::util::getMeasurementMemoryStatistics() {
+    return MeasurementMemoryStatistics{ allocation_count.load(), large_page_allocation_count.load() };
+}
+
+void com::github::coderodde::wtpdmt::util::prefaultCurrentStack() {
+    unsigned char stack[STACK_PREFAULT_SIZE];
+    PrefaultRange(stack, STACK_PREFAULT_SIZE);
+}
+
+com::github::coderodde::wtpdmt::util::PageFaultCounts com::github::coderodde::wtpdmt::util::getPageFaultCounts() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return PageFaultCounts{ counters.PageFaultCount, 0 };
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return PageFaultCounts{ static_cast<uint64_t>(usage.ru_minflt),
+                            static_cast<uint64_t>(usage.ru_majflt) };
+#endif
+}
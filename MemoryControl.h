@@ -0,0 +1,53 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_MEMORY_CONTROL_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_MEMORY_CONTROL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	struct MemoryPolicy {
+		bool lock_memory; // mlockall() / a larger working set plus VirtualLock()
+		bool prefault;    // Touch measurement memory and thread stacks up front
+		bool large_pages; // Back measurement memory with huge/large pages
+	};
+
+	// Windows counts all page faults together and reports them as minor.
+#ifdef _WIN32
+	constexpr bool MAJOR_PAGE_FAULTS_AVAILABLE = false;
+#else
+	constexpr bool MAJOR_PAGE_FAULTS_AVAILABLE = true;
+#endif
+
+	struct PageFaultCounts {
+		uint64_t minor_faults;
+		uint64_t major_faults;
+	};
+
+	struct MeasurementMemoryStatistics {
+		uint64_t allocations;
+		uint64_t large_page_allocations;
+	};
+
+	// Applies 'policy' to the process and to every later call of
+	// allocateMeasurementMemory(). Call it once, before measuring.
+	void applyMemoryPolicy(const MemoryPolicy& policy);
+	const MemoryPolicy& getMemoryPolicy();
+
+	size_t getPageSize();
+	size_t getLargePageSize(); // 0 if the system has no large pages.
+
+	// Page-aligned memory for buffers that measuring threads write to:
+	// prefaulted, locked and backed by large pages as the memory policy
+	// asks and the system allows.
+	void* allocateMeasurementMemory(size_t size);
+	void freeMeasurementMemory(void* data, size_t size);
+	MeasurementMemoryStatistics getMeasurementMemoryStatistics();
+
+	// Touches the top of the calling thread's stack so that the
+	// measurement loop does not fault in stack pages.
+	void prefaultCurrentStack();
+
+	PageFaultCounts getPageFaultCounts();
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_MEMORY_CONTROL_HPP
@@ -0,0 +1,207 @@
+#include "PeriodicMode.h"
+#include "Measurement.h"
+#include "Report.h"
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::PeriodicTask;
+using com::github::coderodde::wtpdmt::PeriodicTaskStatistics;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+using com::github::coderodde::wtpdmt::WakeupTimer;
+using com::github::coderodde::wtpdmt::util::Histogram;
+
+static const int SUMMARY_COLUMN_WIDTH = 12;
+
+static void RecordRelease(uint64_t latency_ticks,
+                          uint64_t deadline_ticks,
+                          uint64_t& current_miss_run,
+                          PeriodicTaskStatistics& task_statistics) {
+    task_statistics.releases++;
+    task_statistics.corrected_histogram.record(latency_ticks);
+
+    if (latency_ticks > deadline_ticks) {
+        task_statistics.deadline_misses++;
+        current_miss_run++;
+
+        if (current_miss_run > task_statistics.longest_miss_run) {
+            task_statistics.longest_miss_run = current_miss_run;
+        }
+    } else {
+        current_miss_run = 0;
+    }
+}
+
+template<class Reader>
+static void RunPeriodicTask(WakeupTimer& timer,
+                            size_t iterations,
+                            uint64_t period_ticks,
+                            uint64_t deadline_ticks,
+                            double nanoseconds_per_tick,
+                            ThreadStatistics& thread_statistics,
+                            PeriodicTaskStatistics& task_statistics) {
+    uint64_t release = Reader::read() + period_ticks;
+    uint64_t previous_latency = 0;
+    uint64_t current_miss_run = 0;
+
+    while (task_statistics.releases < iterations) {
+        uint64_t now = Reader::read();
+
+        // Wait for the absolute release time; a wait that ends early
+        // just waits again for the remainder:
+        while (now < release) {
+            timer.wait(static_cast<uint64_t>(static_cast<double>(release - now) * nanoseconds_per_tick));
+            now = Reader::read();
+        }
+
+        uint64_t latency = now - release;
+        thread_statistics.histogram.record(latency);
+
+        if (task_statistics.releases > 0) {
+            task_statistics.jitter_histogram.record(latency > previous_latency
+                                                    ? latency - previous_latency
+                                                    : previous_latency - latency);
+        }
+
+        previous_latency = latency;
+        RecordRelease(latency, deadline_ticks, current_miss_run, task_statistics);
+
+        // Releases that passed while the task was late are skipped rather
+        // than run back to back, but each counts with the latency it
+        // would have had:
+        release += period_ticks;
+
+        while (release < now && task_statistics.releases < iterations) {
+            task_statistics.skipped_releases++;
+            RecordRelease(now - release, deadline_ticks, current_miss_run, task_statistics);
+            release += period_ticks;
+        }
+    }
+}
+
+static std::vector<int> GetTaskCpus(const std::vector<int>& cpus, size_t task_count) {
+    if (cpus.size() == task_count) {
+        return cpus;
+    }
+
+    if (cpus.size() == 1) {
+        // All tasks compete for the same CPU (or none is pinned):
+        return std::vector<int>(task_count, cpus[0]);
+    }
+
+    std::stringstream ss;
+    ss << "Got " << cpus.size() << " CPUs for " << task_count
+       << " periodic tasks; give either one CPU per task or a single CPU.";
+
+    throw std::logic_error{ ss.str() };
+}
+
+static void PrintSummaryTable(const std::vector<std::unique_ptr<PeriodicTaskStatistics>>& task_statistics) {
+    std::cout << std::right
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "Task"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "Releases"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "Skipped"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "Misses"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "Miss %"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "LongestRun"
+              << "\n";
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    for (size_t i = 0; i < task_statistics.size(); i++) {
+        const PeriodicTaskStatistics& statistics = *task_statistics[i];
+        double miss_percentage = statistics.releases == 0
+                               ? 0.0
+                               : 100.0 * static_cast<double>(statistics.deadline_misses)
+                                       / static_cast<double>(statistics.releases);
+
+        std::cout << std::setw(SUMMARY_COLUMN_WIDTH) << i
+                  << std::setw(SUMMARY_COLUMN_WIDTH) << statistics.releases
+                  << std::setw(SUMMARY_COLUMN_WIDTH) << statistics.skipped_releases
+                  << std::setw(SUMMARY_COLUMN_WIDTH) << statistics.deadline_misses
+                  << std::setw(SUMMARY_COLUMN_WIDTH) << miss_percentage
+                  << std::setw(SUMMARY_COLUMN_WIDTH) << statistics.longest_miss_run
+                  << "\n";
+    }
+
+    std::cout << std::defaultfloat << "\n";
+}
+
+void com::github::coderodde::wtpdmt::runPeriodicMode(const PeriodicConfiguration& configuration,
+                                                     const util::Clock& clock) {
+    const std::vector<PeriodicTask>& tasks = configuration.tasks;
+    std::vector<int> cpus = GetTaskCpus(configuration.cpus, tasks.size());
+    std::vector<int> thread_priorities;
+    std::vector<std::unique_ptr<PeriodicTaskStatistics>> task_statistics;
+
+    for (size_t i = 0; i < tasks.size(); i++) {
+        thread_priorities.push_back(tasks[i].thread_priority);
+        task_statistics.push_back(std::make_unique<PeriodicTaskStatistics>());
+
+        std::cout << "INFO: Task " << i
+                  << " has a period of " << tasks[i].period_nanoseconds
+                  << " ns, a deadline of " << tasks[i].deadline_nanoseconds
+                  << " ns and thread priority " << tasks[i].thread_priority;
+
+        if (cpus[i] != UNPINNED_CPU) {
+            std::cout << " on CPU " << cpus[i];
+        }
+
+        std::cout << ".\n";
+    }
+
+    std::cout << "INFO: Waiting with " << getWakeupMechanismName(configuration.mechanism)
+              << " for " << configuration.iterations << " releases per task.\n\n";
+
+    std::vector<std::unique_ptr<ThreadStatistics>> statistics =
+        runOnThreads(cpus,
+                     thread_priorities,
+                     [&](size_t thread_index, ThreadStatistics& thread_statistics) {
+        const PeriodicTask& task = tasks[thread_index];
+        std::unique_ptr<WakeupTimer> timer = createWakeupTimer(configuration.mechanism);
+
+        uint64_t period_ticks = static_cast<uint64_t>(
+            static_cast<double>(task.period_nanoseconds) / clock.getNanosecondsPerTick());
+        uint64_t deadline_ticks = static_cast<uint64_t>(
+            static_cast<double>(task.deadline_nanoseconds) / clock.getNanosecondsPerTick());
+
+        util::Clock::dispatch(configuration.clock_source, [&](auto reader) {
+            RunPeriodicTask<decltype(reader)>(*timer,
+                                              configuration.iterations,
+                                              period_ticks == 0 ? 1 : period_ticks,
+                                              deadline_ticks,
+                                              clock.getNanosecondsPerTick(),
+                                              thread_statistics,
+                                              *task_statistics[thread_index]);
+        });
+    });
+
+    std::vector<string> labels;
+    std::vector<const Histogram*> latency_histograms;
+    std::vector<const Histogram*> corrected_histograms;
+    std::vector<const Histogram*> jitter_histograms;
+
+    for (size_t i = 0; i < tasks.size(); i++) {
+        labels.push_back(std::to_string(i));
+        latency_histograms.push_back(&statistics[i]->histogram);
+        corrected_histograms.push_back(&task_statistics[i]->corrected_histogram);
+        jitter_histograms.push_back(&task_statistics[i]->jitter_histogram);
+    }
+
+    std::cout << "Release latency of the runs:\n";
+    printHistogramTable("Task", labels, latency_histograms, clock, configuration.percentiles);
+
+    std::cout << "\nRelease latency corrected for skipped releases:\n";
+    printHistogramTable("Task", labels, corrected_histograms, clock, configuration.percentiles);
+
+    std::cout << "\nPeriod jitter:\n";
+    printHistogramTable("Task", labels, jitter_histograms, clock, configuration.percentiles);
+
+    std::cout << "\nDeadline misses:\n";
+    PrintSummaryTable(task_statistics);
+}
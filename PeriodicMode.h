@@ -0,0 +1,60 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_PERIODIC_MODE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_PERIODIC_MODE_HPP
+
+#include "Clock.h"
+#include "Histogram.h"
+#include "MemoryControl.h"
+#include "ThreadControl.h"
+#include "WakeupMode.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	struct PeriodicTask {
+		uint64_t period_nanoseconds;
+		uint64_t deadline_nanoseconds; // Relative to the release.
+		int      thread_priority;
+	};
+
+	// What a periodic task measures beside the plain release latency that
+	// goes into ThreadStatistics::histogram.
+	struct alignas(util::CACHE_LINE_SIZE) PeriodicTaskStatistics {
+		static void* operator new(size_t size) {
+			return util::allocateMeasurementMemory(size);
+		}
+
+		static void operator delete(void* data, size_t size) {
+			util::freeMeasurementMemory(data, size);
+		}
+
+		// Latencies plus those of the releases skipped while the task was
+		// late, so that a long stall weighs as much as the releases it
+		// swallowed (coordinated omission correction):
+		util::Histogram corrected_histogram;
+
+		// Differences between the latencies of consecutive runs, i.e. how
+		// far each actual period deviated from the nominal one:
+		util::Histogram jitter_histogram;
+
+		uint64_t releases = 0;
+		uint64_t skipped_releases = 0;
+		uint64_t deadline_misses = 0;
+		uint64_t longest_miss_run = 0;
+	};
+
+	struct PeriodicConfiguration {
+		util::ClockSource         clock_source;
+		size_t                    iterations; // Releases per task.
+		std::vector<PeriodicTask> tasks;
+		std::vector<int>          cpus; // One entry per task, or one for all.
+		WakeupMechanism           mechanism;
+		std::vector<double>       percentiles;
+	};
+
+	// Runs every task on its own thread against an absolute release
+	// schedule and prints latency, jitter and deadline misses per task.
+	void runPeriodicMode(const PeriodicConfiguration& configuration, const util::Clock& clock);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_PERIODIC_MODE_HPP
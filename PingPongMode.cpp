@@ -0,0 +1,458 @@
+#include "PingPongMode.h"
+#include "Measurement.h"
+#include "PriorityNames.h"
+#include "Report.h"
+#include "SystemError.h"
+#include "Topology.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#pragma comment(lib, "Synchronization.lib")
+#else
+#include <cerrno>
+#include <linux/futex.h>
+#include <semaphore.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::HandoffPrimitive;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+using com::github::coderodde::wtpdmt::util::CpuLocation;
+using com::github::coderodde::wtpdmt::util::Histogram;
+using com::github::coderodde::wtpdmt::util::throwSystemError;
+
+// Primitive names as accepted by --primitives:
+static const string PRIMITIVE_SPIN_STR               = "spin";
+static const string PRIMITIVE_CONDITION_VARIABLE_STR = "condition-variable";
+static const string PRIMITIVE_SEMAPHORE_STR          = "semaphore";
+static const string PRIMITIVE_EVENT_STR              = "event";
+static const string PRIMITIVE_EVENTFD_STR            = "eventfd";
+#ifdef _WIN32
+static const string PRIMITIVE_FUTEX_STR              = "wait-on-address";
+#else
+static const string PRIMITIVE_FUTEX_STR              = "futex";
+#endif
+
+static const size_t PING_THREAD_INDEX = 0;
+static const size_t PONG_THREAD_INDEX = 1;
+
+// Hands the token in one direction: signal() passes it, wait() blocks
+// until it arrives and takes it.
+class HandoffSignal {
+public:
+
+    virtual ~HandoffSignal() = default;
+
+    virtual void signal() = 0;
+    virtual void wait() = 0;
+};
+
+class SpinSignal : public HandoffSignal {
+private:
+
+    std::atomic<bool> m_token{ false };
+
+public:
+
+    void signal() override {
+        m_token.store(true, std::memory_order_release);
+    }
+
+    void wait() override {
+        while (!m_token.load(std::memory_order_acquire)) {
+        }
+
+        m_token.store(false, std::memory_order_relaxed);
+    }
+};
+
+class ConditionVariableSignal : public HandoffSignal {
+private:
+
+    std::mutex              m_mutex;
+    std::condition_variable m_condition_variable;
+    bool                    m_token = false;
+
+public:
+
+    void signal() override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_token = true;
+        }
+
+        m_condition_variable.notify_one();
+    }
+
+    void wait() override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition_variable.wait(lock, [this]() { return m_token; });
+        m_token = false;
+    }
+};
+
+class FutexSignal : public HandoffSignal {
+private:
+
+    std::atomic<uint32_t> m_token{ 0 };
+
+public:
+
+    void signal() override {
+        m_token.store(1, std::memory_order_release);
+#ifdef _WIN32
+        WakeByAddressSingle(&m_token);
+#else
+        syscall(SYS_futex, &m_token, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+    }
+
+    void wait() override {
+        while (m_token.exchange(0, std::memory_order_acquire) == 0) {
+#ifdef _WIN32
+            uint32_t no_token = 0;
+            WaitOnAddress(&m_token, &no_token, sizeof(no_token), INFINITE);
+#else
+            syscall(SYS_futex, &m_token, FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0);
+#endif
+        }
+    }
+};
+
+#ifdef _WIN32
+// Waits on a semaphore or an auto-reset event.
+class HandleSignal : public HandoffSignal {
+private:
+
+    HANDLE m_handle;
+    bool   m_is_event;
+
+public:
+
+    explicit HandleSignal(bool is_event) :
+        m_handle  { is_event ? CreateEventW(nullptr, FALSE, FALSE, nullptr)
+                             : CreateSemaphoreW(nullptr, 0, 1, nullptr) },
+        m_is_event{ is_event }
+    {
+        if (m_handle == nullptr) {
+            throwSystemError(is_event ? "create an event" : "create a semaphore");
+        }
+    }
+
+    ~HandleSignal() {
+        CloseHandle(m_handle);
+    }
+
+    void signal() override {
+        if (m_is_event) {
+            SetEvent(m_handle);
+        } else {
+            ReleaseSemaphore(m_handle, 1, nullptr);
+        }
+    }
+
+    void wait() override {
+        WaitForSingleObject(m_handle, INFINITE);
+    }
+};
+#else
+class SemaphoreSignal : public HandoffSignal {
+private:
+
+    sem_t m_semaphore;
+
+public:
+
+    SemaphoreSignal() {
+        if (sem_init(&m_semaphore, 0, 0) != 0) {
+            throwSystemError("create a semaphore");
+        }
+    }
+
+    ~SemaphoreSignal() {
+        sem_destroy(&m_semaphore);
+    }
+
+    void signal() override {
+        sem_post(&m_semaphore);
+    }
+
+    void wait() override {
+        while (sem_wait(&m_semaphore) != 0 && errno == EINTR) {
+        }
+    }
+};
+
+class EventfdSignal : public HandoffSignal {
+private:
+
+    int m_fd;
+
+public:
+
+    EventfdSignal() :
+        m_fd{ eventfd(0, EFD_CLOEXEC) }
+    {
+        if (m_fd < 0) {
+            throwSystemError("create an eventfd");
+        }
+    }
+
+    ~EventfdSignal() {
+        close(m_fd);
+    }
+
+    void signal() override {
+        uint64_t token = 1;
+        ssize_t bytes_written = write(m_fd, &token, sizeof(token));
+        (void) bytes_written;
+    }
+
+    void wait() override {
+        uint64_t tokens;
+
+        while (read(m_fd, &tokens, sizeof(tokens)) < 0 && errno == EINTR) {
+        }
+    }
+};
+#endif
+
+static std::unique_ptr<HandoffSignal> CreateHandoffSignal(HandoffPrimitive primitive) {
+    switch (primitive) {
+    case HandoffPrimitive::SPIN:
+        return std::make_unique<SpinSignal>();
+
+    case HandoffPrimitive::CONDITION_VARIABLE:
+        return std::make_unique<ConditionVariableSignal>();
+
+    case HandoffPrimitive::FUTEX:
+        return std::make_unique<FutexSignal>();
+
+#ifdef _WIN32
+    case HandoffPrimitive::SEMAPHORE:
+        return std::make_unique<HandleSignal>(false);
+
+    case HandoffPrimitive::EVENT:
+        return std::make_unique<HandleSignal>(true);
+#else
+    case HandoffPrimitive::SEMAPHORE:
+        return std::make_unique<SemaphoreSignal>();
+
+    case HandoffPrimitive::EVENTFD:
+        return std::make_unique<EventfdSignal>();
+#endif
+
+    default:
+        throw std::logic_error{ "The primitive '"
+                              + com::github::coderodde::wtpdmt::getHandoffPrimitiveName(primitive)
+                              + "' is not supported on this platform." };
+    }
+}
+
+#ifdef _WIN32
+static constexpr HandoffPrimitive SUPPORTED_HANDOFF_PRIMITIVES[] = {
+    HandoffPrimitive::SPIN,
+    HandoffPrimitive::CONDITION_VARIABLE,
+    HandoffPrimitive::SEMAPHORE,
+    HandoffPrimitive::EVENT,
+    HandoffPrimitive::FUTEX
+};
+#else
+static constexpr HandoffPrimitive SUPPORTED_HANDOFF_PRIMITIVES[] = {
+    HandoffPrimitive::SPIN,
+    HandoffPrimitive::CONDITION_VARIABLE,
+    HandoffPrimitive::SEMAPHORE,
+    HandoffPrimitive::EVENTFD,
+    HandoffPrimitive::FUTEX
+};
+#endif
+
+std::span<const HandoffPrimitive> com::github::coderodde::wtpdmt::getSupportedHandoffPrimitives() {
+    return SUPPORTED_HANDOFF_PRIMITIVES;
+}
+
+string com::github::coderodde::wtpdmt::getHandoffPrimitiveName(HandoffPrimitive primitive) {
+    switch (primitive) {
+    case HandoffPrimitive::SPIN:               return PRIMITIVE_SPIN_STR;
+    case HandoffPrimitive::CONDITION_VARIABLE: return PRIMITIVE_CONDITION_VARIABLE_STR;
+    case HandoffPrimitive::SEMAPHORE:          return PRIMITIVE_SEMAPHORE_STR;
+    case HandoffPrimitive::EVENT:              return PRIMITIVE_EVENT_STR;
+    case HandoffPrimitive::EVENTFD:            return PRIMITIVE_EVENTFD_STR;
+    case HandoffPrimitive::FUTEX:              return PRIMITIVE_FUTEX_STR;
+    }
+
+    throw std::logic_error{ "Unknown handoff primitive." };
+}
+
+bool com::github::coderodde::wtpdmt::findHandoffPrimitive(std::string_view name,
+                                                          HandoffPrimitive* primitive_ptr) {
+    for (HandoffPrimitive primitive : getSupportedHandoffPrimitives()) {
+        if (getHandoffPrimitiveName(primitive) == name) {
+            *primitive_ptr = primitive;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+struct Placement {
+    string name;
+    std::vector<int> cpus; // Ping, pong.
+};
+
+struct alignas(com::github::coderodde::wtpdmt::util::CACHE_LINE_SIZE) PingPongChannel {
+    std::unique_ptr<HandoffSignal> to_pong;
+    std::unique_ptr<HandoffSignal> to_ping;
+    std::atomic<uint64_t>          ping_ticks{ 0 }; // When the last token left.
+};
+
+// Pairs CPU 0 with the first CPU at each distance from it.
+static std::vector<Placement> GetPlacements(const std::vector<int>& cpus) {
+    if (cpus.size() == 2) {
+        return { Placement{ "given CPUs", cpus } };
+    }
+
+    if (cpus[0] != com::github::coderodde::wtpdmt::UNPINNED_CPU) {
+        return { Placement{ "same CPU", { cpus[0], cpus[0] } } };
+    }
+
+    std::vector<CpuLocation> locations = com::github::coderodde::wtpdmt::util::getCpuLocations();
+    const CpuLocation& first = locations[0];
+    std::vector<Placement> placements = { Placement{ "same CPU", { first.cpu, first.cpu } } };
+    int sibling = -1;
+    int same_package = -1;
+    int other_package = -1;
+
+    for (const CpuLocation& location : locations) {
+        if (location.cpu == first.cpu) {
+            continue;
+        }
+
+        if (location.package != first.package) {
+            other_package = other_package < 0 ? location.cpu : other_package;
+        } else if (location.core == first.core) {
+            sibling = sibling < 0 ? location.cpu : sibling;
+        } else {
+            same_package = same_package < 0 ? location.cpu : same_package;
+        }
+    }
+
+    const int candidates[] = { sibling, same_package, other_package };
+    const char* const names[] = { "SMT sibling", "same package", "other package" };
+    const char* const missing[] = { "no SMT sibling", "no other core in its package", "no other package" };
+
+    for (size_t i = 0; i < 3; i++) {
+        if (candidates[i] < 0) {
+            std::cout << "INFO: CPU " << first.cpu << " has " << missing[i] << "; skipping that placement.\n";
+        } else {
+            placements.push_back(Placement{ names[i], { first.cpu, candidates[i] } });
+        }
+    }
+
+    return placements;
+}
+
+template<class Reader>
+static void RunPing(size_t iterations, PingPongChannel& channel, ThreadStatistics& thread_statistics) {
+    for (size_t i = 0; i < iterations; i++) {
+        uint64_t ta = Reader::read();
+        channel.ping_ticks.store(ta, std::memory_order_relaxed);
+        channel.to_pong->signal();
+        channel.to_ping->wait();
+        uint64_t tb = Reader::read();
+
+        thread_statistics.histogram.record(tb - ta);
+    }
+}
+
+template<class Reader>
+static void RunPong(size_t iterations, PingPongChannel& channel, ThreadStatistics& thread_statistics) {
+    for (size_t i = 0; i < iterations; i++) {
+        channel.to_pong->wait();
+        uint64_t tb = Reader::read();
+        uint64_t ta = channel.ping_ticks.load(std::memory_order_relaxed);
+
+        // Unsynchronized per-CPU counters may put the wakeup first:
+        thread_statistics.histogram.record(tb > ta ? tb - ta : 0);
+        channel.to_ping->signal();
+    }
+}
+
+void com::github::coderodde::wtpdmt::runPingPongMode(const PingPongConfiguration& configuration,
+                                                     const util::Clock& clock) {
+    std::vector<int> thread_priorities(configuration.thread_priorities,
+                                       configuration.thread_priorities + PING_PONG_THREAD_COUNT);
+
+    std::cout << "INFO: Ping thread priority is "
+              << util::getThreadPriorityName(util::getProcessPriorityClass(), thread_priorities[PING_THREAD_INDEX])
+              << ", pong thread priority is "
+              << util::getThreadPriorityName(util::getProcessPriorityClass(), thread_priorities[PONG_THREAD_INDEX])
+              << "; " << configuration.iterations << " round trips per primitive.\n";
+
+    for (const Placement& placement : GetPlacements(configuration.cpus)) {
+        std::vector<string> labels;
+        std::vector<std::vector<std::unique_ptr<ThreadStatistics>>> all_statistics;
+        std::vector<const Histogram*> round_trip_histograms;
+        std::vector<const Histogram*> one_way_histograms;
+
+        for (HandoffPrimitive primitive : configuration.primitives) {
+            string name = getHandoffPrimitiveName(primitive);
+
+            // Two spinning threads on one CPU take turns at the scheduler's
+            // pace, or never under a real-time class:
+            if (primitive == HandoffPrimitive::SPIN && placement.cpus[0] == placement.cpus[1]) {
+                std::cout << "INFO: Skipping " << name << " on the " << placement.name << ".\n";
+                continue;
+            }
+
+            PingPongChannel channel;
+            std::vector<std::unique_ptr<ThreadStatistics>> statistics;
+
+            try {
+                channel.to_pong = CreateHandoffSignal(primitive);
+                channel.to_ping = CreateHandoffSignal(primitive);
+                statistics = runOnThreads(placement.cpus,
+                                          thread_priorities,
+                                          [&](size_t thread_index, ThreadStatistics& thread_statistics) {
+                    util::Clock::dispatch(configuration.clock_source, [&](auto reader) {
+                        if (thread_index == PING_THREAD_INDEX) {
+                            RunPing<decltype(reader)>(configuration.iterations, channel, thread_statistics);
+                        } else {
+                            RunPong<decltype(reader)>(configuration.iterations, channel, thread_statistics);
+                        }
+                    });
+                });
+            } catch (std::runtime_error& err) {
+                std::cout << "WARNING: Skipping " << name << ": " << err.what() << "\n";
+                continue;
+            }
+
+            labels.push_back(name);
+            round_trip_histograms.push_back(&statistics[PING_THREAD_INDEX]->histogram);
+            one_way_histograms.push_back(&statistics[PONG_THREAD_INDEX]->histogram);
+            all_statistics.push_back(std::move(statistics));
+        }
+
+        std::cout << "\nRound trip, " << placement.name
+                  << " (CPUs " << placement.cpus[0] << " and " << placement.cpus[1] << "):\n";
+        printHistogramTable("Primitive", labels, round_trip_histograms, clock, configuration.percentiles);
+
+        std::cout << "\nOne way, ping to pong, " << placement.name << ":\n";
+        printHistogramTable("Primitive", labels, one_way_histograms, clock, configuration.percentiles);
+    }
+}
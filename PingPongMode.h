@@ -0,0 +1,46 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_PING_PONG_MODE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_PING_PONG_MODE_HPP
+
+#include "Clock.h"
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using std::string;
+
+	enum class HandoffPrimitive {
+		SPIN,               // Polling an atomic flag
+		CONDITION_VARIABLE, // std::condition_variable with a flag
+		SEMAPHORE,          // sem_post() / ReleaseSemaphore()
+		EVENT,              // Auto-reset event object
+		EVENTFD,            // write() and read() on an eventfd
+		FUTEX               // FUTEX_WAKE and FUTEX_WAIT (WaitOnAddress() on Windows)
+	};
+
+	std::span<const HandoffPrimitive> getSupportedHandoffPrimitives();
+	string getHandoffPrimitiveName(HandoffPrimitive primitive);
+	bool findHandoffPrimitive(std::string_view name, HandoffPrimitive* primitive_ptr);
+
+	// The ping thread, then the pong thread.
+	constexpr size_t PING_PONG_THREAD_COUNT = 2;
+
+	struct PingPongConfiguration {
+		util::ClockSource             clock_source;
+		size_t                        iterations; // Round trips per primitive and placement.
+		int                           thread_priorities[PING_PONG_THREAD_COUNT];
+		std::vector<int>              cpus; // One or two CPUs, or UNPINNED_CPU for all placements.
+		std::vector<HandoffPrimitive> primitives;
+		std::vector<double>           percentiles;
+	};
+
+	// Bounces a token between two threads with every primitive and prints
+	// the round-trip and one-way latencies. Without CPUs it runs every
+	// placement the topology offers: both threads on one CPU, on SMT
+	// siblings, on two cores of a package and on two packages.
+	void runPingPongMode(const PingPongConfiguration& configuration, const util::Clock& clock);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_PING_PONG_MODE_HPP
@@ -0,0 +1,92 @@
+#include "PowerControl.h"
+#include "SystemError.h"
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::util::throwSystemError;
+
+#ifdef _WIN32
+// The request must live as long as the process; closing it withdraws it.
+static HANDLE power_request = nullptr;
+#else
+// Closing the file withdraws the request, so it stays open until exit.
+static int cpu_latency_fd = -1;
+#endif
+
+void com::github::coderodde::wtpdmt::util::requestCpuLatency(uint64_t microseconds) {
+#ifdef _WIN32
+    (void) microseconds;
+
+    // Keep whatever else the process opted out of, such as the timer
+    // resolution throttling:
+    PROCESS_POWER_THROTTLING_STATE throttling{};
+    throttling.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+
+    if (!GetProcessInformation(GetCurrentProcess(), ProcessPowerThrottling, &throttling, sizeof(throttling))) {
+        throttling = PROCESS_POWER_THROTTLING_STATE{};
+        throttling.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+    }
+
+    throttling.ControlMask |= PROCESS_POWER_THROTTLING_EXECUTION_SPEED;
+    throttling.StateMask &= ~static_cast<ULONG>(PROCESS_POWER_THROTTLING_EXECUTION_SPEED);
+
+    if (!SetProcessInformation(GetCurrentProcess(), ProcessPowerThrottling, &throttling, sizeof(throttling))) {
+        throwSystemError("opt out of power throttling");
+    }
+
+    if (power_request == nullptr) {
+        REASON_CONTEXT context{};
+        context.Version = POWER_REQUEST_CONTEXT_VERSION;
+        context.Flags = POWER_REQUEST_CONTEXT_SIMPLE_STRING;
+        context.Reason.SimpleReasonString = const_cast<LPWSTR>(L"Measuring scheduling latency");
+
+        power_request = PowerCreateRequest(&context);
+
+        if (power_request == INVALID_HANDLE_VALUE) {
+            power_request = nullptr;
+            throwSystemError("create a power request");
+        }
+    }
+
+    if (!PowerSetRequest(power_request, PowerRequestSystemRequired)) {
+        throwSystemError("set a power request");
+    }
+#else
+    if (microseconds > static_cast<uint64_t>((std::numeric_limits<int32_t>::max)())) {
+        throw std::logic_error{ "The CPU latency does not fit into 32 bits." };
+    }
+
+    if (cpu_latency_fd < 0) {
+        cpu_latency_fd = open("/dev/cpu_dma_latency", O_WRONLY | O_CLOEXEC);
+
+        if (cpu_latency_fd < 0) {
+            throwSystemError("open /dev/cpu_dma_latency");
+        }
+    }
+
+    // The kernel takes the value as a binary 32-bit integer:
+    int32_t value = static_cast<int32_t>(microseconds);
+
+    if (write(cpu_latency_fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+        throwSystemError("write /dev/cpu_dma_latency");
+    }
+#endif
+}
+
+string com::github::coderodde::wtpdmt::util::getCpuLatencyRequestName() {
+#ifdef _WIN32
+    return "no execution speed throttling and a system-required power request";
+#else
+    return "a PM QoS request in /dev/cpu_dma_latency";
+#endif
+}
@@ -0,0 +1,23 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_POWER_CONTROL_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_POWER_CONTROL_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	using std::string;
+
+	// Keeps the CPUs out of idle states that take longer than
+	// 'microseconds' to leave, until the process exits. Linux holds the
+	// value open in /dev/cpu_dma_latency, which needs root; 0 allows
+	// polling idle only. Windows has no latency request for user mode, so
+	// it takes the nearest thing and ignores the value: the process opts
+	// out of execution speed throttling (EcoQoS), and a power request keeps
+	// the system out of sleep.
+	void requestCpuLatency(uint64_t microseconds);
+
+	// What requestCpuLatency() does on this platform, for the report.
+	string getCpuLatencyRequestName();
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_POWER_CONTROL_HPP
@@ -0,0 +1,405 @@
+#include "PowerStates.h"
+#include "Clock.h"
+#include "SystemError.h"
+#include "ThreadControl.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <powrprof.h>
+#pragma comment(lib, "PowrProf.lib")
+#else
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::PowerCounterSource;
+using com::github::coderodde::wtpdmt::PowerSample;
+using com::github::coderodde::wtpdmt::PowerState;
+using com::github::coderodde::wtpdmt::PowerStateStatistics;
+using com::github::coderodde::wtpdmt::util::throwSystemError;
+
+static const string POWER_STATE_HALTED_STR     = "halted";
+static const string POWER_STATE_SLOWED_STR     = "slowed";
+static const string POWER_STATE_FULL_SPEED_STR = "full speed";
+
+#ifdef _WIN32
+// Documented for CallNtPowerInformation(), but declared in no SDK header.
+struct ProcessorPowerInformation {
+    ULONG Number;
+    ULONG MaxMhz;
+    ULONG CurrentMhz;
+    ULONG MhzLimit;
+    ULONG MaxIdleState;
+    ULONG CurrentIdleState;
+};
+#else
+static const uint32_t MSR_TSC   = 0x10;
+static const uint32_t MSR_MPERF = 0xE7;
+static const uint32_t MSR_APERF = 0xE8;
+
+static const size_t PATH_LENGTH = 128;
+#endif
+
+#ifdef _WIN32
+static size_t GetProcessorCount() {
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return static_cast<size_t>(system_info.dwNumberOfProcessors);
+}
+
+// Fills 'buffer' with one entry per processor.
+static bool ReadProcessorInformation(std::vector<unsigned char>& buffer) {
+    return CallNtPowerInformation(ProcessorInformation,
+                                  nullptr,
+                                  0,
+                                  buffer.data(),
+                                  static_cast<ULONG>(buffer.size())) == 0;
+}
+#else
+static bool ReadMsr(int fd, uint32_t msr, uint64_t* value) {
+    return pread(fd, value, sizeof(*value), static_cast<off_t>(msr)) == static_cast<ssize_t>(sizeof(*value));
+}
+
+// Reads the decimal number a sysfs file holds; reading from offset 0 makes
+// the kernel generate it anew.
+static bool ReadSysfsNumber(int fd, uint64_t* value) {
+    char buffer[32];
+    ssize_t length = pread(fd, buffer, sizeof(buffer), 0);
+
+    if (length <= 0 || buffer[0] < '0' || buffer[0] > '9') {
+        return false;
+    }
+
+    uint64_t number = 0;
+
+    for (ssize_t i = 0; i < length && buffer[i] >= '0' && buffer[i] <= '9'; i++) {
+        number = number * 10 + static_cast<uint64_t>(buffer[i] - '0');
+    }
+
+    *value = number;
+    return true;
+}
+
+static int OpenCpuFile(const char* format, int cpu) {
+    char path[PATH_LENGTH];
+    std::snprintf(path, sizeof(path), format, cpu);
+    return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+static uint64_t ReadCpuNumber(const char* format, int cpu) {
+    int fd = OpenCpuFile(format, cpu);
+    uint64_t value = 0;
+
+    if (fd >= 0) {
+        ReadSysfsNumber(fd, &value);
+        close(fd);
+    }
+
+    return value;
+}
+#endif
+
+string com::github::coderodde::wtpdmt::getPowerStateName(PowerState state) {
+    switch (state) {
+    case PowerState::HALTED:
+        return POWER_STATE_HALTED_STR;
+
+    case PowerState::SLOWED:
+        return POWER_STATE_SLOWED_STR;
+
+    case PowerState::FULL_SPEED:
+        return POWER_STATE_FULL_SPEED_STR;
+    }
+
+    return "unknown";
+}
+
+PowerCounterSource com::github::coderodde::wtpdmt::findPowerCounterSource() {
+#ifdef _WIN32
+    std::vector<unsigned char> buffer(GetProcessorCount() * sizeof(ProcessorPowerInformation));
+
+    if (ReadProcessorInformation(buffer) &&
+        reinterpret_cast<const ProcessorPowerInformation*>(buffer.data())->MaxMhz != 0) {
+        return PowerCounterSource::PROCESSOR_INFORMATION;
+    }
+#else
+    // The msr module must be loaded, and hypervisors often fault the reads:
+    int msr_fd = OpenCpuFile("/dev/cpu/%d/msr", 0);
+
+    if (msr_fd >= 0) {
+        uint64_t value;
+        bool readable = ReadMsr(msr_fd, MSR_APERF, &value) && ReadMsr(msr_fd, MSR_MPERF, &value);
+        close(msr_fd);
+
+        if (readable) {
+            return PowerCounterSource::MSR;
+        }
+    }
+
+    if (access("/sys/devices/system/cpu/cpu0/cpuidle/state0/time", R_OK) == 0 ||
+        access("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", R_OK) == 0) {
+        return PowerCounterSource::SYSFS;
+    }
+#endif
+
+    return PowerCounterSource::NONE;
+}
+
+string com::github::coderodde::wtpdmt::getPowerCounterSourceName(PowerCounterSource source) {
+    switch (source) {
+    case PowerCounterSource::NONE:
+        return "none";
+
+    case PowerCounterSource::MSR:
+        return "APERF/MPERF";
+
+    case PowerCounterSource::SYSFS:
+        return "cpuidle/cpufreq";
+
+    case PowerCounterSource::PROCESSOR_INFORMATION:
+        return "CallNtPowerInformation()";
+    }
+
+    return "unknown";
+}
+
+void com::github::coderodde::wtpdmt::addPowerStateStatistics(PowerStateStatistics& total,
+                                                             const PowerStateStatistics& statistics) {
+    for (size_t i = 0; i < POWER_STATE_COUNT; i++) {
+        total.gaps[i]              += statistics.gaps[i];
+        total.gap_ticks[i]         += statistics.gap_ticks[i];
+        total.largest_gap_ticks[i]  = statistics.largest_gap_ticks[i] > total.largest_gap_ticks[i]
+                                    ? statistics.largest_gap_ticks[i]
+                                    : total.largest_gap_ticks[i];
+    }
+
+    total.frequency_ratio_sum += statistics.frequency_ratio_sum;
+    total.frequency_samples   += statistics.frequency_samples;
+    total.migrations          += statistics.migrations;
+}
+
+com::github::coderodde::wtpdmt::PowerStateSampler::PowerStateSampler(PowerCounterSource source,
+                                                                     double nanoseconds_per_tick) :
+    m_source              { source },
+    m_nanoseconds_per_tick{ nanoseconds_per_tick },
+    m_last_sample         {},
+    m_statistics          {},
+#ifdef _WIN32
+    m_buffer(GetProcessorCount() * sizeof(ProcessorPowerInformation))
+#else
+    m_files_cpu        { -1 },
+    m_msr_fd           { -1 },
+    m_idle_time_fds    {},
+    m_frequency_fd     { -1 },
+    m_nominal_kilohertz{ 0.0 }
+#endif
+{
+    if (source == PowerCounterSource::NONE) {
+        throw std::logic_error{ "No power counter source to sample." };
+    }
+
+#ifndef _WIN32
+    openFiles(util::getCurrentCpu());
+#endif
+}
+
+com::github::coderodde::wtpdmt::PowerStateSampler::~PowerStateSampler() {
+#ifndef _WIN32
+    closeFiles();
+#endif
+}
+
+void com::github::coderodde::wtpdmt::PowerStateSampler::start() {
+    m_last_sample = sample();
+}
+
+void com::github::coderodde::wtpdmt::PowerStateSampler::attribute(uint64_t gap_ticks) {
+    PowerSample power_sample = sample();
+
+    // The counters of two CPUs do not compare:
+    if (power_sample.cpu != m_last_sample.cpu) {
+        m_statistics.migrations++;
+        m_last_sample = power_sample;
+        return;
+    }
+
+    double gap_nanoseconds = static_cast<double>(gap_ticks) * m_nanoseconds_per_tick;
+    double halted_nanoseconds = 0.0;
+    double frequency_ratio = power_sample.frequency_ratio;
+
+    if (m_source == PowerCounterSource::MSR) {
+        double tsc_delta   = static_cast<double>(power_sample.tsc - m_last_sample.tsc);
+        double mperf_delta = static_cast<double>(power_sample.mperf - m_last_sample.mperf);
+        double aperf_delta = static_cast<double>(power_sample.aperf - m_last_sample.aperf);
+
+        if (tsc_delta > 0.0 && mperf_delta <= tsc_delta) {
+            halted_nanoseconds = (1.0 - mperf_delta / tsc_delta)
+                               * static_cast<double>(power_sample.wall_nanoseconds - m_last_sample.wall_nanoseconds);
+        }
+
+        frequency_ratio = mperf_delta > 0.0 ? aperf_delta / mperf_delta : 0.0;
+    } else {
+        halted_nanoseconds = static_cast<double>(power_sample.idle_nanoseconds - m_last_sample.idle_nanoseconds);
+    }
+
+    PowerState state;
+
+    if (halted_nanoseconds * 2.0 >= gap_nanoseconds) {
+        state = PowerState::HALTED;
+    } else if (frequency_ratio > 0.0 && frequency_ratio < SLOWED_FREQUENCY_RATIO) {
+        state = PowerState::SLOWED;
+    } else {
+        state = PowerState::FULL_SPEED;
+    }
+
+    size_t index = static_cast<size_t>(state);
+    m_statistics.gaps[index]++;
+    m_statistics.gap_ticks[index] += gap_ticks;
+    m_statistics.largest_gap_ticks[index] = gap_ticks > m_statistics.largest_gap_ticks[index]
+                                          ? gap_ticks
+                                          : m_statistics.largest_gap_ticks[index];
+
+    if (frequency_ratio > 0.0) {
+        m_statistics.frequency_ratio_sum += frequency_ratio;
+        m_statistics.frequency_samples++;
+    }
+
+    m_last_sample = power_sample;
+}
+
+const PowerStateStatistics& com::github::coderodde::wtpdmt::PowerStateSampler::getStatistics() const {
+    return m_statistics;
+}
+
+PowerSample com::github::coderodde::wtpdmt::PowerStateSampler::sample() {
+    PowerSample power_sample{};
+    power_sample.cpu = util::getCurrentCpu();
+
+#ifdef _WIN32
+    // Windows has no idle residency per processor, so no gap shows up as
+    // halted here; the current frequency is all there is.
+    if (ReadProcessorInformation(m_buffer) &&
+        static_cast<size_t>(power_sample.cpu) < m_buffer.size() / sizeof(ProcessorPowerInformation)) {
+        const ProcessorPowerInformation& information =
+            reinterpret_cast<const ProcessorPowerInformation*>(m_buffer.data())[power_sample.cpu];
+
+        if (information.MaxMhz != 0) {
+            power_sample.frequency_ratio = static_cast<double>(information.CurrentMhz)
+                                         / static_cast<double>(information.MaxMhz);
+        }
+    }
+#else
+    if (power_sample.cpu != m_files_cpu) {
+        openFiles(power_sample.cpu);
+    }
+
+    power_sample.wall_nanoseconds = util::MonotonicReader::read();
+
+    if (m_source == PowerCounterSource::MSR) {
+        if (!ReadMsr(m_msr_fd, MSR_APERF, &power_sample.aperf) ||
+            !ReadMsr(m_msr_fd, MSR_MPERF, &power_sample.mperf) ||
+            !ReadMsr(m_msr_fd, MSR_TSC, &power_sample.tsc)) {
+            throwSystemError("read the APERF, MPERF and TSC registers");
+        }
+
+        return power_sample;
+    }
+
+    for (int fd : m_idle_time_fds) {
+        uint64_t microseconds = 0;
+
+        if (ReadSysfsNumber(fd, &microseconds)) {
+            power_sample.idle_nanoseconds += microseconds * 1000;
+        }
+    }
+
+    uint64_t kilohertz = 0;
+
+    if (m_nominal_kilohertz > 0.0 && ReadSysfsNumber(m_frequency_fd, &kilohertz)) {
+        power_sample.frequency_ratio = static_cast<double>(kilohertz) / m_nominal_kilohertz;
+    }
+#endif
+
+    return power_sample;
+}
+
+#ifndef _WIN32
+void com::github::coderodde::wtpdmt::PowerStateSampler::openFiles(int cpu) {
+    closeFiles();
+    m_files_cpu = cpu;
+
+    if (m_source == PowerCounterSource::MSR) {
+        m_msr_fd = OpenCpuFile("/dev/cpu/%d/msr", cpu);
+
+        if (m_msr_fd < 0) {
+            throwSystemError("open the MSR device of CPU " + std::to_string(cpu));
+        }
+
+        return;
+    }
+
+    // The POLL state spins rather than idles; the thread would see it as
+    // running time anyway.
+    for (int state = 0; ; state++) {
+        char path[PATH_LENGTH];
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpuidle/state%d/name", cpu, state);
+        int name_fd = open(path, O_RDONLY | O_CLOEXEC);
+
+        if (name_fd < 0) {
+            break;
+        }
+
+        char name[16];
+        ssize_t length = pread(name_fd, name, sizeof(name), 0);
+        close(name_fd);
+
+        if (length >= 4 && std::memcmp(name, "POLL", 4) == 0) {
+            continue;
+        }
+
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpuidle/state%d/time", cpu, state);
+        int time_fd = open(path, O_RDONLY | O_CLOEXEC);
+
+        if (time_fd >= 0) {
+            m_idle_time_fds.push_back(time_fd);
+        }
+    }
+
+    // intel_pstate tells the nominal frequency; elsewhere the maximum is
+    // the nearest thing, which counts turbo-less running as slowed.
+    m_frequency_fd = OpenCpuFile("/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", cpu);
+    uint64_t nominal_kilohertz = ReadCpuNumber("/sys/devices/system/cpu/cpu%d/cpufreq/base_frequency", cpu);
+
+    if (nominal_kilohertz == 0) {
+        nominal_kilohertz = ReadCpuNumber("/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+    }
+
+    m_nominal_kilohertz = m_frequency_fd >= 0 ? static_cast<double>(nominal_kilohertz) : 0.0;
+}
+
+void com::github::coderodde::wtpdmt::PowerStateSampler::closeFiles() {
+    if (m_msr_fd >= 0) {
+        close(m_msr_fd);
+        m_msr_fd = -1;
+    }
+
+    for (int fd : m_idle_time_fds) {
+        close(fd);
+    }
+
+    m_idle_time_fds.clear();
+
+    if (m_frequency_fd >= 0) {
+        close(m_frequency_fd);
+        m_frequency_fd = -1;
+    }
+}
+#endif
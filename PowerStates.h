@@ -0,0 +1,115 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_POWER_STATES_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_POWER_STATES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using std::string;
+
+	enum class PowerState {
+		HALTED,    // The CPU sat in an idle state for most of the gap
+		SLOWED,    // It ran, but below its nominal frequency
+		FULL_SPEED // Power management had no visible part in it
+	};
+
+	constexpr size_t POWER_STATE_COUNT = 3;
+
+	// Below this share of the nominal frequency a gap counts as slowed; the
+	// margin keeps the ordinary wobble of the counters out.
+	constexpr double SLOWED_FREQUENCY_RATIO = 0.9;
+
+	string getPowerStateName(PowerState state);
+
+	enum class PowerCounterSource {
+		NONE,
+		MSR,                  // APERF, MPERF and the TSC in /dev/cpu/N/msr
+		SYSFS,                // cpuidle residency and cpufreq in /sys
+		PROCESSOR_INFORMATION // CallNtPowerInformation() on Windows
+	};
+
+	// The best source this process can read, probed on CPU 0.
+	PowerCounterSource findPowerCounterSource();
+
+	string getPowerCounterSourceName(PowerCounterSource source);
+
+	struct PowerStateStatistics {
+		uint64_t gaps[POWER_STATE_COUNT];
+		uint64_t gap_ticks[POWER_STATE_COUNT];
+		uint64_t largest_gap_ticks[POWER_STATE_COUNT];
+		double   frequency_ratio_sum; // Over the gaps with a known frequency.
+		uint64_t frequency_samples;
+		uint64_t migrations;          // Gaps across CPUs, which are not classified.
+	};
+
+	void addPowerStateStatistics(PowerStateStatistics& total, const PowerStateStatistics& statistics);
+
+	// What the current CPU's counters say. Which fields are set depends on
+	// the source: the MSR counts the cycles at the actual and at the
+	// nominal frequency (MPERF stops in idle states, the TSC does not),
+	// sysfs sums the idle residency and reads the current frequency, and
+	// Windows tells the current frequency only.
+	struct PowerSample {
+		int      cpu;
+		uint64_t wall_nanoseconds;
+		uint64_t idle_nanoseconds;
+		uint64_t aperf;
+		uint64_t mperf;
+		uint64_t tsc;
+		double   frequency_ratio; // Current over nominal frequency; 0 if unknown.
+	};
+
+	// Classifies the gaps of one measuring thread by what the CPU's power
+	// management did around them. As with GapAttributor, only gaps over
+	// the threshold pay for a sample, and each is judged by what changed
+	// since the previous one: the idle time falls into the gaps, since the
+	// spinning thread keeps the CPU busy otherwise, but the MSR frequency
+	// is the mean over the whole interval.
+	class PowerStateSampler {
+	private:
+
+		PowerCounterSource   m_source;
+		double               m_nanoseconds_per_tick;
+		PowerSample          m_last_sample;
+		PowerStateStatistics m_statistics;
+#ifdef _WIN32
+		std::vector<unsigned char> m_buffer; // For CallNtPowerInformation().
+#else
+		int              m_files_cpu; // The CPU the files below belong to.
+		int              m_msr_fd;
+		std::vector<int> m_idle_time_fds;
+		int              m_frequency_fd;
+		double           m_nominal_kilohertz;
+#endif
+
+	public:
+
+		// Call it on the measuring thread, which start() and attribute()
+		// must run on too.
+		PowerStateSampler(PowerCounterSource source, double nanoseconds_per_tick);
+		~PowerStateSampler();
+
+		PowerStateSampler(const PowerStateSampler&) = delete;
+		PowerStateSampler& operator=(const PowerStateSampler&) = delete;
+
+		// Takes the first sample.
+		void start();
+
+		// Classifies a gap that just ended and takes the next sample.
+		void attribute(uint64_t gap_ticks);
+
+		const PowerStateStatistics& getStatistics() const;
+
+	private:
+
+		PowerSample sample();
+#ifndef _WIN32
+		void openFiles(int cpu);
+		void closeFiles();
+#endif
+	};
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_POWER_STATES_HPP
@@ -0,0 +1,211 @@
+#include "PriorityNames.h"
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::util::PriorityClass;
+using com::github::coderodde::wtpdmt::util::PriorityClassName;
+using com::github::coderodde::wtpdmt::util::ThreadPriorityName;
+
+namespace names = com::github::coderodde::wtpdmt::util;
+
+template<class Entry>
+static constexpr bool NameLess(const Entry& a, const Entry& b) {
+    return a.name < b.name;
+}
+
+#ifndef _WIN32
+bool com::github::coderodde::wtpdmt::util::isRealtimePolicy(int policy) {
+    return policy == SCHED_FIFO || policy == SCHED_RR;
+}
+
+string com::github::coderodde::wtpdmt::util::describeThreadPriority(PriorityClass priority_class,
+                                                                    int thread_priority) {
+    int policy = static_cast<int>(priority_class);
+    std::stringstream ss;
+
+    if (isRealtimePolicy(policy)) {
+        ss << "real-time priority " << thread_priority;
+    } else if (policy == SCHED_OTHER || policy == SCHED_BATCH) {
+        ss << "nice " << thread_priority;
+    } else {
+        ss << "no thread priority";
+    }
+
+    return ss.str();
+}
+#endif
+
+// Sorted by name for the binary search in FindName():
+#ifdef _WIN32
+static constexpr PriorityClassName PRIORITY_CLASS_NAMES[] = {
+    { names::ABOVE_NORMAL_PRIORITY_CLASS_STR,   ABOVE_NORMAL_PRIORITY_CLASS   },
+    { names::BELOW_NORMAL_PRIORITY_CLASS_STR,   BELOW_NORMAL_PRIORITY_CLASS   },
+    { names::HIGH_PRIORITY_CLASS_STR,           HIGH_PRIORITY_CLASS           },
+    { names::IDLE_PRIORITY_CLASS_STR,           IDLE_PRIORITY_CLASS           },
+    { names::NORMAL_PRIORITY_CLASS_STR,         NORMAL_PRIORITY_CLASS         },
+    { names::PROCESS_MODE_BACKGROUND_BEGIN_STR, PROCESS_MODE_BACKGROUND_BEGIN },
+    { names::PROCESS_MODE_BACKGROUND_END_STR,   PROCESS_MODE_BACKGROUND_END   },
+    { names::REALTIME_PRIORITY_CLASS_STR,       REALTIME_PRIORITY_CLASS       },
+};
+
+static constexpr ThreadPriorityName THREAD_PRIORITY_NAMES[] = {
+    { names::THREAD_MODE_BACKGROUND_BEGIN_STR,  THREAD_MODE_BACKGROUND_BEGIN  },
+    { names::THREAD_MODE_BACKGROUND_END_STR,    THREAD_MODE_BACKGROUND_END    },
+    { names::THREAD_PRIORITY_ABOVE_NORMAL_STR,  THREAD_PRIORITY_ABOVE_NORMAL  },
+    { names::THREAD_PRIORITY_BELOW_NORMAL_STR,  THREAD_PRIORITY_BELOW_NORMAL  },
+    { names::THREAD_PRIORITY_HIGHEST_STR,       THREAD_PRIORITY_HIGHEST       },
+    { names::THREAD_PRIORITY_IDLE_STR,          THREAD_PRIORITY_IDLE          },
+    { names::THREAD_PRIORITY_LOWEST_STR,        THREAD_PRIORITY_LOWEST        },
+    { names::THREAD_PRIORITY_NORMAL_STR,        THREAD_PRIORITY_NORMAL        },
+    { names::THREAD_PRIORITY_TIME_CRITICAL_STR, THREAD_PRIORITY_TIME_CRITICAL },
+};
+
+static_assert(std::is_sorted(std::begin(THREAD_PRIORITY_NAMES), std::end(THREAD_PRIORITY_NAMES), NameLess<ThreadPriorityName>),
+              "THREAD_PRIORITY_NAMES must be sorted by name.");
+#else
+// The Windows names are accepted too, see PRIORITY_CLASS_POLICY_MAPPING:
+static constexpr PriorityClassName PRIORITY_CLASS_NAMES[] = {
+    { names::SCHED_BATCH_STR,    SCHED_BATCH    },
+    { names::SCHED_DEADLINE_STR, SCHED_DEADLINE },
+    { names::SCHED_FIFO_STR,     SCHED_FIFO     },
+    { names::SCHED_IDLE_STR,     SCHED_IDLE     },
+    { names::SCHED_OTHER_STR,    SCHED_OTHER    },
+    { names::SCHED_RR_STR,       SCHED_RR       },
+};
+
+// Linux resolves the names through THREAD_PRIORITY_MAPPING once the
+// policy is known.
+#endif
+
+static_assert(std::is_sorted(std::begin(PRIORITY_CLASS_NAMES), std::end(PRIORITY_CLASS_NAMES), NameLess<PriorityClassName>),
+              "PRIORITY_CLASS_NAMES must be sorted by name.");
+
+template<class Entry>
+static const Entry* FindName(std::span<const Entry> entries, std::string_view name) {
+    auto entry = std::lower_bound(entries.begin(), entries.end(), name, [](const Entry& e, std::string_view n) {
+        return e.name < n;
+    });
+
+    return entry != entries.end() && entry->name == name ? &*entry : nullptr;
+}
+
+std::span<const PriorityClassName> com::github::coderodde::wtpdmt::util::getPriorityClassNames() {
+    return PRIORITY_CLASS_NAMES;
+}
+
+std::span<const ThreadPriorityName> com::github::coderodde::wtpdmt::util::getThreadPriorityNames() {
+#ifdef _WIN32
+    return THREAD_PRIORITY_NAMES;
+#else
+    return {};
+#endif
+}
+
+bool com::github::coderodde::wtpdmt::util::findPriorityClass(std::string_view name, PriorityClass* priority_class) {
+    const PriorityClassName* entry = FindName(getPriorityClassNames(), name);
+
+    if (entry != nullptr) {
+        *priority_class = entry->priority_class;
+        return true;
+    }
+
+#ifndef _WIN32
+    for (const auto& mapping : PRIORITY_CLASS_POLICY_MAPPING) {
+        if (mapping.first == name) {
+            *priority_class = static_cast<PriorityClass>(mapping.second);
+            return true;
+        }
+    }
+#endif
+
+    return false;
+}
+
+bool com::github::coderodde::wtpdmt::util::findThreadPriority(std::string_view name,
+                                                              PriorityClass priority_class,
+                                                              int* thread_priority) {
+#ifdef _WIN32
+    (void) priority_class;
+
+    const ThreadPriorityName* entry = FindName(getThreadPriorityNames(), name);
+
+    if (entry != nullptr) {
+        *thread_priority = entry->thread_priority;
+        return true;
+    }
+#else
+    int policy = static_cast<int>(priority_class);
+
+    for (const ThreadPriorityMapping& mapping : THREAD_PRIORITY_MAPPING) {
+        if (mapping.name == name) {
+            *thread_priority = isRealtimePolicy(policy) ? mapping.realtime_priority : mapping.nice;
+            return true;
+        }
+    }
+#endif
+
+    return false;
+}
+
+string com::github::coderodde::wtpdmt::util::getPriorityClassName(PriorityClass priority_class) {
+    for (const PriorityClassName& entry : getPriorityClassNames()) {
+        if (entry.priority_class == priority_class) {
+            return string(entry.name);
+        }
+    }
+
+    std::stringstream ss;
+
+    ss << "Unknown priority class: 0x"
+       << std::setw(8)
+       << std::right
+       << std::setfill('0')
+       << std::hex
+       << priority_class
+       << " = "
+       << std::dec
+       << priority_class
+       << ".";
+
+    throw std::logic_error{ ss.str() };
+}
+
+string com::github::coderodde::wtpdmt::util::getThreadPriorityName(PriorityClass priority_class,
+                                                                   int thread_priority) {
+#ifndef _WIN32
+    // Linux thread priorities are plain numbers whose meaning depends on
+    // the policy:
+    return describeThreadPriority(priority_class, thread_priority);
+#else
+    (void) priority_class;
+
+    for (const ThreadPriorityName& entry : getThreadPriorityNames()) {
+        if (entry.thread_priority == thread_priority) {
+            return string(entry.name);
+        }
+    }
+
+    std::stringstream ss;
+
+    ss << "Unknown thread priority: 0x"
+       << std::hex
+       << thread_priority
+       << " = "
+       << std::dec
+       << thread_priority
+       << ".";
+
+    throw std::logic_error{ ss.str() };
+#endif
+}
@@ -0,0 +1,125 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_PRIORITY_NAMES_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_PRIORITY_NAMES_HPP
+
+#include "ThreadControl.h"
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifndef _WIN32
+#include <sched.h>
+#endif
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	using std::string;
+
+	// Priority class names:
+	inline constexpr std::string_view ABOVE_NORMAL_PRIORITY_CLASS_STR   = "ABOVE_NORMAL_PRIORITY_CLASS";   // 0x00008000
+	inline constexpr std::string_view BELOW_NORMAL_PRIORITY_CLASS_STR   = "BELOW_NORMAL_PRIORITY_CLASS";   // 0x00004000
+	inline constexpr std::string_view HIGH_PRIORITY_CLASS_STR           = "HIGH_PRIORITY_CLASS";           // 0x00000080
+	inline constexpr std::string_view IDLE_PRIORITY_CLASS_STR           = "IDLE_PRIORITY_CLASS";           // 0x00000040
+	inline constexpr std::string_view NORMAL_PRIORITY_CLASS_STR         = "NORMAL_PRIORITY_CLASS";         // 0x00000020
+	inline constexpr std::string_view PROCESS_MODE_BACKGROUND_BEGIN_STR = "PROCESS_MODE_BACKGROUND_BEGIN"; // 0x00100000
+	inline constexpr std::string_view PROCESS_MODE_BACKGROUND_END_STR   = "PROCESS_MODE_BACKGROUND_END";   // 0x00200000
+	inline constexpr std::string_view REALTIME_PRIORITY_CLASS_STR       = "REALTIME_PRIORITY_CLASS";       // 0x00000100
+
+	// Thread priority names:
+	inline constexpr std::string_view THREAD_MODE_BACKGROUND_BEGIN_STR  = "THREAD_MODE_BACKGROUND_BEGIN";  // 0x0010000
+	inline constexpr std::string_view THREAD_MODE_BACKGROUND_END_STR    = "THREAD_MODE_BACKGROUND_END";    // 0x00020000
+	inline constexpr std::string_view THREAD_PRIORITY_ABOVE_NORMAL_STR  = "THREAD_PRIORITY_ABOVE_NORMAL";  // 1
+	inline constexpr std::string_view THREAD_PRIORITY_BELOW_NORMAL_STR  = "THREAD_PRIORITY_BELOW_NORMAL";  // -1
+	inline constexpr std::string_view THREAD_PRIORITY_HIGHEST_STR       = "THREAD_PRIORITY_HIGHEST";       // 2
+	inline constexpr std::string_view THREAD_PRIORITY_IDLE_STR          = "THREAD_PRIORITY_IDLE";          // -15
+	inline constexpr std::string_view THREAD_PRIORITY_LOWEST_STR        = "THREAD_PRIORITY_LOWEST";        // -2
+	inline constexpr std::string_view THREAD_PRIORITY_NORMAL_STR        = "THREAD_PRIORITY_NORMAL";        // 0
+	inline constexpr std::string_view THREAD_PRIORITY_TIME_CRITICAL_STR = "THREAD_PRIORITY_TIME_CRITICAL"; // 15
+
+#ifndef _WIN32
+	// Scheduling policy names:
+	inline constexpr std::string_view SCHED_BATCH_STR    = "SCHED_BATCH";
+	inline constexpr std::string_view SCHED_DEADLINE_STR = "SCHED_DEADLINE";
+	inline constexpr std::string_view SCHED_FIFO_STR     = "SCHED_FIFO";
+	inline constexpr std::string_view SCHED_IDLE_STR     = "SCHED_IDLE";
+	inline constexpr std::string_view SCHED_OTHER_STR    = "SCHED_OTHER";
+	inline constexpr std::string_view SCHED_RR_STR       = "SCHED_RR";
+
+	constexpr int MINIMUM_NICE = -20;
+	constexpr int MAXIMUM_NICE = 19;
+
+	// How the Windows names translate on Linux. A priority class becomes
+	// the scheduling policy of the thread:
+	//
+	//   IDLE_PRIORITY_CLASS, PROCESS_MODE_BACKGROUND_BEGIN       -> SCHED_IDLE
+	//   BELOW_NORMAL_PRIORITY_CLASS                              -> SCHED_BATCH
+	//   NORMAL_PRIORITY_CLASS, ABOVE_NORMAL_PRIORITY_CLASS,
+	//   PROCESS_MODE_BACKGROUND_END                              -> SCHED_OTHER
+	//   HIGH_PRIORITY_CLASS                                      -> SCHED_RR
+	//   REALTIME_PRIORITY_CLASS                                  -> SCHED_FIFO
+	inline constexpr std::pair<std::string_view, int> PRIORITY_CLASS_POLICY_MAPPING[] = {
+		{ IDLE_PRIORITY_CLASS_STR,           SCHED_IDLE  },
+		{ PROCESS_MODE_BACKGROUND_BEGIN_STR, SCHED_IDLE  },
+		{ BELOW_NORMAL_PRIORITY_CLASS_STR,   SCHED_BATCH },
+		{ NORMAL_PRIORITY_CLASS_STR,         SCHED_OTHER },
+		{ ABOVE_NORMAL_PRIORITY_CLASS_STR,   SCHED_OTHER },
+		{ PROCESS_MODE_BACKGROUND_END_STR,   SCHED_OTHER },
+		{ HIGH_PRIORITY_CLASS_STR,           SCHED_RR    },
+		{ REALTIME_PRIORITY_CLASS_STR,       SCHED_FIFO  },
+	};
+
+	// A thread priority becomes a nice level under SCHED_OTHER and
+	// SCHED_BATCH and a real-time priority under SCHED_FIFO and SCHED_RR:
+	struct ThreadPriorityMapping {
+		std::string_view name;
+		int    nice;
+		int    realtime_priority;
+	};
+
+	inline constexpr ThreadPriorityMapping THREAD_PRIORITY_MAPPING[] = {
+		{ THREAD_PRIORITY_IDLE_STR,           19,  1 },
+		{ THREAD_MODE_BACKGROUND_BEGIN_STR,   19,  1 },
+		{ THREAD_PRIORITY_LOWEST_STR,         10, 20 },
+		{ THREAD_PRIORITY_BELOW_NORMAL_STR,    5, 40 },
+		{ THREAD_PRIORITY_NORMAL_STR,          0, 50 },
+		{ THREAD_MODE_BACKGROUND_END_STR,      0, 50 },
+		{ THREAD_PRIORITY_ABOVE_NORMAL_STR,   -5, 60 },
+		{ THREAD_PRIORITY_HIGHEST_STR,       -10, 80 },
+		{ THREAD_PRIORITY_TIME_CRITICAL_STR, -20, 99 },
+	};
+
+	bool isRealtimePolicy(int policy);
+
+	// "nice 5", "real-time priority 80" or "no thread priority":
+	string describeThreadPriority(PriorityClass priority_class, int thread_priority);
+#endif
+
+	struct PriorityClassName {
+		std::string_view name;
+		PriorityClass    priority_class;
+	};
+
+	struct ThreadPriorityName {
+		std::string_view name;
+		int              thread_priority;
+	};
+
+	// The native names, sorted by name: *_PRIORITY_CLASS on Windows,
+	// SCHED_* on Linux. The tables are constant, so looking up a name
+	// allocates nothing.
+	std::span<const PriorityClassName> getPriorityClassNames();
+
+	// THREAD_PRIORITY_* on Windows; empty on Linux, where the names mean
+	// different values under different policies.
+	std::span<const ThreadPriorityName> getThreadPriorityNames();
+
+	// Look up a name; on Linux the Windows names are accepted too. Neither
+	// parses numbers.
+	bool findPriorityClass(std::string_view name, PriorityClass* priority_class);
+	bool findThreadPriority(std::string_view name, PriorityClass priority_class, int* thread_priority);
+
+	// Throw std::logic_error for values without a name.
+	string getPriorityClassName(PriorityClass priority_class);
+	string getThreadPriorityName(PriorityClass priority_class, int thread_priority);
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_PRIORITY_NAMES_HPP
@@ -0,0 +1,118 @@
+#include "ProbeMode.h"
+#include "JitterProbe.h"
+#include "LatencyTable.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::JitterProbe;
+using com::github::coderodde::wtpdmt::JitterProbeEvent;
+using com::github::coderodde::wtpdmt::JitterProbeOptions;
+using com::github::coderodde::wtpdmt::JitterSnapshot;
+using com::github::coderodde::wtpdmt::JitterStatistics;
+using com::github::coderodde::wtpdmt::LatencySummary;
+
+// The percentiles a JitterStatistics holds:
+static const std::vector<double> PERCENTILES = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+
+// The callback keeps the worst gap; like the probe, it must not allocate.
+static std::atomic<uint64_t> worst_gap_nanoseconds{ 0 };
+
+static void OnThresholdExceeded(const JitterProbeEvent& event) {
+    if (event.gap_nanoseconds > worst_gap_nanoseconds.load(std::memory_order_relaxed)) {
+        worst_gap_nanoseconds.store(event.gap_nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+static LatencySummary Summarize(const JitterStatistics& statistics) {
+    LatencySummary summary;
+    summary.samples                        = statistics.samples;
+    summary.minimum_nanoseconds            = statistics.minimum_nanoseconds;
+    summary.mean_nanoseconds               = statistics.mean_nanoseconds;
+    summary.standard_deviation_nanoseconds = statistics.standard_deviation_nanoseconds;
+    summary.percentile_nanoseconds         = { statistics.p50_nanoseconds,
+                                               statistics.p90_nanoseconds,
+                                               statistics.p99_nanoseconds,
+                                               statistics.p99_9_nanoseconds,
+                                               statistics.p99_99_nanoseconds };
+    summary.maximum_nanoseconds            = statistics.maximum_nanoseconds;
+    return summary;
+}
+
+void com::github::coderodde::wtpdmt::runProbeMode(const ProbeConfiguration& configuration) {
+    JitterProbeOptions options;
+    options.clock_source          = configuration.clock_source;
+    options.cpu                   = configuration.cpu;
+    options.priority_class        = configuration.priority_class;
+    options.thread_priority       = configuration.thread_priority;
+    options.threshold_nanoseconds = configuration.threshold_nanoseconds;
+    options.on_threshold_exceeded = OnThresholdExceeded;
+
+    JitterProbe probe(options);
+
+    std::chrono::milliseconds duration{ configuration.duration_milliseconds };
+    std::chrono::milliseconds interval{ configuration.snapshot_interval_milliseconds };
+    std::vector<JitterSnapshot> snapshots;
+    std::vector<double> snapshot_seconds;
+
+    // Room for every snapshot, so that taking one does not allocate:
+    size_t snapshot_count = static_cast<size_t>(duration / interval) + 1;
+    snapshots.reserve(snapshot_count);
+    snapshot_seconds.reserve(snapshot_count);
+
+    // Like the live reporter, stay out of the probe's way. On a core shared
+    // with a real-time probe this thread only runs in the time real-time
+    // throttling leaves to the others, so it must not be real-time itself.
+    // The probe thread sets its own priority.
+    util::setCurrentThreadBackgroundPriority();
+    probe.start();
+
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point end_time = start_time + duration;
+    std::chrono::steady_clock::time_point next_snapshot_time = start_time + interval;
+
+    while (next_snapshot_time < end_time) {
+        std::this_thread::sleep_until(next_snapshot_time);
+        snapshots.push_back(probe.snapshot());
+        snapshot_seconds.push_back(std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start_time).count());
+        next_snapshot_time += interval;
+    }
+
+    std::this_thread::sleep_until(end_time);
+    probe.stop();
+
+    JitterSnapshot last_snapshot = probe.snapshot();
+
+    std::cout << "INFO: Probe clock is " << probe.getClock().getName()
+              << ", threshold " << configuration.threshold_nanoseconds << " ns.\n\n";
+
+    std::vector<string> labels;
+    std::vector<LatencySummary> rows;
+
+    for (size_t i = 0; i < snapshots.size(); i++) {
+        std::stringstream label;
+        label << std::fixed << std::setprecision(3) << snapshot_seconds[i];
+        labels.push_back(label.str());
+        rows.push_back(Summarize(snapshots[i].since_last_snapshot));
+    }
+
+    labels.push_back("end");
+    rows.push_back(Summarize(last_snapshot.since_last_snapshot));
+    labels.push_back("total");
+    rows.push_back(Summarize(last_snapshot.since_start));
+
+    printLatencyTable("Time (s)", labels, rows, PERCENTILES);
+
+    std::cout << "\nINFO: " << last_snapshot.since_start.threshold_exceeded
+              << " gaps exceeded the threshold; the worst the callback saw was "
+              << worst_gap_nanoseconds.load()
+              << " ns.\n";
+}
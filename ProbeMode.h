@@ -0,0 +1,25 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_PROBE_MODE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_PROBE_MODE_HPP
+
+#include "Clock.h"
+#include "ThreadControl.h"
+#include <cstdint>
+
+namespace com::github::coderodde::wtpdmt {
+
+	struct ProbeConfiguration {
+		util::ClockSource   clock_source;
+		util::PriorityClass priority_class;
+		int                 thread_priority;
+		int                 cpu; // UNPINNED_PROBE_CPU if not pinned.
+		uint64_t            duration_milliseconds;
+		uint64_t            snapshot_interval_milliseconds;
+		uint64_t            threshold_nanoseconds;
+	};
+
+	// Runs a JitterProbe the way an embedding process would: start it,
+	// take a snapshot every interval, stop it. wtprobetest checks the
+	// library's promise not to allocate in between.
+	void runProbeMode(const ProbeConfiguration& configuration);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_PROBE_MODE_HPP
@@ -0,0 +1,282 @@
+#include "Report.h"
+#include "LatencyTable.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::util::Clock;
+using com::github::coderodde::wtpdmt::util::Histogram;
+
+static const int TABLE_COLUMN_WIDTH = 12;
+
+void com::github::coderodde::wtpdmt::printGapStatistics(const Histogram& histogram,
+                                                        const Clock& clock,
+                                                        const std::vector<double>& percentiles) {
+    double nanoseconds_per_tick = clock.getNanosecondsPerTick();
+
+    std::cout << std::fixed << std::setprecision(1) << std::setfill(' ');
+
+    std::cout << "INFO: Samples:            " << histogram.getCount() << "\n";
+    std::cout << "INFO: Minimum gap:        " << clock.ticksToNanoseconds(histogram.getMinimum()) << " ns\n";
+    std::cout << "INFO: Mean gap:           " << histogram.getMean() * nanoseconds_per_tick << " ns\n";
+    std::cout << "INFO: Standard deviation: " << histogram.getStandardDeviation() * nanoseconds_per_tick << " ns\n";
+
+    for (double percentile : percentiles) {
+        std::stringstream label;
+        label << getPercentileLabel(percentile) << ":";
+
+        std::cout << "INFO: "
+                  << std::setw(20)
+                  << std::left
+                  << label.str()
+                  << std::right
+                  << clock.ticksToNanoseconds(histogram.getValueAtPercentile(percentile))
+                  << " ns\n";
+    }
+
+    std::cout << std::defaultfloat;
+}
+
+void com::github::coderodde::wtpdmt::printHistogramTable(const string& label_title,
+                                                         const std::vector<string>& labels,
+                                                         const std::vector<const Histogram*>& histograms,
+                                                         const Clock& clock,
+                                                         const std::vector<double>& percentiles) {
+    printHistogramTable(label_title, labels, histograms, clock.getNanosecondsPerTick(), percentiles);
+}
+
+void com::github::coderodde::wtpdmt::printPercentileMatrix(const string& row_title,
+                                                           const std::vector<string>& row_labels,
+                                                           const std::vector<string>& column_labels,
+                                                           const std::vector<std::vector<const Histogram*>>& cells,
+                                                           const Clock& clock,
+                                                           double percentile) {
+    int row_label_width = static_cast<int>(row_title.length()) + 2;
+    int column_width = TABLE_COLUMN_WIDTH;
+
+    for (const string& label : row_labels) {
+        row_label_width = (std::max)(row_label_width, static_cast<int>(label.length()) + 2);
+    }
+
+    for (const string& label : column_labels) {
+        column_width = (std::max)(column_width, static_cast<int>(label.length()) + 2);
+    }
+
+    std::cout << std::right << std::setfill(' ') << std::setw(row_label_width) << row_title;
+
+    for (const string& label : column_labels) {
+        std::cout << std::setw(column_width) << label;
+    }
+
+    std::cout << "  (" << (percentile >= 100.0 ? string("Max") : getPercentileLabel(percentile)) << ", ns)\n";
+
+    for (size_t row = 0; row < row_labels.size(); row++) {
+        std::cout << std::setw(row_label_width) << row_labels[row];
+
+        for (const Histogram* histogram : cells[row]) {
+            if (histogram == nullptr) {
+                std::cout << std::setw(column_width) << "-";
+            } else {
+                std::cout << std::setw(column_width)
+                          << clock.ticksToNanoseconds(percentile >= 100.0
+                                                      ? histogram->getMaximum()
+                                                      : histogram->getValueAtPercentile(percentile));
+            }
+        }
+
+        std::cout << "\n";
+    }
+}
+
+void com::github::coderodde::wtpdmt::printThreadTable(
+        const std::vector<std::unique_ptr<ThreadStatistics>>& statistics,
+        const Histogram& aggregate,
+        const Clock& clock,
+        const std::vector<double>& percentiles) {
+
+    std::vector<string> labels;
+    std::vector<const Histogram*> histograms;
+    bool migrated = false;
+
+    for (const auto& thread_statistics : statistics) {
+        std::stringstream label;
+
+        if (thread_statistics->requested_cpu == UNPINNED_CPU) {
+            label << "-";
+        } else {
+            label << thread_statistics->requested_cpu;
+        }
+
+        // Flag unpinned threads that the scheduler moved during the run:
+        if (thread_statistics->first_cpu != thread_statistics->last_cpu) {
+            label << "*";
+            migrated = true;
+        }
+
+        labels.push_back(label.str());
+        histograms.push_back(&thread_statistics->histogram);
+    }
+
+    labels.push_back("all");
+    histograms.push_back(&aggregate);
+
+    printHistogramTable("CPU", labels, histograms, clock, percentiles);
+
+    if (migrated) {
+        std::cout << "  * The thread ran on another CPU at the end of the run than at its start.\n";
+    }
+
+    std::cout << "\n";
+}
+
+void com::github::coderodde::wtpdmt::printLoopCalibration(const std::vector<std::unique_ptr<ThreadStatistics>>& statistics,
+                                                          const Histogram& aggregate,
+                                                          const Clock& clock,
+                                                          const std::vector<double>& percentiles) {
+    LoopCalibration calibration = statistics[0]->loop_calibration;
+
+    for (const auto& thread_statistics : statistics) {
+        calibration.iteration_ticks   = (std::min)(calibration.iteration_ticks,
+                                                   thread_statistics->loop_calibration.iteration_ticks);
+        calibration.minimum_gap_ticks = (std::min)(calibration.minimum_gap_ticks,
+                                                   thread_statistics->loop_calibration.minimum_gap_ticks);
+    }
+
+    double loop_cost_nanoseconds = calibration.iteration_ticks * clock.getNanosecondsPerTick();
+
+    std::cout << std::fixed << std::setprecision(1) << std::setfill(' ');
+
+    std::cout << "INFO: Loop cost:          " << loop_cost_nanoseconds << " ns per iteration\n";
+    std::cout << "INFO: Smallest gap:       " << clock.ticksToNanoseconds(calibration.minimum_gap_ticks)
+              << " ns (nothing shorter can be resolved)\n";
+
+    // A single iteration may come in below the calibrated mean:
+    for (double percentile : percentiles) {
+        double value = static_cast<double>(clock.ticksToNanoseconds(aggregate.getValueAtPercentile(percentile)));
+        std::stringstream label;
+        label << getPercentileLabel(percentile) << " net:";
+
+        std::cout << "INFO: "
+                  << std::setw(20)
+                  << std::left
+                  << label.str()
+                  << std::right
+                  << (std::max)(0.0, value - loop_cost_nanoseconds)
+                  << " ns\n";
+    }
+
+    std::cout << std::defaultfloat;
+}
+
+void com::github::coderodde::wtpdmt::printGapAttribution(const std::vector<std::unique_ptr<ThreadStatistics>>& statistics,
+                                                         const Clock& clock) {
+    GapAttributionStatistics total{};
+
+    for (const auto& thread_statistics : statistics) {
+        const GapAttributionStatistics& attribution = thread_statistics->gap_attribution;
+
+        for (size_t i = 0; i < GAP_CAUSE_COUNT; i++) {
+            total.gaps[i]              += attribution.gaps[i];
+            total.gap_ticks[i]         += attribution.gap_ticks[i];
+            total.largest_gap_ticks[i]  = (std::max)(total.largest_gap_ticks[i], attribution.largest_gap_ticks[i]);
+            total.interrupts[i]        += attribution.interrupts[i];
+        }
+    }
+
+    std::cout << "\n"
+              << std::setfill(' ')
+              << std::left
+              << std::setw(20) << "Cause"
+              << std::right
+              << std::setw(TABLE_COLUMN_WIDTH) << "Gaps"
+              << std::setw(TABLE_COLUMN_WIDTH + 4) << "Total (ns)"
+              << std::setw(TABLE_COLUMN_WIDTH + 4) << "Largest (ns)"
+              << std::setw(TABLE_COLUMN_WIDTH) << "Interrupts"
+              << "\n";
+
+    for (size_t i = 0; i < GAP_CAUSE_COUNT; i++) {
+        std::cout << std::left
+                  << std::setw(20) << getGapCauseName(static_cast<GapCause>(i))
+                  << std::right
+                  << std::setw(TABLE_COLUMN_WIDTH) << total.gaps[i]
+                  << std::setw(TABLE_COLUMN_WIDTH + 4) << clock.ticksToNanoseconds(total.gap_ticks[i])
+                  << std::setw(TABLE_COLUMN_WIDTH + 4) << clock.ticksToNanoseconds(total.largest_gap_ticks[i])
+                  << std::setw(TABLE_COLUMN_WIDTH) << total.interrupts[i]
+                  << "\n";
+    }
+
+    std::cout << "\n";
+}
+
+void com::github::coderodde::wtpdmt::printPowerStates(const string& row_title,
+                                                      const std::vector<string>& row_labels,
+                                                      const std::vector<PowerStateStatistics>& rows,
+                                                      const Clock& clock) {
+    int label_column_width = static_cast<int>(row_title.length()) + 2;
+
+    for (const string& label : row_labels) {
+        label_column_width = (std::max)(label_column_width, static_cast<int>(label.length()) + 2);
+    }
+
+    std::cout << "\n"
+              << std::setfill(' ')
+              << std::left
+              << std::setw(label_column_width) << row_title
+              << std::right
+              << std::setw(TABLE_COLUMN_WIDTH) << "Gaps";
+
+    for (size_t i = 0; i < POWER_STATE_COUNT; i++) {
+        std::cout << std::setw(TABLE_COLUMN_WIDTH + 2) << getPowerStateName(static_cast<PowerState>(i)) + " %";
+    }
+
+    std::cout << std::setw(TABLE_COLUMN_WIDTH + 4) << "Halted max (ns)"
+              << std::setw(TABLE_COLUMN_WIDTH) << "Frequency %"
+              << std::setw(TABLE_COLUMN_WIDTH) << "Migrations"
+              << "\n";
+
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (size_t row = 0; row < rows.size(); row++) {
+        const PowerStateStatistics& statistics = rows[row];
+        uint64_t gaps = 0;
+        uint64_t gap_ticks = 0;
+
+        for (size_t i = 0; i < POWER_STATE_COUNT; i++) {
+            gaps      += statistics.gaps[i];
+            gap_ticks += statistics.gap_ticks[i];
+        }
+
+        std::cout << std::left
+                  << std::setw(label_column_width) << row_labels[row]
+                  << std::right
+                  << std::setw(TABLE_COLUMN_WIDTH) << gaps;
+
+        // Shares of the time of the classified gaps:
+        for (size_t i = 0; i < POWER_STATE_COUNT; i++) {
+            double share = gap_ticks == 0
+                         ? 0.0
+                         : 100.0 * static_cast<double>(statistics.gap_ticks[i]) / static_cast<double>(gap_ticks);
+
+            std::cout << std::setw(TABLE_COLUMN_WIDTH + 2) << share;
+        }
+
+        std::cout << std::setw(TABLE_COLUMN_WIDTH + 4)
+                  << clock.ticksToNanoseconds(statistics.largest_gap_ticks[static_cast<size_t>(PowerState::HALTED)]);
+
+        if (statistics.frequency_samples == 0) {
+            std::cout << std::setw(TABLE_COLUMN_WIDTH) << "-";
+        } else {
+            std::cout << std::setw(TABLE_COLUMN_WIDTH)
+                      << 100.0 * statistics.frequency_ratio_sum / static_cast<double>(statistics.frequency_samples);
+        }
+
+        std::cout << std::setw(TABLE_COLUMN_WIDTH) << statistics.migrations << "\n";
+    }
+
+    std::cout << std::defaultfloat << "\n";
+}
@@ -0,0 +1,58 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_REPORT_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_REPORT_HPP
+
+#include "Clock.h"
+#include "Histogram.h"
+#include "Measurement.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	void printGapStatistics(const util::Histogram& histogram,
+							const util::Clock& clock,
+							const std::vector<double>& percentiles);
+
+	// printHistogramTable() of LatencyTable.h for histograms of the
+	// clock's ticks.
+	void printHistogramTable(const std::string& label_title,
+							 const std::vector<std::string>& labels,
+							 const std::vector<const util::Histogram*>& histograms,
+							 const util::Clock& clock,
+							 const std::vector<double>& percentiles);
+
+	// Prints one value per cell of a row-by-column grid: the latency at
+	// 'percentile', or the maximum for 100. Null cells print as "-".
+	void printPercentileMatrix(const std::string& row_title,
+							   const std::vector<std::string>& row_labels,
+							   const std::vector<std::string>& column_labels,
+							   const std::vector<std::vector<const util::Histogram*>>& cells,
+							   const util::Clock& clock,
+							   double percentile);
+
+	void printThreadTable(const std::vector<std::unique_ptr<ThreadStatistics>>& statistics,
+						  const util::Histogram& aggregate,
+						  const util::Clock& clock,
+						  const std::vector<double>& percentiles);
+
+	// Prints the loop calibration of the measuring threads and the
+	// percentiles of 'aggregate' net of the loop's own cost per iteration.
+	// The cheapest thread's figures stand for all of them.
+	void printLoopCalibration(const std::vector<std::unique_ptr<ThreadStatistics>>& statistics,
+							  const util::Histogram& aggregate,
+							  const util::Clock& clock,
+							  const std::vector<double>& percentiles);
+
+	// Prints the attributed gaps of all measuring threads by cause.
+	void printGapAttribution(const std::vector<std::unique_ptr<ThreadStatistics>>& statistics,
+							 const util::Clock& clock);
+
+	// Prints one row per entry of 'rows': how many gaps each power state
+	// explains, its share of their time, and the mean frequency around them.
+	void printPowerStates(const std::string& row_title,
+						  const std::vector<std::string>& row_labels,
+						  const std::vector<PowerStateStatistics>& rows,
+						  const util::Clock& clock);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_REPORT_HPP
@@ -0,0 +1,185 @@
+#include "RunSetup.h"
+#include "MemoryControl.h"
+#include "PowerControl.h"
+#include "ThreadControl.h"
+#include "TimerResolution.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#ifndef _WIN32
+#include <sched.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::PowerCounterSource;
+using com::github::coderodde::wtpdmt::RunSetup;
+using com::github::coderodde::wtpdmt::util::Clock;
+using com::github::coderodde::wtpdmt::util::ClockSource;
+using com::github::coderodde::wtpdmt::util::CommandLineParser;
+using com::github::coderodde::wtpdmt::util::MeasurementMode;
+using com::github::coderodde::wtpdmt::util::TimerResolution;
+
+void com::github::coderodde::wtpdmt::printTimerResolution(const string& when) {
+    TimerResolution timer_resolution = util::getTimerResolution();
+
+    std::cout << "INFO: " << when << " the "
+              << util::getTimerResolutionName()
+              << " is "
+              << timer_resolution.current_nanoseconds
+              << " ns";
+
+    if (timer_resolution.finest_nanoseconds != 0) {
+        std::cout << " (finest "
+                  << timer_resolution.finest_nanoseconds
+                  << " ns, coarsest "
+                  << timer_resolution.coarsest_nanoseconds
+                  << " ns)";
+    }
+
+    std::cout << ".\n";
+}
+
+RunSetup com::github::coderodde::wtpdmt::setUpRun(CommandLineParser& clp) {
+    string priority_class_name  = clp.getPriorityClassName(clp.getPriorityClass());
+    string thread_priority_name = clp.getThreadPriorityName(clp.getThreadPriority());
+
+    size_t field_length = (std::max)(priority_class_name.length(),
+                                     thread_priority_name.length());
+
+    std::cout << "Number of iterations:      "
+              << clp.getNumberOfIterations()
+              << "\n";
+
+    std::cout << "Requested priority class:  "
+              << std::setw(field_length)
+              << std::left
+              << std::setfill(' ')
+              << priority_class_name
+              << " (0x"
+              << std::setw(8)
+              << std::right
+              << std::setfill('0')
+              << std::hex
+              << clp.getPriorityClass()
+              << " = "
+              << std::dec
+              << clp.getPriorityClass()
+              << ")\n";
+
+    std::cout << "Requested thread priority: "
+              << std::setw(field_length)
+              << std::left
+              << std::setfill(' ')
+              << thread_priority_name
+              << " (0x"
+              << std::setw(8)
+              << std::right
+              << std::setfill('0')
+              << std::hex
+              << clp.getThreadPriority()
+              << " = "
+              << std::dec
+              << clp.getThreadPriority()
+              << ")\n";
+
+    std::cout << "Clock source:              "
+              << Clock::getSourceName(clp.getClockSource())
+              << "\n\n";
+
+#ifndef _WIN32
+    // A sweep may switch to SCHED_DEADLINE later:
+    util::setSchedDeadlineParameters(clp.getSchedDeadlineParameters());
+#endif
+
+    // Lock before the threads exist so that their stacks are locked too:
+    util::applyMemoryPolicy(clp.getMemoryPolicy());
+    util::setProcessPriorityClass(clp.getPriorityClass());
+
+    std::cout << "INFO: Effective process class is   "
+              << clp.getPriorityClassName(util::getProcessPriorityClass())
+              << ".\n";
+
+    printTimerResolution("Before the run");
+
+    // Before any thread exists, since Linux threads inherit the slack:
+    if (clp.getTimerNanoseconds().size() == 1) {
+        util::setTimerResolution(clp.getTimerNanoseconds()[0]);
+
+        std::cout << "INFO: Requested "
+                  << util::getTimerResolutionName()
+                  << " of "
+                  << clp.getTimerNanoseconds()[0]
+                  << " ns, effective is "
+                  << util::getTimerResolution().current_nanoseconds
+                  << " ns.\n";
+    }
+
+#ifndef _WIN32
+    if (!clp.getTimerNanoseconds().empty() &&
+        (clp.getPriorityClass() == SCHED_FIFO || clp.getPriorityClass() == SCHED_RR)) {
+        std::cout << "WARNING: Real-time threads have no timer slack; "
+                  << "the setting affects the other threads only.\n";
+    }
+#endif
+
+    // Holds until the process exits:
+    if (clp.cpuLatencyRequested()) {
+        util::requestCpuLatency(clp.getCpuLatencyMicroseconds());
+
+        std::cout << "INFO: Holding "
+                  << util::getCpuLatencyRequestName()
+                  << " of "
+                  << clp.getCpuLatencyMicroseconds()
+                  << " us for the run.\n";
+    }
+
+    PowerCounterSource power_counter_source = PowerCounterSource::NONE;
+
+    if (clp.powerRequested()) {
+        power_counter_source = findPowerCounterSource();
+
+        if (power_counter_source == PowerCounterSource::NONE) {
+            std::cout << "WARNING: No power state counters are readable here; "
+                      << "gaps are not classified by power state.\n";
+        } else {
+            std::cout << "INFO: Classifying gaps of at least "
+                      << clp.getPowerThresholdNanoseconds()
+                      << " ns by power state with "
+                      << getPowerCounterSourceName(power_counter_source)
+                      << ".\n";
+        }
+    }
+
+    RunSetup setup{ Clock(clp.getClockSource()), power_counter_source };
+
+    std::cout << "INFO: Clock resolution is "
+              << setup.clock.getResolutionNanoseconds()
+              << " ns, smallest observed step is "
+              << setup.clock.getSmallestStepNanoseconds()
+              << " ns, read cost is "
+              << setup.clock.getReadCostNanoseconds()
+              << " ns.\n";
+
+    if ((setup.clock.getSource() == ClockSource::TSC || setup.clock.getSource() == ClockSource::TSCP) &&
+        !Clock::isTscInvariant()) {
+        std::cout << "WARNING: The CPU does not advertise an invariant TSC; "
+                  << "readings may drift with frequency changes.\n";
+    }
+
+    std::cout << "\n";
+
+    if ((clp.getMode() != MeasurementMode::GAPS || clp.sweepRequested()) && clp.traceRequested()) {
+        std::cout << "WARNING: Tracing covers the plain gaps mode only and is ignored.\n";
+    }
+
+    // The probe mode takes its snapshots at the report interval:
+    if ((clp.getMode() != MeasurementMode::GAPS || clp.sweepRequested()) &&
+        clp.getMode() != MeasurementMode::PROBE &&
+        clp.getReportIntervalMilliseconds() > 0) {
+        std::cout << "WARNING: Live reports cover the plain gaps mode only and are ignored.\n";
+    }
+
+    return setup;
+}
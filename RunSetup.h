@@ -0,0 +1,26 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_RUN_SETUP_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_RUN_SETUP_HPP
+
+#include "Clock.h"
+#include "CommandLineParser.h"
+#include "PowerStates.h"
+#include <string>
+
+namespace com::github::coderodde::wtpdmt {
+
+	struct RunSetup {
+		util::Clock        clock;
+		PowerCounterSource power_counter_source; // NONE unless gaps are classified by power state.
+	};
+
+	// What wt does between parsing its command line and running a mode:
+	// prints the request, applies the memory policy, the priority class,
+	// the timer resolution and the CPU latency request, finds the power
+	// counters and calibrates the clock. wtstartup times the same call.
+	RunSetup setUpRun(util::CommandLineParser& clp);
+
+	// Other processes may change the timer resolution on Windows while the
+	// run goes on, so it is shown before and after.
+	void printTimerResolution(const std::string& when);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_RUN_SETUP_HPP
@@ -0,0 +1,198 @@
+#include "SharedMemory.h"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+
+// Prefixed so that the segments of this tool are easy to tell apart in
+// /dev/shm and in the object namespace:
+static const string SHARED_MEMORY_NAME_PREFIX = "wtpdmt-";
+
+com::github::coderodde::wtpdmt::util::SharedMemory::SharedMemory(const string& name, size_t size) :
+    m_name { getSystemName(name) },
+    m_size { size },
+    m_data { nullptr },
+    m_owner{ false }
+{
+#ifdef _WIN32
+    ULARGE_INTEGER mapping_size;
+    mapping_size.QuadPart = size;
+
+    m_mapping_handle = CreateFileMappingA(INVALID_HANDLE_VALUE,
+                                          nullptr,
+                                          PAGE_READWRITE,
+                                          mapping_size.HighPart,
+                                          mapping_size.LowPart,
+                                          m_name.c_str());
+
+    if (m_mapping_handle == nullptr) {
+        throwSystemError("create");
+    }
+
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        release();
+        throw std::runtime_error{ "The shared memory segment '" + m_name + "' is already in use." };
+    }
+
+    m_owner = true;
+    m_data = static_cast<char*>(MapViewOfFile(m_mapping_handle, FILE_MAP_ALL_ACCESS, 0, 0, size));
+
+    if (m_data == nullptr) {
+        throwSystemError("map");
+    }
+#else
+    m_file_descriptor = shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+
+    if (m_file_descriptor < 0) {
+        if (errno == EEXIST) {
+            throw std::runtime_error{ "The shared memory segment '" + m_name +
+                                      "' is already in use; if no daemon runs, remove /dev/shm" + m_name + "." };
+        }
+
+        throwSystemError("create");
+    }
+
+    m_owner = true;
+
+    if (ftruncate(m_file_descriptor, static_cast<off_t>(size)) != 0) {
+        throwSystemError("size");
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_file_descriptor, 0);
+
+    if (data == MAP_FAILED) {
+        throwSystemError("map");
+    }
+
+    m_data = static_cast<char*>(data);
+#endif
+}
+
+com::github::coderodde::wtpdmt::util::SharedMemory::SharedMemory(const string& name) :
+    m_name { getSystemName(name) },
+    m_size { 0 },
+    m_data { nullptr },
+    m_owner{ false }
+{
+#ifdef _WIN32
+    m_mapping_handle = OpenFileMappingA(FILE_MAP_READ, FALSE, m_name.c_str());
+
+    if (m_mapping_handle == nullptr) {
+        throwSystemError("open");
+    }
+
+    m_data = static_cast<char*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+
+    if (m_data == nullptr) {
+        throwSystemError("map");
+    }
+
+    // The view covers whole pages; the header says how much of it is used.
+    MEMORY_BASIC_INFORMATION information;
+
+    if (VirtualQuery(m_data, &information, sizeof(information)) == 0) {
+        throwSystemError("query");
+    }
+
+    m_size = information.RegionSize;
+#else
+    m_file_descriptor = shm_open(m_name.c_str(), O_RDONLY, 0);
+
+    if (m_file_descriptor < 0) {
+        throwSystemError("open");
+    }
+
+    struct stat status;
+
+    if (fstat(m_file_descriptor, &status) != 0) {
+        throwSystemError("query");
+    }
+
+    m_size = static_cast<size_t>(status.st_size);
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_file_descriptor, 0);
+
+    if (data == MAP_FAILED) {
+        throwSystemError("map");
+    }
+
+    m_data = static_cast<char*>(data);
+#endif
+}
+
+com::github::coderodde::wtpdmt::util::SharedMemory::~SharedMemory() {
+    release();
+}
+
+char* com::github::coderodde::wtpdmt::util::SharedMemory::getData() {
+    return m_data;
+}
+
+const char* com::github::coderodde::wtpdmt::util::SharedMemory::getData() const {
+    return m_data;
+}
+
+size_t com::github::coderodde::wtpdmt::util::SharedMemory::getSize() const {
+    return m_size;
+}
+
+string com::github::coderodde::wtpdmt::util::SharedMemory::getSystemName(const string& name) {
+#ifdef _WIN32
+    return "Local\\" + SHARED_MEMORY_NAME_PREFIX + name;
+#else
+    return "/" + SHARED_MEMORY_NAME_PREFIX + name;
+#endif
+}
+
+void com::github::coderodde::wtpdmt::util::SharedMemory::release() {
+#ifdef _WIN32
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+
+    // The segment goes away with the last handle to it:
+    if (m_mapping_handle != nullptr) {
+        CloseHandle(m_mapping_handle);
+        m_mapping_handle = nullptr;
+    }
+#else
+    if (m_data != nullptr) {
+        munmap(m_data, m_size);
+    }
+
+    if (m_file_descriptor >= 0) {
+        close(m_file_descriptor);
+        m_file_descriptor = -1;
+    }
+
+    if (m_owner) {
+        shm_unlink(m_name.c_str());
+    }
+#endif
+    m_data = nullptr;
+    m_owner = false;
+}
+
+// Releases whatever the constructor got so far, since a constructor that
+// throws leaves no object for the destructor to run on.
+void com::github::coderodde::wtpdmt::util::SharedMemory::throwSystemError(const string& operation) {
+    std::stringstream ss;
+    ss << "Could not " << operation << " the shared memory segment '" << m_name << "', error code "
+#ifdef _WIN32
+       << GetLastError()
+#else
+       << errno
+#endif
+       << ".";
+
+    release();
+    throw std::runtime_error{ ss.str() };
+}
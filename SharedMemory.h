@@ -0,0 +1,58 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_SHARED_MEMORY_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_SHARED_MEMORY_HPP
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	using std::string;
+
+	// A named segment of memory shared between processes: a POSIX shared
+	// memory object on Linux, a pagefile-backed mapping in the session's
+	// Local\ namespace on Windows. The creating process owns the name and
+	// removes it when done; other processes open it read-only.
+	class SharedMemory {
+	private:
+
+		string m_name;
+		size_t m_size;
+		char*  m_data;
+		bool   m_owner;
+#ifdef _WIN32
+		HANDLE m_mapping_handle;
+#else
+		int    m_file_descriptor;
+#endif
+
+	public:
+
+		// Creates the segment, zero-filled. Fails if the name is taken.
+		SharedMemory(const string& name, size_t size);
+
+		// Opens an existing segment for reading.
+		explicit SharedMemory(const string& name);
+
+		~SharedMemory();
+
+		SharedMemory(const SharedMemory&) = delete;
+		SharedMemory& operator=(const SharedMemory&) = delete;
+
+		char* getData();
+		const char* getData() const;
+		size_t getSize() const;
+
+		// The name as the operating system knows it.
+		static string getSystemName(const string& name);
+
+	private:
+
+		void release();
+		void throwSystemError(const string& operation);
+	};
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_SHARED_MEMORY_HPP
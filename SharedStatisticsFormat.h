@@ -0,0 +1,80 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_SHARED_STATISTICS_FORMAT_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_SHARED_STATISTICS_FORMAT_HPP
+
+#include <cstdint>
+
+namespace com::github::coderodde::wtpdmt {
+
+	// Layout of the shared-memory segment a daemon publishes into (native
+	// byte order; the segment never leaves the host):
+	//
+	//   SharedStatisticsHeader                header_size bytes
+	//   thread_count blocks of thread_size bytes, each one
+	//     SharedThreadHeader
+	//     three histograms of histogram_size bytes: the last interval,
+	//     the last window_intervals intervals and everything since the
+	//     start, each a SharedHistogram followed by bucket_count uint64_t
+	//     bucket counts
+	//
+	// Gap values are in clock ticks; multiply by nanoseconds_per_tick. The
+	// buckets are those of util::Histogram with sub_bucket_bits.
+	//
+	// The daemon updates the segment under a sequence lock: 'sequence' is
+	// odd while an update is in progress and goes up by two with every
+	// update. A reader copies the segment and starts over if 'sequence' was
+	// odd before the copy or changed during it. Readers must check magic
+	// and version, and should use the size fields to step over fields
+	// added by later versions.
+
+	constexpr char     SHARED_STATISTICS_MAGIC[8] = { 'W', 'T', 'P', 'D', 'S', 'H', 'M', '\0' };
+	constexpr uint32_t SHARED_STATISTICS_VERSION  = 1;
+
+	enum class SharedStatisticsState : uint32_t {
+		RUNNING = 1,
+		STOPPED = 2 // The daemon has exited; the numbers are final.
+	};
+
+	struct SharedStatisticsHeader {
+		char     magic[8];
+		uint32_t version;
+		uint32_t header_size;
+		uint32_t thread_size;
+		uint32_t histogram_size;
+		uint32_t thread_count;
+		uint32_t bucket_count;
+		uint32_t sub_bucket_bits;
+		uint32_t clock_source;            // util::ClockSource of the daemon.
+		uint32_t interval_milliseconds;
+		uint32_t window_intervals;
+		double   nanoseconds_per_tick;
+		uint64_t process_id;
+		uint64_t start_time_nanoseconds;  // Unix epoch time of the start.
+		uint64_t sequence;
+		uint64_t update_count;            // Intervals published so far.
+		uint64_t update_time_nanoseconds; // Unix epoch time of the last update.
+		uint64_t minor_page_faults;       // Process-wide, since the start.
+		uint64_t major_page_faults;
+		uint32_t state;                   // A SharedStatisticsState.
+		uint32_t reserved;
+		uint64_t reserved2;
+	};
+
+	struct SharedThreadHeader {
+		int32_t  cpu; // -1 for an unpinned thread.
+		uint32_t reserved;
+		uint64_t reserved2;
+	};
+
+	struct SharedHistogram {
+		uint64_t count;
+		uint64_t minimum;
+		uint64_t maximum;
+		double   sum;
+		uint64_t reserved;
+	};
+
+	static_assert(sizeof(SharedStatisticsHeader) == 128, "Unexpected shared statistics header layout.");
+	static_assert(sizeof(SharedThreadHeader) == 16, "Unexpected shared thread header layout.");
+	static_assert(sizeof(SharedHistogram) == 40, "Unexpected shared histogram layout.");
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_SHARED_STATISTICS_FORMAT_HPP
@@ -0,0 +1,77 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_SPSC_RING_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_SPSC_RING_HPP
+
+#include "MemoryControl.h"
+#include "ThreadControl.h"
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	// A bounded single-producer/single-consumer queue. All storage is
+	// allocated by the constructor as measurement memory; tryPush() and
+	// tryPop() neither allocate nor block, and tryPush() reports a full
+	// queue instead of waiting.
+	template<class T>
+	class SpscRing {
+	private:
+
+		static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+					  "SpscRing stores its items in raw measurement memory.");
+
+		T*     m_slots;
+		size_t m_mask;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head; // Written by the consumer.
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail; // Written by the producer.
+
+	public:
+
+		explicit SpscRing(size_t capacity) :
+			m_slots{ nullptr },
+			m_mask { capacity - 1 },
+			m_head { 0 },
+			m_tail { 0 }
+		{
+			if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+				throw std::logic_error{ "The ring capacity must be a power of two." };
+			}
+
+			m_slots = static_cast<T*>(allocateMeasurementMemory(capacity * sizeof(T)));
+		}
+
+		~SpscRing() {
+			freeMeasurementMemory(m_slots, (m_mask + 1) * sizeof(T));
+		}
+
+		SpscRing(const SpscRing&) = delete;
+		SpscRing& operator=(const SpscRing&) = delete;
+
+		bool tryPush(const T& item) {
+			size_t tail = m_tail.load(std::memory_order_relaxed);
+
+			if (tail - m_head.load(std::memory_order_acquire) > m_mask) {
+				return false;
+			}
+
+			m_slots[tail & m_mask] = item;
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool tryPop(T& item) {
+			size_t head = m_head.load(std::memory_order_relaxed);
+
+			if (head == m_tail.load(std::memory_order_acquire)) {
+				return false;
+			}
+
+			item = m_slots[head & m_mask];
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+	};
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_SPSC_RING_HPP
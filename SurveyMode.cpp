@@ -0,0 +1,782 @@
+#include "SurveyMode.h"
+#include "Measurement.h"
+#include "Report.h"
+#include "ThreadControl.h"
+#include "Topology.h"
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <filesystem>
+#include <fstream>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::SurveyConfiguration;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+using com::github::coderodde::wtpdmt::util::Clock;
+using com::github::coderodde::wtpdmt::util::CpuLocation;
+using com::github::coderodde::wtpdmt::util::Histogram;
+
+static const int SUMMARY_COLUMN_WIDTH = 12;
+static const int LOCATION_COLUMN_WIDTH = 8;
+
+// A core noisier than this many times the median, and than the floor,
+// gains too little from isolation to be worth it.
+static const double ISOLATION_NOISE_FACTOR    = 2.0;
+static const double ISOLATION_NOISE_FLOOR_PPM = 1.0;
+
+// The housekeeping keeps at least one core in this many.
+static const size_t HOUSEKEEPING_SHARE_DIVISOR = 8;
+
+#ifdef _WIN32
+// SystemProcessorPerformanceInformation of NtQuerySystemInformation(),
+// which counts the interrupts of each CPU in the caller's group:
+static const ULONG SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION_CLASS = 8;
+
+struct ProcessorPerformanceInformation {
+    LARGE_INTEGER idle_time;
+    LARGE_INTEGER kernel_time;
+    LARGE_INTEGER user_time;
+    LARGE_INTEGER dpc_time;
+    LARGE_INTEGER interrupt_time;
+    ULONG         interrupt_count;
+};
+
+typedef LONG (NTAPI* NtQuerySystemInformationFunction)(ULONG information_class,
+                                                       PVOID information,
+                                                       ULONG length,
+                                                       PULONG returned_length);
+#endif
+
+// What the system did to one surveyed CPU.
+struct CpuNoise {
+    CpuLocation location;
+    uint64_t    noise_gaps;    // Gaps of at least the threshold.
+    double      noise_ppm;     // Their share of the measured time, per million.
+    uint64_t    maximum_ticks;
+    uint64_t    interrupts;    // Taken while it was measured.
+    string      top_interrupt; // The source of most of them; empty if unknown.
+    int         routed_irqs;   // IRQs whose affinity includes it; -1 if unknown.
+    bool        isolated;      // By isolcpus= already.
+    bool        nohz_full;
+};
+
+// The CPUs of one core, noisy as its noisiest surveyed CPU.
+struct CoreNoise {
+    int              package;
+    int              node;
+    std::vector<int> cpus;     // All of its online CPUs.
+    bool             surveyed; // Every one of them was.
+    double           noise_ppm;
+    uint64_t         maximum_ticks;
+};
+
+// Interrupts taken so far, by source and then by CPU.
+typedef std::map<string, std::vector<uint64_t>> InterruptCounts;
+
+// Formats ascending CPUs as a list parseCpuList() reads back, such as "0-3,6".
+static string FormatCpuList(const std::vector<int>& cpus) {
+    std::stringstream ss;
+
+    for (size_t i = 0; i < cpus.size();) {
+        size_t last = i;
+
+        while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1) {
+            last++;
+        }
+
+        ss << (i == 0 ? "" : ",") << cpus[i];
+
+        if (last > i) {
+            ss << "-" << cpus[last];
+        }
+
+        i = last + 1;
+    }
+
+    return ss.str();
+}
+
+#ifdef _WIN32
+static InterruptCounts ReadInterruptCounts(int cpu_slots) {
+    InterruptCounts counts;
+    FARPROC function = GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation");
+
+    if (function == nullptr) {
+        return counts;
+    }
+
+    auto query = reinterpret_cast<NtQuerySystemInformationFunction>(function);
+    std::vector<ProcessorPerformanceInformation> information(static_cast<size_t>(cpu_slots));
+    ULONG returned_length = 0;
+
+    if (query(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION_CLASS,
+              information.data(),
+              static_cast<ULONG>(information.size() * sizeof(ProcessorPerformanceInformation)),
+              &returned_length) != 0) {
+        return counts;
+    }
+
+    // Windows does not break the counts down by source:
+    std::vector<uint64_t>& row = counts[""];
+    row.resize(static_cast<size_t>(cpu_slots), 0);
+
+    for (size_t cpu = 0; cpu < returned_length / sizeof(ProcessorPerformanceInformation); cpu++) {
+        row[cpu] = information[cpu].interrupt_count;
+    }
+
+    return counts;
+}
+#else
+// Returns an empty string if the file is missing or empty.
+static string ReadFirstLine(const string& path) {
+    std::ifstream file(path);
+    string line;
+    std::getline(file, line);
+    return line;
+}
+
+// The CPUs a sysfs list file names; none if it is missing, empty or
+// reads "(null)".
+static std::vector<int> ReadCpuListFile(const string& path) {
+    string cpu_list = ReadFirstLine(path);
+
+    if (cpu_list.empty() || cpu_list[0] < '0' || cpu_list[0] > '9') {
+        return {};
+    }
+
+    return com::github::coderodde::wtpdmt::util::parseCpuList(cpu_list);
+}
+
+// Reads /proc/interrupts, whose header names a column per online CPU. The
+// numbered IRQs are named with their device, the rest (LOC, RES, CAL, TLB
+// on x86) by their mnemonic.
+static InterruptCounts ReadInterruptCounts(int cpu_slots) {
+    InterruptCounts counts;
+    std::ifstream file("/proc/interrupts");
+    string header;
+
+    if (!std::getline(file, header)) {
+        return counts;
+    }
+
+    std::istringstream header_fields(header);
+    std::vector<int> columns;
+    string column;
+
+    while (header_fields >> column) {
+        columns.push_back(column.rfind("CPU", 0) == 0 ? std::stoi(column.substr(3)) : -1);
+    }
+
+    string line;
+
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        string source;
+        fields >> source;
+
+        if (!source.empty() && source.back() == ':') {
+            source.pop_back();
+        }
+
+        std::vector<uint64_t> row(static_cast<size_t>(cpu_slots), 0);
+        size_t index = 0;
+        uint64_t value;
+
+        while (index < columns.size() && fields >> value) {
+            if (columns[index] >= 0 && columns[index] < cpu_slots) {
+                row[static_cast<size_t>(columns[index])] = value;
+            }
+
+            index++;
+        }
+
+        // ERR and MIS hold a single total:
+        if (index < columns.size()) {
+            continue;
+        }
+
+        if (!source.empty() && source[0] >= '0' && source[0] <= '9') {
+            string word;
+            string device;
+
+            while (fields >> word) {
+                device = word;
+            }
+
+            if (!device.empty()) {
+                source += " " + device;
+            }
+        }
+
+        counts[source] = std::move(row);
+    }
+
+    return counts;
+}
+
+// Counts, per CPU, the IRQs that may be delivered to it. The effective
+// affinity is what the interrupt controller was told; older kernels have
+// only the requested one.
+static std::vector<int> CountRoutedIrqs(int cpu_slots) {
+    std::vector<int> routed;
+    std::error_code error;
+    std::filesystem::directory_iterator irqs("/proc/irq", error);
+
+    if (error) {
+        return routed;
+    }
+
+    routed.resize(static_cast<size_t>(cpu_slots), 0);
+
+    for (const std::filesystem::directory_entry& irq : irqs) {
+        // Skips default_smp_affinity:
+        if (!irq.is_directory(error)) {
+            continue;
+        }
+
+        std::vector<int> cpus = ReadCpuListFile((irq.path() / "effective_affinity_list").string());
+
+        if (cpus.empty()) {
+            cpus = ReadCpuListFile((irq.path() / "smp_affinity_list").string());
+        }
+
+        for (int cpu : cpus) {
+            if (cpu < cpu_slots) {
+                routed[static_cast<size_t>(cpu)]++;
+            }
+        }
+    }
+
+    return routed;
+}
+
+static void PrintKernelIsolation() {
+    static const char* const PARAMETERS[] = {
+        "isolcpus=", "nohz_full=", "rcu_nocbs=", "irqaffinity=", "housekeeping="
+    };
+
+    std::istringstream command_line(ReadFirstLine("/proc/cmdline"));
+    string word;
+    string found;
+
+    while (command_line >> word) {
+        for (const char* parameter : PARAMETERS) {
+            if (word.rfind(parameter, 0) == 0) {
+                found += " " + word;
+            }
+        }
+    }
+
+    if (found.empty()) {
+        std::cout << "INFO: The kernel command line isolates no CPUs.\n";
+    } else {
+        std::cout << "INFO: The kernel command line has" << found << ".\n";
+    }
+}
+#endif
+
+// The gaps of at least 'threshold_ticks' in 'histogram' and their share
+// of its time, from the bucket midpoints.
+static void MeasureNoise(const Histogram& histogram,
+                         uint64_t threshold_ticks,
+                         uint64_t* noise_gaps,
+                         double* noise_ppm) {
+    double noise_ticks = 0.0;
+    *noise_gaps = 0;
+
+    for (size_t i = 0; i < Histogram::BUCKET_COUNT; i++) {
+        uint64_t count = histogram.getBucketCount(i);
+
+        if (count == 0 || Histogram::getBucketLowestValue(i) < threshold_ticks) {
+            continue;
+        }
+
+        double midpoint = 0.5 * static_cast<double>(Histogram::getBucketLowestValue(i))
+                        + 0.5 * static_cast<double>(Histogram::getBucketHighestValue(i));
+
+        *noise_gaps += count;
+        noise_ticks += static_cast<double>(count) * midpoint;
+    }
+
+    *noise_ppm = histogram.getSum() == 0.0 ? 0.0 : 1e6 * noise_ticks / histogram.getSum();
+}
+
+// The interrupts each CPU took between the two readings, and the source
+// of most of them.
+static void CountInterrupts(const InterruptCounts& before,
+                            const InterruptCounts& after,
+                            CpuNoise& noise) {
+    size_t cpu = static_cast<size_t>(noise.location.cpu);
+    uint64_t top_count = 0;
+
+    for (const auto& [source, counts] : after) {
+        auto earlier = before.find(source);
+        uint64_t start = earlier == before.end() ? 0 : earlier->second[cpu];
+        uint64_t count = counts[cpu] >= start ? counts[cpu] - start : 0;
+
+        noise.interrupts += count;
+
+        if (count > top_count) {
+            top_count = count;
+            noise.top_interrupt = source;
+        }
+    }
+}
+
+// Compares the mean noise of the CPUs for which 'selected' holds with
+// that of the others, if there are both.
+template<class Predicate>
+static void PrintNoiseComparison(const std::vector<CpuNoise>& noises,
+                                 const string& description,
+                                 Predicate selected) {
+    double selected_ppm = 0.0;
+    double other_ppm = 0.0;
+    size_t selected_cpus = 0;
+
+    for (const CpuNoise& noise : noises) {
+        if (selected(noise)) {
+            selected_ppm += noise.noise_ppm;
+            selected_cpus++;
+        } else {
+            other_ppm += noise.noise_ppm;
+        }
+    }
+
+    size_t other_cpus = noises.size() - selected_cpus;
+
+    if (selected_cpus == 0 || other_cpus == 0) {
+        return;
+    }
+
+    std::cout << "INFO: The " << selected_cpus << " CPUs " << description
+              << " lost " << selected_ppm / static_cast<double>(selected_cpus)
+              << " ppm on average, the " << other_cpus << " others "
+              << other_ppm / static_cast<double>(other_cpus) << " ppm.\n";
+}
+
+static void PrintRanking(const std::vector<CoreNoise>& cores,
+                         const std::map<int, const CpuNoise*>& noise_by_cpu,
+                         const Clock& clock) {
+    std::cout << "\nCores from the quietest; noise is the gaps of at least the threshold:\n"
+              << std::setfill(' ')
+              << std::right
+              << std::setw(LOCATION_COLUMN_WIDTH) << "Rank"
+              << std::setw(LOCATION_COLUMN_WIDTH) << "CPU"
+              << std::setw(LOCATION_COLUMN_WIDTH) << "Package"
+              << std::setw(LOCATION_COLUMN_WIDTH) << "Node"
+              << std::setw(LOCATION_COLUMN_WIDTH) << "Core"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "Noise gaps"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "Noise ppm"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "Max (ns)"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "Interrupts"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "IRQs routed"
+              << std::setw(SUMMARY_COLUMN_WIDTH) << "Kernel"
+              << "  Most interrupts\n";
+
+    std::cout << std::fixed << std::setprecision(1);
+    size_t rank = 0;
+
+    for (const CoreNoise& core : cores) {
+        rank++;
+
+        for (int cpu : core.cpus) {
+            auto entry = noise_by_cpu.find(cpu);
+
+            if (entry == noise_by_cpu.end()) {
+                continue;
+            }
+
+            const CpuNoise& noise = *entry->second;
+            string kernel = noise.isolated && noise.nohz_full ? "isol,nohz"
+                          : noise.isolated                    ? "isolated"
+                          : noise.nohz_full                   ? "nohz_full"
+                          :                                     "-";
+
+            std::cout << std::setw(LOCATION_COLUMN_WIDTH) << rank
+                      << std::setw(LOCATION_COLUMN_WIDTH) << cpu
+                      << std::setw(LOCATION_COLUMN_WIDTH) << noise.location.package
+                      << std::setw(LOCATION_COLUMN_WIDTH) << noise.location.node
+                      << std::setw(LOCATION_COLUMN_WIDTH) << noise.location.core
+                      << std::setw(SUMMARY_COLUMN_WIDTH) << noise.noise_gaps
+                      << std::setw(SUMMARY_COLUMN_WIDTH) << noise.noise_ppm
+                      << std::setw(SUMMARY_COLUMN_WIDTH) << clock.ticksToNanoseconds(noise.maximum_ticks)
+                      << std::setw(SUMMARY_COLUMN_WIDTH) << noise.interrupts;
+
+            if (noise.routed_irqs < 0) {
+                std::cout << std::setw(SUMMARY_COLUMN_WIDTH) << "-";
+            } else {
+                std::cout << std::setw(SUMMARY_COLUMN_WIDTH) << noise.routed_irqs;
+            }
+
+            std::cout << std::setw(SUMMARY_COLUMN_WIDTH) << kernel
+                      << "  " << (noise.top_interrupt.empty() ? "-" : noise.top_interrupt) << "\n";
+        }
+    }
+
+    std::cout << std::defaultfloat;
+}
+
+#ifdef _WIN32
+// Maps the CPUs of group 0 to the IDs of their CPU sets.
+static std::map<int, DWORD> GetCpuSetIds() {
+    std::map<int, DWORD> ids;
+    ULONG length = 0;
+    GetSystemCpuSetInformation(nullptr, 0, &length, GetCurrentProcess(), 0);
+    std::vector<char> buffer(length);
+
+    if (length == 0 ||
+        !GetSystemCpuSetInformation(reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.data()),
+                                    length,
+                                    &length,
+                                    GetCurrentProcess(),
+                                    0)) {
+        return ids;
+    }
+
+    for (ULONG offset = 0; offset < length;) {
+        auto information = reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.data() + offset);
+
+        if (information->Type == CpuSetInformation && information->CpuSet.Group == 0) {
+            ids[information->CpuSet.LogicalProcessorIndex] = information->CpuSet.Id;
+        }
+
+        offset += information->Size;
+    }
+
+    return ids;
+}
+
+static string FormatCpuSetIds(const std::map<int, DWORD>& ids, const std::vector<int>& cpus) {
+    std::stringstream ss;
+
+    for (int cpu : cpus) {
+        auto id = ids.find(cpu);
+        ss << (ss.tellp() == 0 ? "" : ",") << (id == ids.end() ? string("?") : std::to_string(id->second));
+    }
+
+    return ss.str();
+}
+#endif
+
+// Isolates the quiet cores and keeps the rest for the housekeeping: the
+// cores noisier than a bound from the median, which would gain least, at
+// least a core per package and per NUMA node, and the noisiest of the
+// others until the housekeeping has its share of the cores.
+static void PrintIsolationSuggestion(const std::vector<CoreNoise>& cores,
+                                     const std::vector<CpuLocation>& locations) {
+    // The cores come from the quietest, the surveyed ones first:
+    std::vector<double> surveyed_ppm;
+
+    for (const CoreNoise& core : cores) {
+        if (core.surveyed) {
+            surveyed_ppm.push_back(core.noise_ppm);
+        }
+    }
+
+    double median_ppm = 0.0;
+
+    if (!surveyed_ppm.empty()) {
+        size_t middle = surveyed_ppm.size() / 2;
+        median_ppm = surveyed_ppm.size() % 2 == 1
+                   ? surveyed_ppm[middle]
+                   : 0.5 * (surveyed_ppm[middle - 1] + surveyed_ppm[middle]);
+    }
+
+    double bound_ppm = (std::max)(ISOLATION_NOISE_FACTOR * median_ppm, ISOLATION_NOISE_FLOOR_PPM);
+    size_t housekeeping_share = (cores.size() + HOUSEKEEPING_SHARE_DIVISOR - 1) / HOUSEKEEPING_SHARE_DIVISOR;
+
+    // Why each core is kept; empty for the cores to isolate.
+    std::vector<string> keep_reasons(cores.size());
+    std::set<int> packages_kept;
+    std::set<int> nodes_kept;
+    size_t kept_cores = 0;
+
+    auto keep = [&](size_t index, const string& reason) {
+        keep_reasons[index] = reason;
+        packages_kept.insert(cores[index].package);
+        nodes_kept.insert(cores[index].node);
+        kept_cores++;
+    };
+
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (size_t i = 0; i < cores.size(); i++) {
+        if (!cores[i].surveyed) {
+            keep(i, "not surveyed");
+        } else if (cores[i].noise_ppm > bound_ppm) {
+            std::stringstream reason;
+            reason << std::fixed << std::setprecision(1)
+                   << "noisy, " << cores[i].noise_ppm << " ppm against a median of " << median_ppm << " ppm";
+            keep(i, reason.str());
+        }
+    }
+
+    for (size_t i = cores.size(); i-- > 0;) {
+        if (!keep_reasons[i].empty()) {
+            continue;
+        }
+
+        if (packages_kept.count(cores[i].package) == 0) {
+            keep(i, "housekeeping for package " + std::to_string(cores[i].package));
+        } else if (nodes_kept.count(cores[i].node) == 0) {
+            keep(i, "housekeeping for NUMA node " + std::to_string(cores[i].node));
+        }
+    }
+
+    for (size_t i = cores.size(); i-- > 0 && kept_cores < housekeeping_share;) {
+        if (keep_reasons[i].empty()) {
+            keep(i, "housekeeping, which gets at least 1 in "
+                    + std::to_string(HOUSEKEEPING_SHARE_DIVISOR) + " cores");
+        }
+    }
+
+    std::vector<int> isolated_cpus;
+    std::map<int, size_t> isolated_cores_per_node;
+    size_t isolated_cores = 0;
+
+    for (size_t i = 0; i < cores.size(); i++) {
+        if (!keep_reasons[i].empty()) {
+            std::vector<int> core_cpus = cores[i].cpus;
+            std::sort(core_cpus.begin(), core_cpus.end());
+
+            std::cout << "INFO: Keeping the core of CPUs " << FormatCpuList(core_cpus)
+                      << ": " << keep_reasons[i] << ".\n";
+            continue;
+        }
+
+        isolated_cpus.insert(isolated_cpus.end(), cores[i].cpus.begin(), cores[i].cpus.end());
+        isolated_cores_per_node[cores[i].node]++;
+        isolated_cores++;
+    }
+
+    std::cout << std::defaultfloat;
+
+    if (isolated_cpus.empty()) {
+        std::cout << "INFO: The housekeeping needs every core; there is no core left to isolate.\n";
+        return;
+    }
+
+    std::sort(isolated_cpus.begin(), isolated_cpus.end());
+    std::vector<int> housekeeping_cpus;
+
+    for (const CpuLocation& location : locations) {
+        if (!std::binary_search(isolated_cpus.begin(), isolated_cpus.end(), location.cpu)) {
+            housekeeping_cpus.push_back(location.cpu);
+        }
+    }
+
+    string isolated_list = FormatCpuList(isolated_cpus);
+    string housekeeping_list = FormatCpuList(housekeeping_cpus);
+
+    std::cout << "INFO: Suggest isolating " << isolated_cores << " of " << cores.size()
+              << " cores, CPUs " << isolated_list
+              << ", and keeping CPUs " << housekeeping_list << " for the housekeeping.\n";
+
+    if (isolated_cores_per_node.size() > 1) {
+        std::cout << "INFO: Isolated cores per NUMA node:";
+
+        for (const auto& [node, count] : isolated_cores_per_node) {
+            std::cout << " node " << node << ": " << count << ";";
+        }
+
+        std::cout << " allocate from the node of the cores used.\n";
+    }
+
+    std::cout << "INFO: To isolate fewer cores, take them from the top of the ranking.\n";
+
+#ifdef _WIN32
+    std::map<int, DWORD> cpu_set_ids = GetCpuSetIds();
+
+    std::cout << "\nSuggested CPU sets to reserve for the latency-critical process:\n"
+              << "  " << FormatCpuSetIds(cpu_set_ids, isolated_cpus) << "\n"
+              << "Hand them to it with SetProcessDefaultCpuSets(), keep the other processes on CPU sets "
+              << FormatCpuSetIds(cpu_set_ids, housekeeping_cpus)
+              << ",\nand point the interrupt affinity policy of the busy devices at CPUs "
+              << housekeeping_list << ".\n";
+#else
+    std::cout << "\nSuggested kernel command line:\n"
+              << "  isolcpus=managed_irq,domain," << isolated_list
+              << " nohz_full=" << isolated_list
+              << " rcu_nocbs=" << isolated_list
+              << " irqaffinity=" << housekeeping_list << "\n";
+#endif
+}
+
+void com::github::coderodde::wtpdmt::runSurveyMode(const SurveyConfiguration& configuration,
+                                                   const util::Clock& clock) {
+    std::vector<CpuLocation> locations = util::getCpuLocations();
+    std::vector<int> cpus = configuration.cpus;
+    int cpu_slots = 0;
+
+    if (cpus.empty()) {
+        for (const CpuLocation& location : locations) {
+            cpus.push_back(location.cpu);
+        }
+    }
+
+    std::set<int> packages;
+    std::set<int> nodes;
+    std::map<std::pair<int, int>, CoreNoise> cores;
+
+    for (const CpuLocation& location : locations) {
+        CoreNoise& core = cores[{ location.package, location.core }];
+        core.package = location.package;
+        core.node = location.node;
+        core.cpus.push_back(location.cpu);
+        core.surveyed = true;
+        packages.insert(location.package);
+        nodes.insert(location.node);
+        cpu_slots = (std::max)(cpu_slots, location.cpu + 1);
+    }
+
+    for (int cpu : cpus) {
+        cpu_slots = (std::max)(cpu_slots, cpu + 1);
+    }
+
+    std::cout << "INFO: Found " << packages.size() << " packages, " << nodes.size()
+              << " NUMA nodes, " << cores.size() << " cores and " << locations.size() << " CPUs.\n";
+#ifndef _WIN32
+    PrintKernelIsolation();
+#endif
+    std::vector<int> sorted_cpus = cpus;
+    std::sort(sorted_cpus.begin(), sorted_cpus.end());
+
+    std::cout << "INFO: Measuring " << configuration.iterations << " gaps on each of CPUs "
+              << FormatCpuList(sorted_cpus) << " at once.\n";
+
+    InterruptCounts interrupts_before = ReadInterruptCounts(cpu_slots);
+
+    std::vector<std::unique_ptr<ThreadStatistics>> statistics =
+        runOnThreads(cpus,
+                     configuration.thread_priority,
+                     [&](size_t, ThreadStatistics& thread_statistics) {
+        Clock::dispatch(configuration.clock_source, [&](auto reader) {
+            measureGaps<decltype(reader)>(configuration.iterations, thread_statistics.histogram);
+        });
+    });
+
+    InterruptCounts interrupts_after = ReadInterruptCounts(cpu_slots);
+    std::vector<bool> isolated(static_cast<size_t>(cpu_slots), false);
+    std::vector<bool> nohz_full(static_cast<size_t>(cpu_slots), false);
+    std::vector<int> routed_irqs;
+
+#ifndef _WIN32
+    for (int cpu : ReadCpuListFile("/sys/devices/system/cpu/isolated")) {
+        if (cpu < cpu_slots) {
+            isolated[static_cast<size_t>(cpu)] = true;
+        }
+    }
+
+    for (int cpu : ReadCpuListFile("/sys/devices/system/cpu/nohz_full")) {
+        if (cpu < cpu_slots) {
+            nohz_full[static_cast<size_t>(cpu)] = true;
+        }
+    }
+
+    routed_irqs = CountRoutedIrqs(cpu_slots);
+#endif
+
+    std::unique_ptr<Histogram> aggregate = std::make_unique<Histogram>();
+    std::vector<CpuNoise> noises;
+
+    for (const auto& thread_statistics : statistics) {
+        int cpu = thread_statistics->requested_cpu;
+        CpuLocation location{ cpu, cpu, 0, 0 };
+
+        for (const CpuLocation& candidate : locations) {
+            if (candidate.cpu == cpu) {
+                location = candidate;
+            }
+        }
+
+        CpuNoise noise{ location, 0, 0.0, thread_statistics->histogram.getMaximum(), 0, "", -1,
+                        isolated[static_cast<size_t>(cpu)], nohz_full[static_cast<size_t>(cpu)] };
+
+        MeasureNoise(thread_statistics->histogram, configuration.threshold_ticks, &noise.noise_gaps, &noise.noise_ppm);
+        CountInterrupts(interrupts_before, interrupts_after, noise);
+
+        if (!routed_irqs.empty()) {
+            noise.routed_irqs = routed_irqs[static_cast<size_t>(cpu)];
+        }
+
+        aggregate->add(thread_statistics->histogram);
+        noises.push_back(noise);
+    }
+
+    if (statistics.size() > 1) {
+        printThreadTable(statistics, *aggregate, clock, configuration.percentiles);
+    } else {
+        printGapStatistics(*aggregate, clock, configuration.percentiles);
+    }
+
+    // A core is as noisy as its noisiest CPU, since an SMT sibling shares
+    // what disturbs it; cores with CPUs outside the survey rank last.
+    std::map<int, const CpuNoise*> noise_by_cpu;
+
+    for (const CpuNoise& noise : noises) {
+        noise_by_cpu[noise.location.cpu] = &noise;
+    }
+
+    std::vector<CoreNoise> ranked_cores;
+
+    for (auto& [key, core] : cores) {
+        core.noise_ppm = 0.0;
+        core.maximum_ticks = 0;
+
+        for (int cpu : core.cpus) {
+            auto entry = noise_by_cpu.find(cpu);
+
+            if (entry == noise_by_cpu.end()) {
+                core.surveyed = false;
+                continue;
+            }
+
+            core.noise_ppm = (std::max)(core.noise_ppm, entry->second->noise_ppm);
+            core.maximum_ticks = (std::max)(core.maximum_ticks, entry->second->maximum_ticks);
+        }
+
+        ranked_cores.push_back(core);
+    }
+
+    std::stable_sort(ranked_cores.begin(), ranked_cores.end(), [](const CoreNoise& a, const CoreNoise& b) {
+        if (a.surveyed != b.surveyed) {
+            return a.surveyed;
+        }
+
+        if (a.noise_ppm != b.noise_ppm) {
+            return a.noise_ppm < b.noise_ppm;
+        }
+
+        return a.maximum_ticks < b.maximum_ticks;
+    });
+
+    PrintRanking(ranked_cores, noise_by_cpu, clock);
+
+    std::cout << "\n" << std::fixed << std::setprecision(1);
+    PrintNoiseComparison(noises, "that IRQs are routed to", [](const CpuNoise& noise) {
+        return noise.routed_irqs > 0;
+    });
+    PrintNoiseComparison(noises, "the kernel isolates", [](const CpuNoise& noise) {
+        return noise.isolated;
+    });
+    PrintNoiseComparison(noises, "without the periodic tick", [](const CpuNoise& noise) {
+        return noise.nohz_full;
+    });
+    std::cout << std::defaultfloat;
+
+    PrintIsolationSuggestion(ranked_cores, locations);
+}
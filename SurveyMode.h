@@ -0,0 +1,29 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_SURVEY_MODE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_SURVEY_MODE_HPP
+
+#include "Clock.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	struct SurveyConfiguration {
+		util::ClockSource   clock_source;
+		size_t              iterations;      // Gap samples per CPU.
+		int                 thread_priority;
+		std::vector<int>    cpus;            // The CPUs to survey; empty for all online CPUs.
+		uint64_t            threshold_ticks; // Gaps at least this long count as noise.
+		std::vector<double> percentiles;
+	};
+
+	// Measures the gaps on every surveyed CPU at once, a pinned thread
+	// each, and relates them to the interrupts each CPU took meanwhile, to
+	// where the IRQs are routed and to what the kernel already isolates.
+	// Then ranks the cores from the quietest and suggests isolating the
+	// ones that are not much noisier than the median, keeping at least a
+	// core per package and NUMA node and an eighth of the cores for the
+	// housekeeping.
+	void runSurveyMode(const SurveyConfiguration& configuration, const util::Clock& clock);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_SURVEY_MODE_HPP
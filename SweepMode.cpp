@@ -0,0 +1,163 @@
+#include "SweepMode.h"
+#include "Measurement.h"
+#include "Report.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::PowerCounterSource;
+using com::github::coderodde::wtpdmt::PowerStateStatistics;
+using com::github::coderodde::wtpdmt::SweepPoint;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+using com::github::coderodde::wtpdmt::util::Histogram;
+
+// Parts of the priority names that every row or column shares:
+static const std::vector<string> REDUNDANT_NAME_PARTS = {
+    "_PRIORITY_CLASS",
+    "THREAD_PRIORITY_",
+    "SCHED_",
+};
+
+// Keeps the matrix narrow: THREAD_PRIORITY_TIME_CRITICAL -> TIME_CRITICAL.
+static string ShortenName(const string& name) {
+    string short_name = name;
+
+    for (const string& part : REDUNDANT_NAME_PARTS) {
+        size_t position = short_name.find(part);
+
+        if (position != string::npos && short_name.length() > part.length()) {
+            short_name.erase(position, part.length());
+        }
+    }
+
+    return short_name;
+}
+
+void com::github::coderodde::wtpdmt::runSweepMode(const SweepConfiguration& configuration,
+                                                  const util::Clock& clock) {
+    util::PriorityClass original_priority_class = util::getProcessPriorityClass();
+
+    std::vector<string> class_labels;
+    std::vector<string> thread_priority_labels;
+
+    for (const string& name : configuration.class_names) {
+        class_labels.push_back(ShortenName(name));
+    }
+
+    for (const string& name : configuration.thread_priority_names) {
+        thread_priority_labels.push_back(ShortenName(name));
+    }
+
+    std::vector<string> point_labels;
+    std::vector<std::unique_ptr<Histogram>> aggregates;
+    std::vector<PowerStateStatistics> power_states;
+    std::vector<std::vector<const Histogram*>> cells(
+        configuration.class_names.size(),
+        std::vector<const Histogram*>(configuration.thread_priority_names.size(), nullptr));
+
+    std::cout << "INFO: Sweeping " << configuration.points.size()
+              << " priority combinations with " << configuration.warmup_iterations
+              << " warm-up and " << configuration.iterations << " measured gaps each.\n";
+
+    for (const SweepPoint& point : configuration.points) {
+        const string& class_name = configuration.class_names[point.class_index];
+        const string& thread_priority_name = configuration.thread_priority_names[point.thread_priority_index];
+        string label = class_labels[point.class_index] + "/" + thread_priority_labels[point.thread_priority_index];
+
+        std::cout << "INFO: Measuring " << class_name << " with " << thread_priority_name << ".\n";
+
+        util::setProcessPriorityClass(point.priority_class);
+        std::vector<std::unique_ptr<ThreadStatistics>> statistics;
+
+        try {
+            statistics = runOnThreads(configuration.cpus,
+                                      point.thread_priority,
+                                      [&](size_t, ThreadStatistics& thread_statistics) {
+                util::Clock::dispatch(configuration.clock_source, [&](auto reader) {
+                    // Let caches, branch predictors and the CPU frequency
+                    // settle before anything counts:
+                    measureGaps<decltype(reader)>(configuration.warmup_iterations,
+                                                  thread_statistics.histogram);
+                    thread_statistics.histogram.reset();
+
+                    if (configuration.power_counter_source == PowerCounterSource::NONE) {
+                        measureGaps<decltype(reader)>(configuration.iterations,
+                                                      thread_statistics.histogram);
+                        return;
+                    }
+
+                    PowerStateSampler sampler(configuration.power_counter_source, clock.getNanosecondsPerTick());
+                    HistogramRecorder histogram_recorder{ thread_statistics.histogram };
+                    PowerStateRecorder<HistogramRecorder> recorder{ histogram_recorder,
+                                                                    sampler,
+                                                                    configuration.power_threshold_ticks };
+                    sampler.start();
+                    runGapLoop<decltype(reader)>(configuration.iterations, recorder);
+                    thread_statistics.power_states = sampler.getStatistics();
+                });
+            });
+        } catch (std::runtime_error& err) {
+            util::setProcessPriorityClass(original_priority_class);
+            std::cout << "WARNING: Skipping " << label << ": " << err.what() << "\n";
+            continue;
+        }
+
+        // Each point starts from the same state:
+        util::setProcessPriorityClass(original_priority_class);
+
+        std::unique_ptr<Histogram> aggregate = std::make_unique<Histogram>();
+        PowerStateStatistics point_power_states{};
+        util::PriorityClass effective_priority_class = point.priority_class;
+
+        for (const auto& thread_statistics : statistics) {
+            aggregate->add(thread_statistics->histogram);
+            addPowerStateStatistics(point_power_states, thread_statistics->power_states);
+
+            if (thread_statistics->effective_priority_class != point.priority_class) {
+                effective_priority_class = thread_statistics->effective_priority_class;
+            }
+        }
+
+        if (effective_priority_class != point.priority_class) {
+            std::cout << "WARNING: " << class_name
+                      << " did not take effect (insufficient privileges?); the effective class was 0x"
+                      << std::hex << effective_priority_class << std::dec << ".\n";
+        }
+
+        cells[point.class_index][point.thread_priority_index] = aggregate.get();
+        point_labels.push_back(label);
+        aggregates.push_back(std::move(aggregate));
+        power_states.push_back(point_power_states);
+    }
+
+    std::vector<const Histogram*> histograms;
+
+    for (const auto& aggregate : aggregates) {
+        histograms.push_back(aggregate.get());
+    }
+
+    std::cout << "\nGaps per priority combination:\n";
+    printHistogramTable("Class/Thread", point_labels, histograms, clock, configuration.percentiles);
+
+    if (!configuration.percentiles.empty()) {
+        std::cout << "\nTail latency by priority class (rows) and thread priority (columns):\n";
+        printPercentileMatrix("Class", class_labels, thread_priority_labels, cells, clock,
+                              *std::max_element(configuration.percentiles.begin(),
+                                                configuration.percentiles.end()));
+    }
+
+    std::cout << "\nMaximum gap by priority class (rows) and thread priority (columns):\n";
+    printPercentileMatrix("Class", class_labels, thread_priority_labels, cells, clock, 100.0);
+
+    if (configuration.power_counter_source == PowerCounterSource::NONE) {
+        std::cout << "\n";
+        return;
+    }
+
+    std::cout << "\nLong gaps by power state (share of their time) per priority combination:";
+    printPowerStates("Class/Thread", point_labels, power_states, clock);
+}
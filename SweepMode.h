@@ -0,0 +1,41 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_SWEEP_MODE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_SWEEP_MODE_HPP
+
+#include "Clock.h"
+#include "PowerStates.h"
+#include "ThreadControl.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	// One cell of the sweep matrix. On Linux the same thread priority name
+	// resolves differently per policy, hence the resolved value per point.
+	struct SweepPoint {
+		size_t              class_index;           // Into SweepConfiguration::class_names.
+		size_t              thread_priority_index; // Into SweepConfiguration::thread_priority_names.
+		util::PriorityClass priority_class;
+		int                 thread_priority;
+	};
+
+	struct SweepConfiguration {
+		util::ClockSource        clock_source;
+		size_t                   iterations;        // Measured gaps per thread and point.
+		size_t                   warmup_iterations; // Discarded gaps before those.
+		std::vector<int>         cpus;
+		std::vector<std::string> class_names;
+		std::vector<std::string> thread_priority_names;
+		std::vector<SweepPoint>  points;
+		std::vector<double>      percentiles;
+		PowerCounterSource       power_counter_source;  // NONE unless power states are sampled.
+		uint64_t                 power_threshold_ticks; // Used only if power states are sampled.
+	};
+
+	// Measures gaps at every point in turn, restoring the original priority
+	// class after each, and prints the results side by side plus matrices
+	// of the tail latencies, and the power states around the long gaps if
+	// asked for.
+	void runSweepMode(const SweepConfiguration& configuration, const util::Clock& clock);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_SWEEP_MODE_HPP
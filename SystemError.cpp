@@ -0,0 +1,23 @@
+#include "SystemError.h"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#endif
+
+void com::github::coderodde::wtpdmt::util::throwSystemError(const string& operation) {
+    std::stringstream ss;
+    ss << "Could not " << operation << ", error code "
+#ifdef _WIN32
+       << GetLastError()
+#else
+       << errno
+#endif
+       << ".";
+
+    throw std::runtime_error{ ss.str() };
+}
@@ -0,0 +1,16 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_SYSTEM_ERROR_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_SYSTEM_ERROR_HPP
+
+#include <string>
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	using std::string;
+
+	// Throws a std::runtime_error saying "Could not <operation>" with the
+	// error code of the failed call: GetLastError() on Windows, errno
+	// elsewhere. Call it right after the failure, before anything else can
+	// overwrite the code.
+	[[noreturn]] void throwSystemError(const string& operation);
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_SYSTEM_ERROR_HPP
@@ -0,0 +1,257 @@
+#include "ThreadControl.h"
+#include "ListItems.h"
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+
+#ifndef _WIN32
+// The layout sched_setattr(2) expects; glibc wraps the call only since 2.41:
+struct SchedAttr {
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t  sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;
+    uint64_t sched_deadline;
+    uint64_t sched_period;
+};
+
+static const int BACKGROUND_NICE = 10;
+
+static std::atomic<int> requested_policy{ SCHED_OTHER };
+static com::github::coderodde::wtpdmt::util::SchedDeadlineParameters sched_deadline_parameters{};
+
+static void ApplySchedDeadline() {
+    SchedAttr attr{};
+    attr.size           = sizeof(attr);
+    attr.sched_policy   = SCHED_DEADLINE;
+    attr.sched_runtime  = sched_deadline_parameters.runtime_nanoseconds;
+    attr.sched_deadline = sched_deadline_parameters.deadline_nanoseconds;
+    attr.sched_period   = sched_deadline_parameters.period_nanoseconds;
+
+    syscall(SYS_sched_setattr, 0, &attr, 0);
+}
+
+static void ApplyPolicy(int policy, int realtime_priority) {
+    if (policy == SCHED_DEADLINE) {
+        ApplySchedDeadline();
+        return;
+    }
+
+    sched_param param{};
+    param.sched_priority = realtime_priority;
+    pthread_setschedparam(pthread_self(), policy, &param);
+}
+#endif
+
+int com::github::coderodde::wtpdmt::util::getCpuCount() {
+    return static_cast<int>(std::thread::hardware_concurrency());
+}
+
+int com::github::coderodde::wtpdmt::util::getCurrentCpu() {
+#ifdef _WIN32
+    return static_cast<int>(GetCurrentProcessorNumber());
+#else
+    return sched_getcpu();
+#endif
+}
+
+void com::github::coderodde::wtpdmt::util::pinCurrentThreadToCpu(int cpu) {
+#ifdef _WIN32
+    // Affinity masks address the processor group of the process only:
+    if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+        std::stringstream ss;
+        ss << "CPU " << cpu << " is outside of the processor group of the process.";
+        throw std::logic_error{ ss.str() };
+    }
+
+    if (SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) == 0) {
+        std::stringstream ss;
+        ss << "Could not pin a thread to CPU " << cpu
+           << ", error code " << GetLastError() << ".";
+        throw std::runtime_error{ ss.str() };
+    }
+#else
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+
+    if (error != 0) {
+        std::stringstream ss;
+        ss << "Could not pin a thread to CPU " << cpu
+           << ", error code " << error << ".";
+        throw std::runtime_error{ ss.str() };
+    }
+#endif
+}
+
+#ifdef _WIN32
+void com::github::coderodde::wtpdmt::util::setProcessPriorityClass(PriorityClass priority_class) {
+    SetPriorityClass(GetCurrentProcess(), priority_class);
+}
+
+com::github::coderodde::wtpdmt::util::PriorityClass com::github::coderodde::wtpdmt::util::getProcessPriorityClass() {
+    return GetPriorityClass(GetCurrentProcess());
+}
+
+com::github::coderodde::wtpdmt::util::PriorityClass com::github::coderodde::wtpdmt::util::getCurrentThreadPriorityClass() {
+    return GetPriorityClass(GetCurrentProcess());
+}
+
+void com::github::coderodde::wtpdmt::util::setCurrentThreadPriority(int thread_priority) {
+    SetThreadPriority(GetCurrentThread(), thread_priority);
+}
+
+void com::github::coderodde::wtpdmt::util::setCurrentThreadPriority(PriorityClass, int thread_priority) {
+    SetThreadPriority(GetCurrentThread(), thread_priority);
+}
+
+void com::github::coderodde::wtpdmt::util::setCurrentThreadBackgroundPriority() {
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+}
+
+int com::github::coderodde::wtpdmt::util::getCurrentThreadPriority() {
+    return GetThreadPriority(GetCurrentThread());
+}
+#else
+// Like SetPriorityClass() and SetThreadPriority(), the functions below
+// leave failures (mostly a missing CAP_SYS_NICE) to be detected by reading
+// back the effective values.
+
+void com::github::coderodde::wtpdmt::util::setSchedDeadlineParameters(const SchedDeadlineParameters& parameters) {
+    sched_deadline_parameters = parameters;
+}
+
+void com::github::coderodde::wtpdmt::util::setProcessPriorityClass(PriorityClass priority_class) {
+    int policy = static_cast<int>(priority_class);
+    requested_policy.store(policy);
+
+    // A SCHED_DEADLINE thread may not create threads, so only the
+    // measuring threads switch to it:
+    if (policy != SCHED_DEADLINE) {
+        ApplyPolicy(policy, policy == SCHED_FIFO || policy == SCHED_RR
+                            ? sched_get_priority_min(policy)
+                            : 0);
+    }
+}
+
+com::github::coderodde::wtpdmt::util::PriorityClass com::github::coderodde::wtpdmt::util::getProcessPriorityClass() {
+    return getCurrentThreadPriorityClass();
+}
+
+com::github::coderodde::wtpdmt::util::PriorityClass com::github::coderodde::wtpdmt::util::getCurrentThreadPriorityClass() {
+    return static_cast<PriorityClass>(sched_getscheduler(0) & ~SCHED_RESET_ON_FORK);
+}
+
+void com::github::coderodde::wtpdmt::util::setCurrentThreadPriority(int thread_priority) {
+    setCurrentThreadPriority(static_cast<PriorityClass>(requested_policy.load()), thread_priority);
+}
+
+void com::github::coderodde::wtpdmt::util::setCurrentThreadPriority(PriorityClass priority_class, int thread_priority) {
+    int policy = static_cast<int>(priority_class);
+
+    if (policy == SCHED_FIFO || policy == SCHED_RR) {
+        ApplyPolicy(policy, thread_priority);
+        return;
+    }
+
+    ApplyPolicy(policy, 0);
+
+    if (policy == SCHED_OTHER || policy == SCHED_BATCH) {
+        setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), thread_priority);
+    }
+}
+
+void com::github::coderodde::wtpdmt::util::setCurrentThreadBackgroundPriority() {
+    setCurrentThreadPriority(static_cast<PriorityClass>(SCHED_OTHER), BACKGROUND_NICE);
+}
+
+int com::github::coderodde::wtpdmt::util::getCurrentThreadPriority() {
+    int policy = sched_getscheduler(0) & ~SCHED_RESET_ON_FORK;
+
+    if (policy == SCHED_FIFO || policy == SCHED_RR) {
+        sched_param param{};
+        sched_getparam(0, &param);
+        return param.sched_priority;
+    }
+
+    if (policy == SCHED_OTHER || policy == SCHED_BATCH) {
+        return getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+    }
+
+    return 0;
+}
+#endif
+
+// The highest CPU a thread can be pinned to, plus one: an affinity mask
+// covers the processor group on Windows, a cpu_set_t CPU_SETSIZE CPUs.
+#ifdef _WIN32
+static const int CPU_LIMIT = static_cast<int>(sizeof(DWORD_PTR) * 8);
+#else
+static const int CPU_LIMIT = CPU_SETSIZE;
+#endif
+
+static bool ParseCpu(std::string_view value, int* cpu) {
+    const char* end = value.data() + value.size();
+    auto [last, error] = std::from_chars(value.data(), end, *cpu);
+    return !value.empty() && error == std::errc{} && last == end && *cpu >= 0;
+}
+
+std::vector<int> com::github::coderodde::wtpdmt::util::parseCpuList(std::string_view cpu_list) {
+    std::vector<int> cpus;
+    std::string_view list = cpu_list;
+    std::string_view range;
+
+    while (nextListItem(list, ',', &range)) {
+        size_t dash = range.find('-');
+        std::string_view first_value = range.substr(0, dash);
+        std::string_view last_value = dash == std::string_view::npos ? first_value : range.substr(dash + 1);
+        int first;
+        int last;
+
+        if (!ParseCpu(first_value, &first) || !ParseCpu(last_value, &last) || last < first) {
+            std::stringstream ss;
+            ss << "Could not parse '" << range << "' as a CPU or a CPU range.";
+            throw std::logic_error{ ss.str() };
+        }
+
+        // Checked before the range is expanded:
+        if (last >= CPU_LIMIT) {
+            std::stringstream ss;
+            ss << "CPU " << last << " is beyond the " << CPU_LIMIT << " CPUs a thread can be pinned to.";
+            throw std::logic_error{ ss.str() };
+        }
+
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    if (cpus.empty()) {
+        throw std::logic_error{ "The CPU list is empty." };
+    }
+
+    return cpus;
+}
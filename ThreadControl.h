@@ -0,0 +1,62 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_THREAD_CONTROL_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_THREAD_CONTROL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	using std::string;
+
+	// Separates per-thread state that is written during a run so that two
+	// measuring threads never share a cache line.
+	constexpr size_t CACHE_LINE_SIZE = 64;
+
+	// A *_PRIORITY_CLASS value on Windows. On Linux, a SCHED_* policy; the
+	// thread priority is then a nice level under SCHED_OTHER and
+	// SCHED_BATCH, a real-time priority under SCHED_FIFO and SCHED_RR, and
+	// ignored under SCHED_IDLE and SCHED_DEADLINE.
+	using PriorityClass = unsigned long;
+
+	int getCpuCount();
+	int getCurrentCpu();
+	void pinCurrentThreadToCpu(int cpu);
+
+	// Windows applies the class to the process. Linux applies the policy
+	// to the calling thread, which new threads inherit, and remembers it
+	// for setCurrentThreadPriority().
+	void setProcessPriorityClass(PriorityClass priority_class);
+	PriorityClass getProcessPriorityClass();
+	PriorityClass getCurrentThreadPriorityClass();
+
+	void setCurrentThreadPriority(int thread_priority);
+	int getCurrentThreadPriority();
+
+	// Gives the calling thread a class of its own. Windows has one class
+	// per process, so there only the thread priority applies.
+	void setCurrentThreadPriority(PriorityClass priority_class, int thread_priority);
+
+	// For helper threads that must not compete with the measuring ones:
+	// THREAD_PRIORITY_LOWEST on Windows, SCHED_OTHER at nice 10 on Linux.
+	void setCurrentThreadBackgroundPriority();
+
+	struct SchedDeadlineParameters {
+		uint64_t runtime_nanoseconds;
+		uint64_t deadline_nanoseconds;
+		uint64_t period_nanoseconds;
+	};
+
+#ifndef _WIN32
+	// Must precede setProcessPriorityClass(SCHED_DEADLINE).
+	void setSchedDeadlineParameters(const SchedDeadlineParameters& parameters);
+#endif
+
+	// Parses lists such as "0-3,6,8-11" into the CPU indices they denote.
+	// CPUs no thread can be pinned to are rejected before a range is
+	// expanded.
+	std::vector<int> parseCpuList(std::string_view cpu_list);
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_THREAD_CONTROL_HPP
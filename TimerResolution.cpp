@@ -0,0 +1,171 @@
+#include "TimerResolution.h"
+#include "SystemError.h"
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::util::TimerResolution;
+using com::github::coderodde::wtpdmt::util::throwSystemError;
+
+#ifdef _WIN32
+// The ntdll calls take and return units of 100 ns:
+static const uint64_t NANOSECONDS_PER_TIMER_UNIT = 100;
+
+// Windows 11 ignores the timer resolution of processes that have no
+// visible window unless they opt out of that throttling:
+#ifndef PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION
+#define PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION 0x4
+#endif
+
+typedef LONG (NTAPI* NtQueryTimerResolutionFunction)(PULONG coarsest, PULONG finest, PULONG current);
+typedef LONG (NTAPI* NtSetTimerResolutionFunction)(ULONG desired, BOOLEAN set, PULONG current);
+
+// What setTimerResolution() asked for, in 100 ns units; 0 for nothing.
+static ULONG requested_timer_units = 0;
+#else
+// The slack of the main thread before setTimerResolution() changed it:
+static int original_timer_slack = -1;
+#endif
+
+#ifdef _WIN32
+// The calls are not in the import libraries; ntdll is always loaded.
+static FARPROC GetNtdllFunction(const char* name) {
+    FARPROC function = GetProcAddress(GetModuleHandleW(L"ntdll.dll"), name);
+
+    if (function == nullptr) {
+        throwSystemError(string("find ") + name);
+    }
+
+    return function;
+}
+
+static void ThrowStatusError(const string& operation, LONG status) {
+    std::stringstream ss;
+    ss << "Could not " << operation << ", status 0x" << std::hex << static_cast<unsigned long>(status) << ".";
+    throw std::runtime_error{ ss.str() };
+}
+#endif
+
+string com::github::coderodde::wtpdmt::util::getTimerResolutionName() {
+#ifdef _WIN32
+    return "timer resolution";
+#else
+    return "timer slack";
+#endif
+}
+
+TimerResolution com::github::coderodde::wtpdmt::util::getTimerResolution() {
+#ifdef _WIN32
+    auto query = reinterpret_cast<NtQueryTimerResolutionFunction>(GetNtdllFunction("NtQueryTimerResolution"));
+    ULONG coarsest = 0;
+    ULONG finest = 0;
+    ULONG current = 0;
+    LONG status = query(&coarsest, &finest, &current);
+
+    if (status < 0) {
+        ThrowStatusError("query the timer resolution", status);
+    }
+
+    return TimerResolution{ current * NANOSECONDS_PER_TIMER_UNIT,
+                            finest * NANOSECONDS_PER_TIMER_UNIT,
+                            coarsest * NANOSECONDS_PER_TIMER_UNIT };
+#else
+    int slack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+
+    if (slack < 0) {
+        throwSystemError("query the timer slack");
+    }
+
+    return TimerResolution{ static_cast<uint64_t>(slack), 0, 0 };
+#endif
+}
+
+void com::github::coderodde::wtpdmt::util::setTimerResolution(uint64_t nanoseconds) {
+#ifdef _WIN32
+    auto set = reinterpret_cast<NtSetTimerResolutionFunction>(GetNtdllFunction("NtSetTimerResolution"));
+    ULONG current = 0;
+
+    // The old request stays in force until withdrawn:
+    if (requested_timer_units != 0) {
+        set(requested_timer_units, FALSE, &current);
+        requested_timer_units = 0;
+    }
+
+    PROCESS_POWER_THROTTLING_STATE throttling{};
+    throttling.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+    throttling.ControlMask = PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION;
+    throttling.StateMask = 0;
+
+    // Older systems neither know nor need it:
+    SetProcessInformation(GetCurrentProcess(), ProcessPowerThrottling, &throttling, sizeof(throttling));
+
+    ULONG units = static_cast<ULONG>((nanoseconds + NANOSECONDS_PER_TIMER_UNIT - 1) / NANOSECONDS_PER_TIMER_UNIT);
+    LONG status = set(units, TRUE, &current);
+
+    if (status < 0) {
+        ThrowStatusError("set the timer resolution", status);
+    }
+
+    requested_timer_units = units;
+#else
+    if (original_timer_slack < 0) {
+        original_timer_slack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+    }
+
+    if (prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(nanoseconds), 0, 0, 0) != 0) {
+        throwSystemError("set the timer slack");
+    }
+#endif
+}
+
+void com::github::coderodde::wtpdmt::util::resetTimerResolution() {
+#ifdef _WIN32
+    if (requested_timer_units != 0) {
+        auto set = reinterpret_cast<NtSetTimerResolutionFunction>(GetNtdllFunction("NtSetTimerResolution"));
+        ULONG current = 0;
+        set(requested_timer_units, FALSE, &current);
+        requested_timer_units = 0;
+    }
+#else
+    if (original_timer_slack >= 0) {
+        prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(original_timer_slack), 0, 0, 0);
+        original_timer_slack = -1;
+    }
+#endif
+}
+
+uint64_t com::github::coderodde::wtpdmt::util::getProcessCpuNanoseconds() {
+#ifdef _WIN32
+    FILETIME creation_time;
+    FILETIME exit_time;
+    FILETIME kernel_time;
+    FILETIME user_time;
+
+    if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time)) {
+        throwSystemError("query the process times");
+    }
+
+    uint64_t kernel = (static_cast<uint64_t>(kernel_time.dwHighDateTime) << 32) | kernel_time.dwLowDateTime;
+    uint64_t user   = (static_cast<uint64_t>(user_time.dwHighDateTime) << 32) | user_time.dwLowDateTime;
+
+    return (kernel + user) * NANOSECONDS_PER_TIMER_UNIT;
+#else
+    rusage usage{};
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        throwSystemError("query the process times");
+    }
+
+    return static_cast<uint64_t>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 * 1000 * 1000 +
+           static_cast<uint64_t>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000;
+#endif
+}
@@ -0,0 +1,40 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_TIMER_RESOLUTION_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_TIMER_RESOLUTION_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	using std::string;
+
+	// How late a timer may expire. On Windows, the system timer
+	// resolution in steps of 100 ns, between the finest and the coarsest
+	// the system supports. On Linux, the timer slack of the calling
+	// thread, which threads it creates later inherit; the system sets no
+	// bounds there, so both are 0.
+	struct TimerResolution {
+		uint64_t current_nanoseconds;
+		uint64_t finest_nanoseconds;
+		uint64_t coarsest_nanoseconds;
+	};
+
+	// "timer resolution" on Windows, "timer slack" on Linux.
+	string getTimerResolutionName();
+
+	TimerResolution getTimerResolution();
+
+	// Windows asks NtSetTimerResolution() for the process, which rounds
+	// the value to what the system supports; timeBeginPeriod() would
+	// only take milliseconds. Linux sets PR_SET_TIMERSLACK on the calling
+	// thread, so call it before creating the measuring threads. Real-time
+	// threads have no slack.
+	void setTimerResolution(uint64_t nanoseconds);
+
+	// Withdraws what setTimerResolution() asked for.
+	void resetTimerResolution();
+
+	// User plus kernel time of the whole process so far.
+	uint64_t getProcessCpuNanoseconds();
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_TIMER_RESOLUTION_HPP
@@ -0,0 +1,222 @@
+#include "Topology.h"
+#include "ThreadControl.h"
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fstream>
+#include <unistd.h>
+#endif
+
+using std::string;
+using com::github::coderodde::wtpdmt::util::CacheSizes;
+using com::github::coderodde::wtpdmt::util::CpuLocation;
+
+static const size_t DEFAULT_LEVEL1_DATA_CACHE_SIZE = 32 * 1024;
+static const size_t DEFAULT_LEVEL2_CACHE_SIZE      = 1024 * 1024;
+static const size_t DEFAULT_LAST_LEVEL_CACHE_SIZE  = 8 * 1024 * 1024;
+
+#ifdef _WIN32
+// Marks every CPU of the process's processor group in 'group_mask' with
+// 'index', as the core, the package or the node field.
+static void MarkCpus(const GROUP_AFFINITY& group_mask,
+                     int index,
+                     int CpuLocation::* field,
+                     std::vector<CpuLocation>& locations) {
+    if (group_mask.Group != 0) {
+        return;
+    }
+
+    for (CpuLocation& location : locations) {
+        if (location.cpu < static_cast<int>(sizeof(KAFFINITY) * 8) &&
+            (group_mask.Mask & (KAFFINITY(1) << location.cpu)) != 0) {
+            location.*field = index;
+        }
+    }
+}
+#else
+// Returns false if the CPU is offline or sysfs is not there.
+static bool ReadTopologyValue(int cpu, const string& name, int* value) {
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + name);
+    return static_cast<bool>(file >> *value);
+}
+
+// Without NUMA support in the kernel there is no node directory, and all
+// memory is node 0's.
+static void ReadNumaNodes(std::vector<CpuLocation>& locations) {
+    std::ifstream online_file("/sys/devices/system/node/online");
+    string online;
+
+    if (!std::getline(online_file, online) || online.empty()) {
+        return;
+    }
+
+    for (int node : com::github::coderodde::wtpdmt::util::parseCpuList(online)) {
+        std::ifstream cpu_list_file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        string cpu_list;
+
+        // Nodes with memory but no CPUs have an empty list:
+        if (!std::getline(cpu_list_file, cpu_list) || cpu_list.empty()) {
+            continue;
+        }
+
+        for (int cpu : com::github::coderodde::wtpdmt::util::parseCpuList(cpu_list)) {
+            for (CpuLocation& location : locations) {
+                if (location.cpu == cpu) {
+                    location.node = node;
+                }
+            }
+        }
+    }
+}
+
+// Reads a value of cache 'index' of CPU 0, such as "level" or "size".
+static bool ReadCacheValue(int index, const string& name, string* value) {
+    std::ifstream file("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/" + name);
+    return static_cast<bool>(file >> *value);
+}
+#endif
+
+// Records a data or unified cache of 'level'; the highest level seen is
+// the last level.
+static void RecordCache(int level, size_t size, int* last_level, CacheSizes* cache_sizes) {
+    if (level == 1) {
+        cache_sizes->level1_data = size;
+    } else if (level == 2) {
+        cache_sizes->level2 = size;
+    }
+
+    if (level >= *last_level) {
+        *last_level = level;
+        cache_sizes->last_level = size;
+    }
+}
+
+std::vector<CpuLocation> com::github::coderodde::wtpdmt::util::getCpuLocations() {
+    std::vector<CpuLocation> locations;
+
+#ifdef _WIN32
+    for (int cpu = 0; cpu < getCpuCount(); cpu++) {
+        locations.push_back(CpuLocation{ cpu, cpu, 0, 0 });
+    }
+
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    std::vector<char> buffer(length);
+
+    if (length == 0 ||
+        !GetLogicalProcessorInformationEx(RelationAll,
+                                          reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()),
+                                          &length)) {
+        return locations;
+    }
+
+    int core = 0;
+    int package = 0;
+
+    for (DWORD offset = 0; offset < length;) {
+        auto information = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+
+        if (information->Relationship == RelationProcessorCore) {
+            MarkCpus(information->Processor.GroupMask[0], core++, &CpuLocation::core, locations);
+        } else if (information->Relationship == RelationProcessorPackage) {
+            for (WORD i = 0; i < information->Processor.GroupCount; i++) {
+                MarkCpus(information->Processor.GroupMask[i], package, &CpuLocation::package, locations);
+            }
+
+            package++;
+        } else if (information->Relationship == RelationNumaNode) {
+            MarkCpus(information->NumaNode.GroupMask,
+                     static_cast<int>(information->NumaNode.NodeNumber),
+                     &CpuLocation::node,
+                     locations);
+        }
+
+        offset += information->Size;
+    }
+#else
+    int package = 0;
+
+    if (!ReadTopologyValue(0, "physical_package_id", &package)) {
+        // No sysfs in this container:
+        for (int cpu = 0; cpu < getCpuCount(); cpu++) {
+            locations.push_back(CpuLocation{ cpu, cpu, 0, 0 });
+        }
+
+        return locations;
+    }
+
+    int configured_cpus = static_cast<int>(sysconf(_SC_NPROCESSORS_CONF));
+
+    for (int cpu = 0; cpu < configured_cpus; cpu++) {
+        CpuLocation location{ cpu, 0, 0, 0 };
+
+        // Offline CPUs have no topology:
+        if (ReadTopologyValue(cpu, "core_id", &location.core) &&
+            ReadTopologyValue(cpu, "physical_package_id", &location.package)) {
+            locations.push_back(location);
+        }
+    }
+
+    ReadNumaNodes(locations);
+#endif
+
+    return locations;
+}
+
+CacheSizes com::github::coderodde::wtpdmt::util::getCacheSizes() {
+    CacheSizes cache_sizes{ DEFAULT_LEVEL1_DATA_CACHE_SIZE,
+                            DEFAULT_LEVEL2_CACHE_SIZE,
+                            DEFAULT_LAST_LEVEL_CACHE_SIZE };
+    int last_level = 0;
+
+#ifdef _WIN32
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationCache, nullptr, &length);
+    std::vector<char> buffer(length);
+
+    if (length == 0 ||
+        !GetLogicalProcessorInformationEx(RelationCache,
+                                          reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()),
+                                          &length)) {
+        return cache_sizes;
+    }
+
+    for (DWORD offset = 0; offset < length;) {
+        auto information = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+        const CACHE_RELATIONSHIP& cache = information->Cache;
+
+        // Only the caches of CPU 0:
+        if (cache.Type != CacheInstruction &&
+            cache.GroupMask.Group == 0 &&
+            (cache.GroupMask.Mask & 1) != 0) {
+            RecordCache(cache.Level, cache.CacheSize, &last_level, &cache_sizes);
+        }
+
+        offset += information->Size;
+    }
+#else
+    for (int index = 0; ; index++) {
+        string level;
+        string type;
+        string size;
+
+        if (!ReadCacheValue(index, "level", &level) ||
+            !ReadCacheValue(index, "type", &type) ||
+            !ReadCacheValue(index, "size", &size)) {
+            break;
+        }
+
+        // Sizes read like "48K":
+        if (type == "Instruction" || size.empty() || size.back() != 'K') {
+            continue;
+        }
+
+        RecordCache(std::stoi(level), std::stoul(size) * 1024, &last_level, &cache_sizes);
+    }
+#endif
+
+    return cache_sizes;
+}
@@ -0,0 +1,33 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_UTIL_TOPOLOGY_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_UTIL_TOPOLOGY_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt::util {
+
+	// Where a logical CPU sits. CPUs with the same package and core are
+	// SMT siblings.
+	struct CpuLocation {
+		int cpu;
+		int core;    // Unique within the package.
+		int package;
+		int node;    // The NUMA node of its memory.
+	};
+
+	// One entry per online CPU that pinCurrentThreadToCpu() accepts,
+	// ordered by CPU. Without topology information every CPU counts as a
+	// core of its own in package 0 and NUMA node 0.
+	std::vector<CpuLocation> getCpuLocations();
+
+	// Data cache sizes in bytes as CPU 0 sees them. Levels the system does
+	// not report take typical values.
+	struct CacheSizes {
+		size_t level1_data;
+		size_t level2;
+		size_t last_level;
+	};
+
+	CacheSizes getCacheSizes();
+} // End of namespace com::github::coderodde::wtpdmt::util
+#endif // COM_GITHUB_CODERODDE_WTPDMT_UTIL_TOPOLOGY_HPP
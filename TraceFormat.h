@@ -0,0 +1,47 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_TRACE_FORMAT_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_TRACE_FORMAT_HPP
+
+#include <cstdint>
+
+namespace com::github::coderodde::wtpdmt {
+
+	// Layout of a gap trace file (all fields little-endian):
+	//
+	//   TraceFileHeader           header_size bytes
+	//   TraceRecord[record_count] record_size bytes each
+	//
+	// Readers must check magic and version, and should use header_size and
+	// record_size to step over fields added by later versions.
+
+	constexpr char     TRACE_FILE_MAGIC[8]  = { 'W', 'T', 'P', 'D', 'T', 'R', 'C', '\0' };
+	constexpr uint32_t TRACE_FILE_VERSION   = 1;
+
+	struct TraceFileHeader {
+		char     magic[8];
+		uint32_t version;
+		uint32_t header_size;
+		uint32_t record_size;
+		uint32_t clock_source;          // util::ClockSource of the run.
+		uint64_t record_count;
+		uint64_t dropped_record_count;  // Gaps lost to full ring buffers.
+		uint64_t threshold_nanoseconds;
+		uint64_t start_time_nanoseconds; // Unix epoch time when tracing started, before the
+		                                 // measuring threads; the record timestamps are this
+		                                 // plus the clock ticks since.
+		uint32_t thread_count;
+		uint32_t reserved;
+	};
+
+	struct TraceRecord {
+		uint64_t timestamp_nanoseconds; // Unix epoch time at the end of the gap.
+		uint64_t gap_nanoseconds;
+		uint32_t thread_index;
+		int32_t  cpu;                   // -1 for an unpinned thread.
+		uint32_t flags;                 // Reserved, zero.
+		uint32_t reserved;
+	};
+
+	static_assert(sizeof(TraceFileHeader) == 64, "Unexpected trace header layout.");
+	static_assert(sizeof(TraceRecord) == 32, "Unexpected trace record layout.");
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_TRACE_FORMAT_HPP
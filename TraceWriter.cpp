@@ -0,0 +1,134 @@
+#include "TraceWriter.h"
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::GapEvent;
+using com::github::coderodde::wtpdmt::TraceFileHeader;
+using com::github::coderodde::wtpdmt::TraceRecord;
+using com::github::coderodde::wtpdmt::util::SpscRing;
+
+static const size_t TRACE_RING_CAPACITY = 1 << 16;
+static const size_t TRACE_FILE_CHUNK_SIZE = 64 * 1024 * 1024;
+static const std::chrono::milliseconds TRACE_WRITER_IDLE_SLEEP{ 1 };
+
+com::github::coderodde::wtpdmt::TraceWriter::TraceWriter(const string& path,
+                                                         const util::Clock& clock,
+                                                         uint64_t threshold_nanoseconds,
+                                                         const std::vector<int>& cpus) :
+    m_file                  { path },
+    m_clock                 { clock },
+    m_threshold_nanoseconds { threshold_nanoseconds },
+    m_cpus                  { cpus },
+    m_start_ticks           { 0 },
+    m_start_time_nanoseconds{ 0 },
+    m_record_count          { 0 },
+    m_stop_requested        { false }
+{
+    for (size_t i = 0; i < cpus.size(); i++) {
+        m_rings.push_back(std::make_unique<SpscRing<GapEvent>>(TRACE_RING_CAPACITY));
+    }
+
+    m_file.reserve(TRACE_FILE_CHUNK_SIZE);
+}
+
+com::github::coderodde::wtpdmt::TraceWriter::~TraceWriter() {
+    if (m_writer_thread.joinable()) {
+        m_stop_requested.store(true, std::memory_order_release);
+        m_writer_thread.join();
+    }
+}
+
+SpscRing<GapEvent>& com::github::coderodde::wtpdmt::TraceWriter::getRing(size_t thread_index) {
+    return *m_rings[thread_index];
+}
+
+uint64_t com::github::coderodde::wtpdmt::TraceWriter::getThresholdTicks() const {
+    return static_cast<uint64_t>(m_threshold_nanoseconds / m_clock.getNanosecondsPerTick());
+}
+
+uint64_t com::github::coderodde::wtpdmt::TraceWriter::getRecordCount() const {
+    return m_record_count;
+}
+
+void com::github::coderodde::wtpdmt::TraceWriter::start() {
+    // Anchor the clock ticks to wall-clock time so that the records can be
+    // lined up with other logs:
+    m_start_ticks = m_clock.read();
+    m_start_time_nanoseconds = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+
+    m_writer_thread = std::thread([this]() {
+        while (!m_stop_requested.load(std::memory_order_acquire)) {
+            if (drainRings() == 0) {
+                std::this_thread::sleep_for(TRACE_WRITER_IDLE_SLEEP);
+            }
+        }
+    });
+}
+
+void com::github::coderodde::wtpdmt::TraceWriter::stop(uint64_t dropped_record_count) {
+    m_stop_requested.store(true, std::memory_order_release);
+    m_writer_thread.join();
+
+    while (drainRings() > 0) {
+    }
+
+    writeHeader(dropped_record_count);
+    m_file.finish(sizeof(TraceFileHeader) + m_record_count * sizeof(TraceRecord));
+}
+
+size_t com::github::coderodde::wtpdmt::TraceWriter::drainRings() {
+    size_t drained = 0;
+    double nanoseconds_per_tick = m_clock.getNanosecondsPerTick();
+
+    for (size_t thread_index = 0; thread_index < m_rings.size(); thread_index++) {
+        GapEvent event;
+
+        while (m_rings[thread_index]->tryPop(event)) {
+            size_t offset = sizeof(TraceFileHeader) + m_record_count * sizeof(TraceRecord);
+
+            if (offset + sizeof(TraceRecord) > m_file.getCapacity()) {
+                m_file.reserve(m_file.getCapacity() + TRACE_FILE_CHUNK_SIZE);
+            }
+
+            TraceRecord record;
+            record.timestamp_nanoseconds = m_start_time_nanoseconds + static_cast<uint64_t>(
+                static_cast<double>(event.end_ticks - m_start_ticks) * nanoseconds_per_tick);
+            record.gap_nanoseconds = m_clock.ticksToNanoseconds(event.gap_ticks);
+            record.thread_index    = static_cast<uint32_t>(thread_index);
+            record.cpu             = m_cpus[thread_index];
+            record.flags           = 0;
+            record.reserved        = 0;
+
+            std::memcpy(m_file.getData() + offset, &record, sizeof(record));
+            m_record_count++;
+            drained++;
+        }
+    }
+
+    return drained;
+}
+
+void com::github::coderodde::wtpdmt::TraceWriter::writeHeader(uint64_t dropped_record_count) {
+    TraceFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic));
+
+    header.version                = TRACE_FILE_VERSION;
+    header.header_size            = sizeof(TraceFileHeader);
+    header.record_size            = sizeof(TraceRecord);
+    header.clock_source           = static_cast<uint32_t>(m_clock.getSource());
+    header.record_count           = m_record_count;
+    header.dropped_record_count   = dropped_record_count;
+    header.threshold_nanoseconds  = m_threshold_nanoseconds;
+    header.start_time_nanoseconds = m_start_time_nanoseconds;
+    header.thread_count           = static_cast<uint32_t>(m_rings.size());
+
+    std::memcpy(m_file.getData(), &header, sizeof(header));
+}
@@ -0,0 +1,64 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_TRACE_WRITER_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_TRACE_WRITER_HPP
+
+#include "Clock.h"
+#include "MappedFile.h"
+#include "SpscRing.h"
+#include "TraceFormat.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using std::string;
+
+	// What a measuring thread pushes for a gap above the threshold; the
+	// conversion to a TraceRecord happens on the writer thread.
+	struct GapEvent {
+		uint64_t end_ticks;
+		uint64_t gap_ticks;
+	};
+
+	// Drains one ring buffer per measuring thread into a memory-mapped
+	// trace file from a background thread, so that the measuring threads
+	// never touch stdio, the allocator or the file system.
+	class TraceWriter {
+	private:
+
+		util::MappedFile                                            m_file;
+		const util::Clock&                                          m_clock;
+		uint64_t                                                    m_threshold_nanoseconds;
+		std::vector<int>                                            m_cpus;
+		std::vector<std::unique_ptr<util::SpscRing<GapEvent>>>      m_rings;
+		uint64_t                                                    m_start_ticks;
+		uint64_t                                                    m_start_time_nanoseconds;
+		uint64_t                                                    m_record_count;
+		std::atomic<bool>                                           m_stop_requested;
+		std::thread                                                 m_writer_thread;
+
+	public:
+
+		TraceWriter(const string& path,
+					const util::Clock& clock,
+					uint64_t threshold_nanoseconds,
+					const std::vector<int>& cpus);
+		~TraceWriter();
+
+		util::SpscRing<GapEvent>& getRing(size_t thread_index);
+		uint64_t getThresholdTicks() const;
+		uint64_t getRecordCount() const;
+
+		void start();
+		void stop(uint64_t dropped_record_count);
+
+	private:
+
+		size_t drainRings();
+		void writeHeader(uint64_t dropped_record_count);
+	};
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_TRACE_WRITER_HPP
@@ -0,0 +1,523 @@
+#include "WakeupMode.h"
+#include "Measurement.h"
+#include "Report.h"
+#include "SystemError.h"
+#include "TimerResolution.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+namespace wtpdmt = com::github::coderodde::wtpdmt;
+
+using std::string;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+using com::github::coderodde::wtpdmt::WakeupConfiguration;
+using com::github::coderodde::wtpdmt::WakeupMechanism;
+using com::github::coderodde::wtpdmt::WakeupTimer;
+using com::github::coderodde::wtpdmt::util::Clock;
+using com::github::coderodde::wtpdmt::util::Histogram;
+using com::github::coderodde::wtpdmt::util::throwSystemError;
+
+// Mechanism names as accepted by --mechanisms:
+static const string MECHANISM_SLEEP_STR                 = "sleep";
+static const string MECHANISM_WAITABLE_TIMER_STR        = "waitable-timer";
+static const string MECHANISM_HIGH_RESOLUTION_TIMER_STR = "hr-waitable-timer";
+static const string MECHANISM_WAIT_TIMEOUT_STR          = "wait-timeout";
+static const string MECHANISM_NANOSLEEP_STR             = "nanosleep";
+static const string MECHANISM_CLOCK_NANOSLEEP_STR       = "clock-nanosleep";
+static const string MECHANISM_TIMERFD_STR               = "timerfd";
+static const string MECHANISM_FUTEX_STR                 = "futex";
+
+static const uint64_t NANOSECONDS_PER_MILLISECOND = 1000 * 1000;
+static const uint64_t NANOSECONDS_PER_SECOND      = 1000 * 1000 * 1000;
+
+#ifdef _WIN32
+static DWORD ToMilliseconds(uint64_t interval_nanoseconds) {
+    return static_cast<DWORD>((interval_nanoseconds + NANOSECONDS_PER_MILLISECOND - 1)
+                              / NANOSECONDS_PER_MILLISECOND);
+}
+
+class SleepTimer : public WakeupTimer {
+public:
+
+    void wait(uint64_t interval_nanoseconds) override {
+        Sleep(ToMilliseconds(interval_nanoseconds));
+    }
+};
+
+class WaitableTimer : public WakeupTimer {
+private:
+
+    HANDLE m_timer_handle;
+
+public:
+
+    explicit WaitableTimer(DWORD flags) {
+        m_timer_handle = CreateWaitableTimerExW(nullptr, nullptr, flags, TIMER_ALL_ACCESS);
+
+        if (m_timer_handle == nullptr) {
+            throwSystemError("create a waitable timer");
+        }
+    }
+
+    ~WaitableTimer() override {
+        CloseHandle(m_timer_handle);
+    }
+
+    void wait(uint64_t interval_nanoseconds) override {
+        // Negative due times are relative and counted in 100 ns units:
+        LARGE_INTEGER due_time;
+        due_time.QuadPart = -static_cast<LONGLONG>(interval_nanoseconds / 100);
+
+        if (!SetWaitableTimer(m_timer_handle, &due_time, 0, nullptr, nullptr, FALSE)) {
+            throwSystemError("arm a waitable timer");
+        }
+
+        WaitForSingleObject(m_timer_handle, INFINITE);
+    }
+};
+
+class WaitTimeoutTimer : public WakeupTimer {
+private:
+
+    HANDLE m_event_handle;
+
+public:
+
+    WaitTimeoutTimer() {
+        // An event that is never signaled:
+        m_event_handle = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+        if (m_event_handle == nullptr) {
+            throwSystemError("create an event");
+        }
+    }
+
+    ~WaitTimeoutTimer() override {
+        CloseHandle(m_event_handle);
+    }
+
+    void wait(uint64_t interval_nanoseconds) override {
+        WaitForSingleObject(m_event_handle, ToMilliseconds(interval_nanoseconds));
+    }
+};
+#else
+static timespec ToTimespec(uint64_t nanoseconds) {
+    timespec ts;
+    ts.tv_sec  = static_cast<time_t>(nanoseconds / NANOSECONDS_PER_SECOND);
+    ts.tv_nsec = static_cast<long>(nanoseconds % NANOSECONDS_PER_SECOND);
+    return ts;
+}
+
+class NanosleepTimer : public WakeupTimer {
+public:
+
+    void wait(uint64_t interval_nanoseconds) override {
+        timespec interval = ToTimespec(interval_nanoseconds);
+        nanosleep(&interval, nullptr);
+    }
+};
+
+class ClockNanosleepTimer : public WakeupTimer {
+public:
+
+    void wait(uint64_t interval_nanoseconds) override {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        timespec deadline = ToTimespec(static_cast<uint64_t>(now.tv_sec) * NANOSECONDS_PER_SECOND
+                                       + static_cast<uint64_t>(now.tv_nsec)
+                                       + interval_nanoseconds);
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+        }
+    }
+};
+
+class TimerfdTimer : public WakeupTimer {
+private:
+
+    int m_timer_descriptor;
+    int m_epoll_descriptor;
+
+public:
+
+    TimerfdTimer() {
+        m_timer_descriptor = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+
+        if (m_timer_descriptor < 0) {
+            throwSystemError("create a timerfd");
+        }
+
+        m_epoll_descriptor = epoll_create1(EPOLL_CLOEXEC);
+
+        if (m_epoll_descriptor < 0) {
+            close(m_timer_descriptor);
+            throwSystemError("create an epoll instance");
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+
+        if (epoll_ctl(m_epoll_descriptor, EPOLL_CTL_ADD, m_timer_descriptor, &event) != 0) {
+            close(m_epoll_descriptor);
+            close(m_timer_descriptor);
+            throwSystemError("register a timerfd with epoll");
+        }
+    }
+
+    ~TimerfdTimer() override {
+        close(m_epoll_descriptor);
+        close(m_timer_descriptor);
+    }
+
+    void wait(uint64_t interval_nanoseconds) override {
+        itimerspec timer_specification{};
+        timer_specification.it_value = ToTimespec(interval_nanoseconds);
+
+        if (timerfd_settime(m_timer_descriptor, 0, &timer_specification, nullptr) != 0) {
+            throwSystemError("arm a timerfd");
+        }
+
+        epoll_event event;
+
+        while (epoll_wait(m_epoll_descriptor, &event, 1, -1) < 0 && errno == EINTR) {
+        }
+
+        uint64_t expirations;
+        ssize_t bytes_read = read(m_timer_descriptor, &expirations, sizeof(expirations));
+        (void) bytes_read;
+    }
+};
+
+class FutexTimer : public WakeupTimer {
+private:
+
+    // Nobody ever wakes this word, so every wait ends in a timeout:
+    uint32_t m_futex_word = 0;
+
+public:
+
+    void wait(uint64_t interval_nanoseconds) override {
+        timespec timeout = ToTimespec(interval_nanoseconds);
+        syscall(SYS_futex, &m_futex_word, FUTEX_WAIT_PRIVATE, 0, &timeout, nullptr, 0);
+    }
+};
+#endif
+
+std::unique_ptr<WakeupTimer>
+com::github::coderodde::wtpdmt::createWakeupTimer(WakeupMechanism mechanism) {
+    switch (mechanism) {
+#ifdef _WIN32
+    case WakeupMechanism::SLEEP:
+        return std::make_unique<SleepTimer>();
+
+    case WakeupMechanism::WAITABLE_TIMER:
+        return std::make_unique<WaitableTimer>(0);
+
+    case WakeupMechanism::HIGH_RESOLUTION_TIMER:
+        return std::make_unique<WaitableTimer>(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION);
+
+    case WakeupMechanism::OBJECT_WAIT_TIMEOUT:
+        return std::make_unique<WaitTimeoutTimer>();
+#else
+    case WakeupMechanism::NANOSLEEP:
+        return std::make_unique<NanosleepTimer>();
+
+    case WakeupMechanism::CLOCK_NANOSLEEP:
+        return std::make_unique<ClockNanosleepTimer>();
+
+    case WakeupMechanism::TIMERFD:
+        return std::make_unique<TimerfdTimer>();
+
+    case WakeupMechanism::FUTEX:
+        return std::make_unique<FutexTimer>();
+#endif
+    default:
+        throw std::logic_error{ "Wakeup mechanism '"
+                              + getWakeupMechanismName(mechanism)
+                              + "' is not supported on this platform." };
+    }
+}
+
+#ifdef _WIN32
+static constexpr WakeupMechanism SUPPORTED_WAKEUP_MECHANISMS[] = {
+    WakeupMechanism::SLEEP,
+    WakeupMechanism::WAITABLE_TIMER,
+    WakeupMechanism::HIGH_RESOLUTION_TIMER,
+    WakeupMechanism::OBJECT_WAIT_TIMEOUT
+};
+#else
+static constexpr WakeupMechanism SUPPORTED_WAKEUP_MECHANISMS[] = {
+    WakeupMechanism::NANOSLEEP,
+    WakeupMechanism::CLOCK_NANOSLEEP,
+    WakeupMechanism::TIMERFD,
+    WakeupMechanism::FUTEX
+};
+#endif
+
+std::span<const WakeupMechanism> com::github::coderodde::wtpdmt::getSupportedWakeupMechanisms() {
+    return SUPPORTED_WAKEUP_MECHANISMS;
+}
+
+WakeupMechanism com::github::coderodde::wtpdmt::getPreciseWakeupMechanism() {
+#ifdef _WIN32
+    return WakeupMechanism::HIGH_RESOLUTION_TIMER;
+#else
+    return WakeupMechanism::CLOCK_NANOSLEEP;
+#endif
+}
+
+string com::github::coderodde::wtpdmt::getWakeupMechanismName(WakeupMechanism mechanism) {
+    switch (mechanism) {
+    case WakeupMechanism::SLEEP:                 return MECHANISM_SLEEP_STR;
+    case WakeupMechanism::WAITABLE_TIMER:        return MECHANISM_WAITABLE_TIMER_STR;
+    case WakeupMechanism::HIGH_RESOLUTION_TIMER: return MECHANISM_HIGH_RESOLUTION_TIMER_STR;
+    case WakeupMechanism::OBJECT_WAIT_TIMEOUT:   return MECHANISM_WAIT_TIMEOUT_STR;
+    case WakeupMechanism::NANOSLEEP:             return MECHANISM_NANOSLEEP_STR;
+    case WakeupMechanism::CLOCK_NANOSLEEP:       return MECHANISM_CLOCK_NANOSLEEP_STR;
+    case WakeupMechanism::TIMERFD:               return MECHANISM_TIMERFD_STR;
+    case WakeupMechanism::FUTEX:                 return MECHANISM_FUTEX_STR;
+    }
+
+    throw std::logic_error{ "Unknown wakeup mechanism." };
+}
+
+bool com::github::coderodde::wtpdmt::findWakeupMechanism(std::string_view name,
+                                                         WakeupMechanism* mechanism_ptr) {
+    for (WakeupMechanism mechanism : getSupportedWakeupMechanisms()) {
+        if (getWakeupMechanismName(mechanism) == name) {
+            *mechanism_ptr = mechanism;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint64_t com::github::coderodde::wtpdmt::getEffectiveIntervalNanoseconds(WakeupMechanism mechanism,
+                                                                         uint64_t interval_nanoseconds) {
+    switch (mechanism) {
+    case WakeupMechanism::SLEEP:
+    case WakeupMechanism::OBJECT_WAIT_TIMEOUT: {
+        uint64_t milliseconds = (interval_nanoseconds + NANOSECONDS_PER_MILLISECOND - 1)
+                              / NANOSECONDS_PER_MILLISECOND;
+        return milliseconds * NANOSECONDS_PER_MILLISECOND;
+    }
+
+    case WakeupMechanism::WAITABLE_TIMER:
+    case WakeupMechanism::HIGH_RESOLUTION_TIMER:
+        return interval_nanoseconds / 100 * 100;
+
+    default:
+        return interval_nanoseconds;
+    }
+}
+
+template<class Reader>
+static void MeasureWakeups(WakeupTimer& timer,
+                           size_t iterations,
+                           uint64_t interval_nanoseconds,
+                           uint64_t effective_interval_ticks,
+                           ThreadStatistics& thread_statistics) {
+    for (size_t i = 0; i < iterations; i++) {
+        uint64_t ta = Reader::read();
+        timer.wait(interval_nanoseconds);
+        uint64_t tb = Reader::read();
+        uint64_t elapsed = tb - ta;
+
+        if (elapsed < effective_interval_ticks) {
+            thread_statistics.early_wakeups++;
+            thread_statistics.histogram.record(0);
+        } else {
+            thread_statistics.histogram.record(elapsed - effective_interval_ticks);
+        }
+    }
+}
+
+// Measures every mechanism once. Mechanisms that could not run leave a
+// null aggregate.
+static void MeasureMechanisms(const WakeupConfiguration& configuration,
+                              const Clock& clock,
+                              std::vector<std::unique_ptr<Histogram>>& aggregates,
+                              std::vector<uint64_t>& early_wakeup_counts) {
+    for (WakeupMechanism mechanism : configuration.mechanisms) {
+        string name = wtpdmt::getWakeupMechanismName(mechanism);
+        uint64_t effective_interval_nanoseconds =
+            wtpdmt::getEffectiveIntervalNanoseconds(mechanism, configuration.interval_nanoseconds);
+        uint64_t effective_interval_ticks = static_cast<uint64_t>(
+            effective_interval_nanoseconds / clock.getNanosecondsPerTick());
+
+        std::cout << "INFO: Measuring " << configuration.iterations
+                  << " wakeups with " << name
+                  << ", requested interval " << effective_interval_nanoseconds << " ns.\n";
+
+        std::vector<std::unique_ptr<ThreadStatistics>> statistics;
+
+        try {
+            statistics = wtpdmt::runOnThreads(configuration.cpus,
+                                              configuration.thread_priority,
+                                              [&](size_t, ThreadStatistics& thread_statistics) {
+                std::unique_ptr<WakeupTimer> timer = wtpdmt::createWakeupTimer(mechanism);
+
+                Clock::dispatch(configuration.clock_source, [&](auto reader) {
+                    MeasureWakeups<decltype(reader)>(*timer,
+                                                     configuration.iterations,
+                                                     configuration.interval_nanoseconds,
+                                                     effective_interval_ticks,
+                                                     thread_statistics);
+                });
+            });
+        } catch (std::runtime_error& err) {
+            std::cout << "WARNING: Skipping " << name << ": " << err.what() << "\n";
+            aggregates.push_back(nullptr);
+            early_wakeup_counts.push_back(0);
+            continue;
+        }
+
+        std::unique_ptr<Histogram> aggregate = std::make_unique<Histogram>();
+        uint64_t early_wakeups = 0;
+
+        for (const auto& thread_statistics : statistics) {
+            aggregate->add(thread_statistics->histogram);
+            early_wakeups += thread_statistics->early_wakeups;
+        }
+
+        if (statistics.size() > 1) {
+            wtpdmt::printThreadTable(statistics, *aggregate, clock, configuration.percentiles);
+        }
+
+        aggregates.push_back(std::move(aggregate));
+        early_wakeup_counts.push_back(early_wakeups);
+    }
+}
+
+static void PrintEarlyWakeups(const std::vector<string>& mechanism_names,
+                              const std::vector<uint64_t>& early_wakeup_counts) {
+    for (size_t i = 0; i < mechanism_names.size(); i++) {
+        if (early_wakeup_counts[i] > 0) {
+            std::cout << "WARNING: " << mechanism_names[i] << " woke up early "
+                      << early_wakeup_counts[i] << " times; those count as zero overshoot.\n";
+        }
+    }
+}
+
+// Runs every mechanism once per timer setting. The CPU time the process
+// used per wakeup stands in for the power cost of a finer setting; it
+// includes any background load.
+static void RunTimerSweep(const WakeupConfiguration& configuration,
+                          const Clock& clock) {
+    string timer_name = wtpdmt::util::getTimerResolutionName();
+    std::vector<string> timer_labels;
+    std::vector<string> mechanism_names;
+    std::vector<std::vector<std::unique_ptr<Histogram>>> aggregates(configuration.timer_nanoseconds.size());
+    std::vector<std::vector<const Histogram*>> cells;
+    std::vector<uint64_t> cpu_nanoseconds_per_wakeup;
+
+    for (WakeupMechanism mechanism : configuration.mechanisms) {
+        mechanism_names.push_back(wtpdmt::getWakeupMechanismName(mechanism));
+    }
+
+    for (size_t i = 0; i < configuration.timer_nanoseconds.size(); i++) {
+        wtpdmt::util::setTimerResolution(configuration.timer_nanoseconds[i]);
+
+        uint64_t effective_nanoseconds = wtpdmt::util::getTimerResolution().current_nanoseconds;
+
+        std::cout << "\nINFO: Requested " << timer_name << " of " << configuration.timer_nanoseconds[i]
+                  << " ns, effective is " << effective_nanoseconds << " ns.\n";
+
+        std::vector<uint64_t> early_wakeup_counts;
+        uint64_t cpu_nanoseconds_before = wtpdmt::util::getProcessCpuNanoseconds();
+
+        MeasureMechanisms(configuration, clock, aggregates[i], early_wakeup_counts);
+
+        uint64_t cpu_nanoseconds = wtpdmt::util::getProcessCpuNanoseconds() - cpu_nanoseconds_before;
+        uint64_t wakeups = 0;
+        std::vector<const Histogram*> row;
+
+        for (const auto& aggregate : aggregates[i]) {
+            row.push_back(aggregate.get());
+
+            if (aggregate) {
+                wakeups += aggregate->getCount();
+            }
+        }
+
+        timer_labels.push_back(std::to_string(effective_nanoseconds));
+        cells.push_back(row);
+        cpu_nanoseconds_per_wakeup.push_back(wakeups == 0 ? 0 : cpu_nanoseconds / wakeups);
+
+        PrintEarlyWakeups(mechanism_names, early_wakeup_counts);
+    }
+
+    wtpdmt::util::resetTimerResolution();
+
+    std::cout << "\nINFO: Restored the " << timer_name << " to "
+              << wtpdmt::util::getTimerResolution().current_nanoseconds << " ns.\n";
+
+    if (!configuration.percentiles.empty()) {
+        std::cout << "\nTail wakeup overshoot by effective " << timer_name << " in ns (rows) and mechanism (columns):\n";
+        wtpdmt::printPercentileMatrix("Timer", timer_labels, mechanism_names, cells, clock,
+                                      *std::max_element(configuration.percentiles.begin(),
+                                                        configuration.percentiles.end()));
+    }
+
+    std::cout << "\nMaximum wakeup overshoot by effective " << timer_name << " in ns (rows) and mechanism (columns):\n";
+    wtpdmt::printPercentileMatrix("Timer", timer_labels, mechanism_names, cells, clock, 100.0);
+
+    std::cout << "\nProcess CPU time per wakeup by effective " << timer_name << ":\n";
+
+    for (size_t i = 0; i < timer_labels.size(); i++) {
+        std::cout << "  " << std::setw(12) << std::right << timer_labels[i] << " ns: "
+                  << cpu_nanoseconds_per_wakeup[i] << " ns\n";
+    }
+
+    std::cout << "\n";
+}
+
+void com::github::coderodde::wtpdmt::runWakeupMode(const WakeupConfiguration& configuration,
+                                                   const util::Clock& clock) {
+    if (configuration.timer_nanoseconds.size() > 1) {
+        RunTimerSweep(configuration, clock);
+        return;
+    }
+
+    std::vector<string> mechanism_names;
+    std::vector<std::unique_ptr<Histogram>> aggregates;
+    std::vector<uint64_t> early_wakeup_counts;
+    std::vector<uint64_t> measured_early_wakeup_counts;
+    std::vector<const Histogram*> histograms;
+
+    MeasureMechanisms(configuration, clock, aggregates, early_wakeup_counts);
+
+    // Skipped mechanisms stay out of the table:
+    for (size_t i = 0; i < aggregates.size(); i++) {
+        if (aggregates[i]) {
+            mechanism_names.push_back(getWakeupMechanismName(configuration.mechanisms[i]));
+            histograms.push_back(aggregates[i].get());
+            measured_early_wakeup_counts.push_back(early_wakeup_counts[i]);
+        }
+    }
+
+    std::cout << "\nWakeup overshoot past the requested interval:\n";
+    printHistogramTable("Mechanism", mechanism_names, histograms, clock, configuration.percentiles);
+    PrintEarlyWakeups(mechanism_names, measured_early_wakeup_counts);
+}
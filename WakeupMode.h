@@ -0,0 +1,68 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_WAKEUP_MODE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_WAKEUP_MODE_HPP
+
+#include "Clock.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using std::string;
+
+	enum class WakeupMechanism {
+		SLEEP,                 // Sleep()
+		WAITABLE_TIMER,        // CreateWaitableTimerEx() + WaitForSingleObject()
+		HIGH_RESOLUTION_TIMER, // ... with CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+		OBJECT_WAIT_TIMEOUT,   // WaitForSingleObject() timing out on an event
+		NANOSLEEP,             // nanosleep(), relative
+		CLOCK_NANOSLEEP,       // clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)
+		TIMERFD,               // timerfd + epoll_wait()
+		FUTEX                  // FUTEX_WAIT timing out
+	};
+
+	// One thread's instance of a sleeping primitive. Instances hold kernel
+	// objects and must be used from the thread that created them.
+	class WakeupTimer {
+	public:
+
+		virtual ~WakeupTimer() = default;
+
+		// Blocks for about 'interval_nanoseconds'.
+		virtual void wait(uint64_t interval_nanoseconds) = 0;
+	};
+
+	std::unique_ptr<WakeupTimer> createWakeupTimer(WakeupMechanism mechanism);
+
+	std::span<const WakeupMechanism> getSupportedWakeupMechanisms();
+	// The supported mechanism with the finest granularity.
+	WakeupMechanism getPreciseWakeupMechanism();
+	string getWakeupMechanismName(WakeupMechanism mechanism);
+	bool findWakeupMechanism(std::string_view name, WakeupMechanism* mechanism_ptr);
+
+	// Millisecond-based primitives cannot sleep for less than a
+	// millisecond; the overshoot is measured against what they can do.
+	uint64_t getEffectiveIntervalNanoseconds(WakeupMechanism mechanism,
+											 uint64_t interval_nanoseconds);
+
+	struct WakeupConfiguration {
+		util::ClockSource            clock_source;
+		size_t                       iterations;
+		uint64_t                     interval_nanoseconds;
+		int                          thread_priority;
+		std::vector<int>             cpus;
+		std::vector<WakeupMechanism> mechanisms;
+		std::vector<double>          percentiles;
+		std::vector<uint64_t>        timer_nanoseconds; // Two or more to sweep; see below.
+	};
+
+	// Measures and prints the overshoot distribution of every mechanism.
+	// With several timer settings it measures every mechanism under each
+	// of them in turn, then compares their overshoot and the CPU time
+	// the process spent per wakeup, and restores the setting.
+	void runWakeupMode(const WakeupConfiguration& configuration, const util::Clock& clock);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_WAKEUP_MODE_HPP
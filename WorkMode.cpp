@@ -0,0 +1,350 @@
+#include "WorkMode.h"
+#include "Measurement.h"
+#include "Report.h"
+#include "Topology.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+using com::github::coderodde::wtpdmt::WorkConfiguration;
+using com::github::coderodde::wtpdmt::WorkKernel;
+using com::github::coderodde::wtpdmt::util::CacheSizes;
+using com::github::coderodde::wtpdmt::util::Clock;
+using com::github::coderodde::wtpdmt::util::Histogram;
+
+// Kernel names as accepted by --kernels:
+static const string KERNEL_ALU_STR       = "alu";
+static const string KERNEL_CHASE_L1_STR  = "chase-l1";
+static const string KERNEL_CHASE_L2_STR  = "chase-l2";
+static const string KERNEL_CHASE_LLC_STR = "chase-llc";
+static const string KERNEL_STREAM_STR    = "stream";
+
+// A last-level cache of a large server would take a lot of memory per
+// thread to cover:
+static const size_t MAXIMUM_CHASE_BYTES = 128 * 1024 * 1024;
+
+// The same sequence on every run and thread, so that runs compare:
+static const uint64_t CHASE_SEED = 0x5DEECE66DULL;
+
+// Where the kernels' results go so that the compiler cannot drop the work.
+static std::atomic<uint64_t> work_sink{ 0 };
+
+struct AluKernel {
+    uint64_t state = 1;
+
+    // Each step depends on the previous one, so the latency of the
+    // multiplier rather than its throughput sets the pace.
+    uint64_t run(size_t steps) {
+        uint64_t x = state;
+
+        for (size_t i = 0; i < steps; i++) {
+            x ^= x >> 29;
+            x *= 0xBF58476D1CE4E5B9ULL;
+        }
+
+        state = x;
+        return x;
+    }
+};
+
+struct alignas(com::github::coderodde::wtpdmt::util::CACHE_LINE_SIZE) ChaseNode {
+    ChaseNode* next;
+};
+
+// One node per cache line, linked in a random cycle so that the
+// prefetchers cannot guess the next line. Each iteration goes on where the
+// previous one stopped.
+class ChaseKernel {
+private:
+
+    std::vector<ChaseNode> m_nodes;
+    ChaseNode*             m_current;
+
+public:
+
+    explicit ChaseKernel(size_t bytes) :
+        m_nodes  ((std::max)(bytes / sizeof(ChaseNode), size_t(2))),
+        m_current{ nullptr }
+    {
+        // Sattolo's algorithm yields a single cycle through all nodes:
+        std::vector<size_t> order(m_nodes.size());
+        std::mt19937_64 random(CHASE_SEED);
+
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+
+        for (size_t i = order.size() - 1; i > 0; i--) {
+            std::uniform_int_distribution<size_t> distribution(0, i - 1);
+            std::swap(order[i], order[distribution(random)]);
+        }
+
+        for (size_t i = 0; i < order.size(); i++) {
+            m_nodes[order[i]].next = &m_nodes[order[(i + 1) % order.size()]];
+        }
+
+        m_current = &m_nodes[0];
+    }
+
+    uint64_t run(size_t steps) {
+        ChaseNode* node = m_current;
+
+        for (size_t i = 0; i < steps; i++) {
+            node = node->next;
+        }
+
+        m_current = node;
+        return reinterpret_cast<uintptr_t>(node);
+    }
+};
+
+// a = b + 3c over three arrays that fit the L2 cache together, a step per
+// element. The loop body is plain enough for the compiler to vectorize,
+// so the vector units and the L1/L2 bandwidth set the pace.
+class StreamKernel {
+private:
+
+    std::vector<double> m_a;
+    std::vector<double> m_b;
+    std::vector<double> m_c;
+    size_t              m_position;
+
+public:
+
+    explicit StreamKernel(size_t bytes) :
+        m_a((std::max)(bytes / (3 * sizeof(double)), size_t(1)), 0.0),
+        m_b(m_a.size(), 1.0),
+        m_c(m_a.size(), 2.0),
+        m_position{ 0 } {}
+
+    uint64_t run(size_t steps) {
+        size_t length = m_a.size();
+
+        while (steps > 0) {
+            size_t chunk = (std::min)(steps, length - m_position);
+            double* a = m_a.data() + m_position;
+            const double* b = m_b.data() + m_position;
+            const double* c = m_c.data() + m_position;
+
+            for (size_t i = 0; i < chunk; i++) {
+                a[i] = b[i] + 3.0 * c[i];
+            }
+
+            m_position = (m_position + chunk) % length;
+            steps -= chunk;
+        }
+
+        uint64_t bits;
+        std::memcpy(&bits, &m_a[m_position], sizeof(bits));
+        return bits;
+    }
+};
+
+template<class Reader, class Kernel>
+static void MeasureWork(Kernel& kernel,
+                        size_t warmup_iterations,
+                        size_t iterations,
+                        size_t steps,
+                        Histogram& histogram) {
+    uint64_t sink = 0;
+
+    // Fill the caches and let the frequency settle:
+    for (size_t i = 0; i < warmup_iterations; i++) {
+        sink += kernel.run(steps);
+    }
+
+    for (size_t i = 0; i < iterations; i++) {
+        uint64_t start_ticks = Reader::read();
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        sink += kernel.run(steps);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        uint64_t end_ticks = Reader::read();
+        histogram.record(end_ticks - start_ticks);
+    }
+
+    work_sink.fetch_add(sink, std::memory_order_relaxed);
+}
+
+template<class Kernel>
+static void MeasureKernel(Kernel& kernel,
+                          const WorkConfiguration& configuration,
+                          Histogram& histogram) {
+    Clock::dispatch(configuration.clock_source, [&](auto reader) {
+        MeasureWork<decltype(reader)>(kernel,
+                                      configuration.iterations / 10,
+                                      configuration.iterations,
+                                      configuration.steps,
+                                      histogram);
+    });
+}
+
+static size_t GetWorkingSetBytes(WorkKernel kernel, const CacheSizes& cache_sizes) {
+    switch (kernel) {
+    case WorkKernel::ALU:       return 0;
+    case WorkKernel::CHASE_L1:  return cache_sizes.level1_data / 2;
+    case WorkKernel::CHASE_L2:  return cache_sizes.level2 / 2;
+    case WorkKernel::CHASE_LLC: return (std::min)(cache_sizes.last_level / 2, MAXIMUM_CHASE_BYTES);
+    case WorkKernel::STREAM:    return cache_sizes.level2 / 2;
+    }
+
+    throw std::logic_error{ "Unknown work kernel." };
+}
+
+// Builds the kernel on the measuring thread, so that its memory is local
+// to it, and times it.
+static void RunKernel(WorkKernel kernel,
+                      size_t working_set_bytes,
+                      const WorkConfiguration& configuration,
+                      Histogram& histogram) {
+    switch (kernel) {
+    case WorkKernel::ALU: {
+        AluKernel alu_kernel;
+        MeasureKernel(alu_kernel, configuration, histogram);
+        return;
+    }
+
+    case WorkKernel::CHASE_L1:
+    case WorkKernel::CHASE_L2:
+    case WorkKernel::CHASE_LLC: {
+        ChaseKernel chase_kernel(working_set_bytes);
+        MeasureKernel(chase_kernel, configuration, histogram);
+        return;
+    }
+
+    case WorkKernel::STREAM: {
+        StreamKernel stream_kernel(working_set_bytes);
+        MeasureKernel(stream_kernel, configuration, histogram);
+        return;
+    }
+    }
+}
+
+static constexpr WorkKernel WORK_KERNELS[] = {
+    WorkKernel::ALU,
+    WorkKernel::CHASE_L1,
+    WorkKernel::CHASE_L2,
+    WorkKernel::CHASE_LLC,
+    WorkKernel::STREAM
+};
+
+std::span<const WorkKernel> com::github::coderodde::wtpdmt::getWorkKernels() {
+    return WORK_KERNELS;
+}
+
+string com::github::coderodde::wtpdmt::getWorkKernelName(WorkKernel kernel) {
+    switch (kernel) {
+    case WorkKernel::ALU:       return KERNEL_ALU_STR;
+    case WorkKernel::CHASE_L1:  return KERNEL_CHASE_L1_STR;
+    case WorkKernel::CHASE_L2:  return KERNEL_CHASE_L2_STR;
+    case WorkKernel::CHASE_LLC: return KERNEL_CHASE_LLC_STR;
+    case WorkKernel::STREAM:    return KERNEL_STREAM_STR;
+    }
+
+    throw std::logic_error{ "Unknown work kernel." };
+}
+
+bool com::github::coderodde::wtpdmt::findWorkKernel(std::string_view name, WorkKernel* kernel_ptr) {
+    for (WorkKernel kernel : getWorkKernels()) {
+        if (getWorkKernelName(kernel) == name) {
+            *kernel_ptr = kernel;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void com::github::coderodde::wtpdmt::runWorkMode(const WorkConfiguration& configuration,
+                                                 const util::Clock& clock) {
+    CacheSizes cache_sizes = util::getCacheSizes();
+    std::vector<string> kernel_names;
+    std::vector<std::unique_ptr<Histogram>> aggregates;
+
+    std::cout << "INFO: Data caches of CPU 0: L1 " << cache_sizes.level1_data / 1024
+              << " KiB, L2 " << cache_sizes.level2 / 1024
+              << " KiB, last level " << cache_sizes.last_level / 1024 << " KiB.\n";
+
+    for (WorkKernel kernel : configuration.kernels) {
+        string name = getWorkKernelName(kernel);
+        size_t working_set_bytes = GetWorkingSetBytes(kernel, cache_sizes);
+
+        std::cout << "INFO: Measuring " << configuration.iterations
+                  << " iterations of " << configuration.steps
+                  << " steps with " << name;
+
+        if (working_set_bytes > 0) {
+            std::cout << " over " << working_set_bytes / 1024 << " KiB";
+        }
+
+        std::cout << ".\n";
+
+        std::vector<std::unique_ptr<ThreadStatistics>> statistics;
+
+        try {
+            statistics = runOnThreads(configuration.cpus,
+                                      configuration.thread_priority,
+                                      [&](size_t, ThreadStatistics& thread_statistics) {
+                RunKernel(kernel, working_set_bytes, configuration, thread_statistics.histogram);
+            });
+        } catch (std::runtime_error& err) {
+            std::cout << "WARNING: Skipping " << name << ": " << err.what() << "\n";
+            continue;
+        }
+
+        std::unique_ptr<Histogram> aggregate = std::make_unique<Histogram>();
+
+        for (const auto& thread_statistics : statistics) {
+            aggregate->add(thread_statistics->histogram);
+        }
+
+        if (statistics.size() > 1) {
+            printThreadTable(statistics, *aggregate, clock, configuration.percentiles);
+        }
+
+        kernel_names.push_back(name);
+        aggregates.push_back(std::move(aggregate));
+    }
+
+    std::vector<const Histogram*> histograms;
+
+    for (const auto& aggregate : aggregates) {
+        histograms.push_back(aggregate.get());
+    }
+
+    std::cout << "\nExecution time per iteration of " << configuration.steps << " steps:\n";
+    printHistogramTable("Kernel", kernel_names, histograms, clock, configuration.percentiles);
+
+    // The fastest iteration is what the kernel costs undisturbed; how far
+    // the rest stray from it is the jitter:
+    std::cout << "\n" << std::fixed << std::setprecision(2);
+
+    for (size_t i = 0; i < histograms.size(); i++) {
+        double minimum_nanoseconds = static_cast<double>(clock.ticksToNanoseconds(histograms[i]->getMinimum()));
+        double median_nanoseconds = static_cast<double>(clock.ticksToNanoseconds(histograms[i]->getValueAtPercentile(50.0)));
+        double maximum_nanoseconds = static_cast<double>(clock.ticksToNanoseconds(histograms[i]->getMaximum()));
+
+        std::cout << "INFO: " << kernel_names[i] << " takes "
+                  << median_nanoseconds / static_cast<double>(configuration.steps)
+                  << " ns per step at the median; the slowest iteration took ";
+
+        if (minimum_nanoseconds > 0.0) {
+            std::cout << maximum_nanoseconds / minimum_nanoseconds << " times as long as the fastest.\n";
+        } else {
+            std::cout << maximum_nanoseconds << " ns.\n";
+        }
+    }
+
+    std::cout << std::defaultfloat;
+}
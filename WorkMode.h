@@ -0,0 +1,43 @@
+#ifndef COM_GITHUB_CODERODDE_WTPDMT_WORK_MODE_HPP
+#define COM_GITHUB_CODERODDE_WTPDMT_WORK_MODE_HPP
+
+#include "Clock.h"
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace com::github::coderodde::wtpdmt {
+
+	using std::string;
+
+	enum class WorkKernel {
+		ALU,       // A dependent chain of multiplies and shifts in registers
+		CHASE_L1,  // A random pointer chase over half the L1 data cache
+		CHASE_L2,  // ... over half the L2 cache
+		CHASE_LLC, // ... over half the last-level cache
+		STREAM     // A vectorizable triad over arrays that fit the L2 cache
+	};
+
+	std::span<const WorkKernel> getWorkKernels();
+	string getWorkKernelName(WorkKernel kernel);
+	bool findWorkKernel(std::string_view name, WorkKernel* kernel_ptr);
+
+	struct WorkConfiguration {
+		util::ClockSource       clock_source;
+		size_t                  iterations; // Timed iterations per kernel and thread.
+		size_t                  steps;      // Multiplies, hops or elements per iteration.
+		int                     thread_priority;
+		std::vector<int>        cpus;
+		std::vector<WorkKernel> kernels;
+		std::vector<double>     percentiles;
+	};
+
+	// Runs every kernel for a fixed number of steps per iteration and
+	// prints the distribution of the iteration times. Unlike the gaps, this
+	// also sees a thread that runs but gets less done: evicted caches, a
+	// busy SMT sibling, a lower frequency.
+	void runWorkMode(const WorkConfiguration& configuration, const util::Clock& clock);
+} // End of namespace com::github::coderodde::wtpdmt
+#endif // COM_GITHUB_CODERODDE_WTPDMT_WORK_MODE_HPP
@@ -1,10 +1,111 @@
+#include "Baseline.h"
+#include "Clock.h"
 #include "CommandLineParser.h"
-#include <iomanip>
+#include "DaemonMode.h"
+#include "Histogram.h"
+#include "InversionMode.h"
+#include "LiveReporter.h"
+#include "LoadGenerator.h"
+#include "Measurement.h"
+#include "MemoryControl.h"
+#include "PeriodicMode.h"
+#include "PingPongMode.h"
+#include "PowerStates.h"
+#include "ProbeMode.h"
+#include "Report.h"
+#include "RunSetup.h"
+#include "SurveyMode.h"
+#include "SweepMode.h"
+#include "TraceWriter.h"
+#include "ThreadControl.h"
+#include "WakeupMode.h"
+#include "WorkMode.h"
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <span>
+#include <sstream>
 #include <string>
-#include <windows.h>
+#include <vector>
 
 using std::string;
+using com::github::coderodde::wtpdmt::util::Clock;
+using com::github::coderodde::wtpdmt::util::Histogram;
+using com::github::coderodde::wtpdmt::Baseline;
+using com::github::coderodde::wtpdmt::DaemonConfiguration;
+using com::github::coderodde::wtpdmt::InversionConfiguration;
+using com::github::coderodde::wtpdmt::LiveReporter;
+using com::github::coderodde::wtpdmt::LoadGenerator;
+using com::github::coderodde::wtpdmt::LoadSpecification;
+using com::github::coderodde::wtpdmt::MeasurementConfiguration;
+using com::github::coderodde::wtpdmt::PeriodicConfiguration;
+using com::github::coderodde::wtpdmt::PingPongConfiguration;
+using com::github::coderodde::wtpdmt::PowerCounterSource;
+using com::github::coderodde::wtpdmt::PowerStateStatistics;
+using com::github::coderodde::wtpdmt::ProbeConfiguration;
+using com::github::coderodde::wtpdmt::RunSetup;
+using com::github::coderodde::wtpdmt::SurveyConfiguration;
+using com::github::coderodde::wtpdmt::SweepConfiguration;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+using com::github::coderodde::wtpdmt::TraceWriter;
+using com::github::coderodde::wtpdmt::WakeupConfiguration;
+using com::github::coderodde::wtpdmt::WorkConfiguration;
+using com::github::coderodde::wtpdmt::util::MeasurementMode;
+using com::github::coderodde::wtpdmt::util::PageFaultCounts;
+
+// Faults taken during the run point at memory stalls rather than at the
+// scheduler. The counts are process-wide and include setting up the
+// measuring threads, whose stacks mlockall() faults in at creation.
+static void PrintRunStatistics(const PageFaultCounts& page_faults_before,
+							   const PageFaultCounts& page_faults_after) {
+	com::github::coderodde::wtpdmt::printTimerResolution("After the run");
+
+	std::cout << "INFO: Page faults during the run: "
+			  << page_faults_after.minor_faults - page_faults_before.minor_faults
+			  << " minor";
+
+	if (com::github::coderodde::wtpdmt::util::MAJOR_PAGE_FAULTS_AVAILABLE) {
+		std::cout << ", "
+				  << page_faults_after.major_faults - page_faults_before.major_faults
+				  << " major";
+	}
+
+	std::cout << ".\n";
+
+	if (com::github::coderodde::wtpdmt::util::getMemoryPolicy().large_pages) {
+		com::github::coderodde::wtpdmt::util::MeasurementMemoryStatistics memory_statistics =
+			com::github::coderodde::wtpdmt::util::getMeasurementMemoryStatistics();
+
+		std::cout << "INFO: "
+				  << memory_statistics.large_page_allocations
+				  << " of "
+				  << memory_statistics.allocations
+				  << " measurement buffers are backed by large pages.\n";
+	}
+}
+
+// Stops the background load, if any, and shows how much of it ran; a load
+// that barely ran did not interfere much.
+static void StopLoadGenerator(LoadGenerator* load_generator) {
+	if (load_generator == nullptr) {
+		return;
+	}
+
+	load_generator->stop();
+
+	for (size_t i = 0; i < load_generator->getLoads().size(); i++) {
+		const LoadSpecification& load = load_generator->getLoads()[i];
+
+		std::cout << "INFO: Load "
+				  << com::github::coderodde::wtpdmt::getLoadKindName(load.kind);
+
+		if (load.cpu != com::github::coderodde::wtpdmt::UNPINNED_CPU) {
+			std::cout << " on CPU " << load.cpu;
+		}
+
+		std::cout << " ran " << load_generator->getRoundCount(i) << " rounds.\n";
+	}
+}
 
 int main(int argc, char* argv[]) try {
 	com::github::coderodde::wtpdmt::util::CommandLineParser clp(argc, argv);
@@ -14,75 +115,339 @@ int main(int argc, char* argv[]) try {
 		return EXIT_SUCCESS;
 	}
 
-	string priority_class_name  = clp.getPriorityClassName(clp.getPriorityClass());
-	string thread_priority_name = clp.getThreadPriorityName(clp.getThreadPriority());
-
-	size_t field_length = max(priority_class_name.length(), 
-							  thread_priority_name.length());
-	
-	std::cout << "Number of iterations:      " 
-		      << clp.getNumberOfIterations()
-		      << "\n";
-
-	std::cout << "Requested priority class:  "  
-		      << std::setw(field_length)
-		      << std::left 
-			  << std::setfill(' ')
-		      << priority_class_name
-		      << " (0x" 
-		      << std::setw(8)
-		      << std::right
-		      << std::setfill('0')
-		      << std::hex
-		      << clp.getPriorityClass()
-		      << " = "
-		      << std::dec
-		      << clp.getPriorityClass()
-		      << ")\n";
-
-	std::cout << "Requested thread priority: " 
-		      << std::setw(field_length) 
-		      << std::left
-			  << std::setfill(' ')
-		      << thread_priority_name
-		      << " (0x"
-		      << std::setw(8)
-		      << std::right
-		      << std::setfill('0')
-		      << std::hex
-		      << clp.getThreadPriority() 
-			  << " = "
-		      << std::dec
-		      << clp.getThreadPriority()
-		      << ")\n\n";
-
-	HANDLE process_handle = GetCurrentProcess();
-	HANDLE thread_handle  = GetCurrentThread();
-
-	SetPriorityClass(process_handle, clp.getPriorityClass());
-	SetThreadPriority(thread_handle, clp.getThreadPriority());
-
-	std::cout << "INFO: Effective process class is   " 
-			  << clp.getPriorityClassName(GetPriorityClass(process_handle))
-			  << ".\n";
-
-	std::cout << "INFO: Effective thread priority is "
-			  << clp.getThreadPriorityName(GetThreadPriority(thread_handle))
-			  << ".\n\n";
-
-	ULONGLONG ta = GetTickCount64();
-	ULONGLONG maximumDuration = 0;
-
-	for (int i = 0; i < clp.getNumberOfIterations(); i++) {
-		ULONGLONG tb = GetTickCount64();
-		ULONGLONG duration = tb - ta;
-		maximumDuration = max(maximumDuration, duration);
-		ta = tb;
-	}
-
-	std::cout << "INFO: Maximum sleep duration: " << maximumDuration << "\n";
-	return EXIT_SUCCESS;
+	RunSetup setup = com::github::coderodde::wtpdmt::setUpRun(clp);
+	const Clock& clock = setup.clock;
+	PowerCounterSource power_counter_source = setup.power_counter_source;
+
+	// The parser hands out its default tables without copying them; the
+	// modes keep a copy of their own:
+	std::span<const double> percentile_list = clp.getPercentiles();
+	std::vector<double> percentiles(percentile_list.begin(), percentile_list.end());
+
+	std::unique_ptr<LoadGenerator> load_generator;
+
+	if (!clp.getLoads().empty()) {
+		load_generator = std::make_unique<LoadGenerator>(clp.getLoads());
+		load_generator->start();
+
+		std::cout << "INFO: Started " << clp.getLoads().size() << " background load threads.\n";
+	}
+
+	PageFaultCounts page_faults_before = com::github::coderodde::wtpdmt::util::getPageFaultCounts();
+
+	if (clp.getMode() == MeasurementMode::WAKEUP) {
+		WakeupConfiguration wakeup_configuration;
+		wakeup_configuration.clock_source         = clock.getSource();
+		wakeup_configuration.iterations           = clp.getNumberOfIterations();
+		wakeup_configuration.interval_nanoseconds = clp.getIntervalNanoseconds();
+		wakeup_configuration.thread_priority      = clp.getThreadPriority();
+		wakeup_configuration.cpus                 = clp.getMeasurementCpus();
+		wakeup_configuration.mechanisms.assign(clp.getMechanisms().begin(), clp.getMechanisms().end());
+		wakeup_configuration.percentiles          = percentiles;
+		wakeup_configuration.timer_nanoseconds    = clp.getTimerNanoseconds();
+
+		com::github::coderodde::wtpdmt::runWakeupMode(wakeup_configuration, clock);
+		StopLoadGenerator(load_generator.get());
+		PrintRunStatistics(page_faults_before,
+						   com::github::coderodde::wtpdmt::util::getPageFaultCounts());
+		return EXIT_SUCCESS;
+	}
+
+	if (clp.getMode() == MeasurementMode::PERIODIC) {
+		PeriodicConfiguration periodic_configuration;
+		periodic_configuration.clock_source = clock.getSource();
+		periodic_configuration.iterations   = clp.getNumberOfIterations();
+		periodic_configuration.tasks        = clp.getTasks();
+		periodic_configuration.cpus         = clp.getMeasurementCpus();
+		periodic_configuration.mechanism    = clp.getPeriodicMechanism();
+		periodic_configuration.percentiles  = percentiles;
+
+		com::github::coderodde::wtpdmt::runPeriodicMode(periodic_configuration, clock);
+		StopLoadGenerator(load_generator.get());
+		PrintRunStatistics(page_faults_before,
+						   com::github::coderodde::wtpdmt::util::getPageFaultCounts());
+		return EXIT_SUCCESS;
+	}
+
+	if (clp.getMode() == MeasurementMode::INVERSION) {
+		InversionConfiguration inversion_configuration;
+		std::vector<int> thread_priorities = clp.getScenarioThreadPriorities();
+		inversion_configuration.clock_source     = clock.getSource();
+		inversion_configuration.iterations       = clp.getNumberOfIterations();
+		inversion_configuration.hold_nanoseconds = clp.getHoldNanoseconds();
+		inversion_configuration.cpu              = clp.getMeasurementCpus()[0];
+		inversion_configuration.locks.assign(clp.getLocks().begin(), clp.getLocks().end());
+		inversion_configuration.percentiles      = percentiles;
+		std::copy(thread_priorities.begin(), thread_priorities.end(), inversion_configuration.thread_priorities);
+
+		com::github::coderodde::wtpdmt::runInversionMode(inversion_configuration, clock);
+		StopLoadGenerator(load_generator.get());
+		PrintRunStatistics(page_faults_before,
+						   com::github::coderodde::wtpdmt::util::getPageFaultCounts());
+		return EXIT_SUCCESS;
+	}
+
+	if (clp.getMode() == MeasurementMode::PING_PONG) {
+		PingPongConfiguration ping_pong_configuration;
+		std::vector<int> thread_priorities = clp.getScenarioThreadPriorities();
+		ping_pong_configuration.clock_source = clock.getSource();
+		ping_pong_configuration.iterations   = clp.getNumberOfIterations();
+		ping_pong_configuration.cpus         = clp.getMeasurementCpus();
+		ping_pong_configuration.primitives.assign(clp.getPrimitives().begin(), clp.getPrimitives().end());
+		ping_pong_configuration.percentiles  = percentiles;
+		std::copy(thread_priorities.begin(), thread_priorities.end(), ping_pong_configuration.thread_priorities);
+
+		com::github::coderodde::wtpdmt::runPingPongMode(ping_pong_configuration, clock);
+		StopLoadGenerator(load_generator.get());
+		PrintRunStatistics(page_faults_before,
+						   com::github::coderodde::wtpdmt::util::getPageFaultCounts());
+		return EXIT_SUCCESS;
+	}
+
+	if (clp.getMode() == MeasurementMode::WORK) {
+		WorkConfiguration work_configuration;
+		work_configuration.clock_source    = clock.getSource();
+		work_configuration.iterations      = clp.getNumberOfIterations();
+		work_configuration.steps           = clp.getSteps();
+		work_configuration.thread_priority = clp.getThreadPriority();
+		work_configuration.cpus            = clp.getMeasurementCpus();
+		work_configuration.kernels.assign(clp.getKernels().begin(), clp.getKernels().end());
+		work_configuration.percentiles     = percentiles;
+
+		com::github::coderodde::wtpdmt::runWorkMode(work_configuration, clock);
+		StopLoadGenerator(load_generator.get());
+		PrintRunStatistics(page_faults_before,
+						   com::github::coderodde::wtpdmt::util::getPageFaultCounts());
+		return EXIT_SUCCESS;
+	}
+
+	if (clp.getMode() == MeasurementMode::SURVEY) {
+		SurveyConfiguration survey_configuration;
+		std::vector<int> cpus = clp.getMeasurementCpus();
+		survey_configuration.clock_source    = clock.getSource();
+		survey_configuration.iterations      = clp.getNumberOfIterations();
+		survey_configuration.thread_priority = clp.getThreadPriority();
+		survey_configuration.percentiles     = percentiles;
+		survey_configuration.threshold_ticks =
+			static_cast<uint64_t>(static_cast<double>(clp.getThresholdNanoseconds())
+								  / clock.getNanosecondsPerTick());
+
+		// A single unpinned thread means no CPUs were given; survey them all:
+		if (cpus.size() > 1 || cpus[0] != com::github::coderodde::wtpdmt::UNPINNED_CPU) {
+			survey_configuration.cpus = cpus;
+		}
+
+		com::github::coderodde::wtpdmt::runSurveyMode(survey_configuration, clock);
+		StopLoadGenerator(load_generator.get());
+		PrintRunStatistics(page_faults_before,
+						   com::github::coderodde::wtpdmt::util::getPageFaultCounts());
+		return EXIT_SUCCESS;
+	}
+
+	if (clp.getMode() == MeasurementMode::PROBE) {
+		ProbeConfiguration probe_configuration;
+		probe_configuration.clock_source                   = clock.getSource();
+		probe_configuration.priority_class                 = clp.getPriorityClass();
+		probe_configuration.thread_priority                = clp.getThreadPriority();
+		probe_configuration.cpu                            = clp.getMeasurementCpus()[0];
+		probe_configuration.duration_milliseconds          = clp.getDurationMilliseconds();
+		probe_configuration.snapshot_interval_milliseconds = clp.getProbeSnapshotIntervalMilliseconds();
+		probe_configuration.threshold_nanoseconds          = clp.getThresholdNanoseconds();
+
+		com::github::coderodde::wtpdmt::runProbeMode(probe_configuration);
+		PrintRunStatistics(page_faults_before,
+						   com::github::coderodde::wtpdmt::util::getPageFaultCounts());
+		return EXIT_SUCCESS;
+	}
+
+	if (clp.daemonRequested()) {
+		DaemonConfiguration daemon_configuration;
+		daemon_configuration.clock_source          = clock.getSource();
+		daemon_configuration.thread_priority       = clp.getThreadPriority();
+		daemon_configuration.cpus                  = clp.getMeasurementCpus();
+		daemon_configuration.segment_name          = clp.getDaemonSegmentName();
+		daemon_configuration.interval_milliseconds = clp.getDaemonIntervalMilliseconds();
+		daemon_configuration.window_intervals      = clp.getWindowIntervals();
+		daemon_configuration.percentiles           = percentiles;
+
+		com::github::coderodde::wtpdmt::runDaemonMode(daemon_configuration, clock);
+		StopLoadGenerator(load_generator.get());
+		PrintRunStatistics(page_faults_before,
+						   com::github::coderodde::wtpdmt::util::getPageFaultCounts());
+		return EXIT_SUCCESS;
+	}
+
+	if (clp.sweepRequested()) {
+		SweepConfiguration sweep_configuration;
+		sweep_configuration.clock_source          = clock.getSource();
+		sweep_configuration.iterations            = clp.getNumberOfIterations();
+		sweep_configuration.warmup_iterations     = clp.getNumberOfIterations() / 10;
+		sweep_configuration.cpus                  = clp.getMeasurementCpus();
+		sweep_configuration.class_names           = clp.getSweepClassNames();
+		sweep_configuration.thread_priority_names = clp.getSweepThreadPriorityNames();
+		sweep_configuration.points                = clp.getSweepPoints();
+		sweep_configuration.percentiles           = percentiles;
+		sweep_configuration.power_counter_source  = power_counter_source;
+		sweep_configuration.power_threshold_ticks =
+			static_cast<uint64_t>(static_cast<double>(clp.getPowerThresholdNanoseconds())
+								  / clock.getNanosecondsPerTick());
+
+		com::github::coderodde::wtpdmt::runSweepMode(sweep_configuration, clock);
+		StopLoadGenerator(load_generator.get());
+		PrintRunStatistics(page_faults_before,
+						   com::github::coderodde::wtpdmt::util::getPageFaultCounts());
+		return EXIT_SUCCESS;
+	}
+
+	MeasurementConfiguration configuration;
+	configuration.clock_source         = clock.getSource();
+	configuration.iterations           = clp.getNumberOfIterations();
+	configuration.thread_priority      = clp.getThreadPriority();
+	configuration.cpus                 = clp.getMeasurementCpus();
+	configuration.trace_writer         = nullptr;
+	configuration.live_reporter        = nullptr;
+	configuration.attribute_gaps       = clp.attributionRequested();
+	configuration.nanoseconds_per_tick = clock.getNanosecondsPerTick();
+	configuration.attribution_threshold_ticks =
+		static_cast<uint64_t>(static_cast<double>(clp.getAttributionThresholdNanoseconds())
+							  / clock.getNanosecondsPerTick());
+	configuration.power_counter_source = power_counter_source;
+	configuration.power_threshold_ticks =
+		static_cast<uint64_t>(static_cast<double>(clp.getPowerThresholdNanoseconds())
+							  / clock.getNanosecondsPerTick());
+
+	// A missing or broken baseline should fail before the run, not after:
+	std::unique_ptr<Baseline> baseline;
+
+	if (clp.compareRequested()) {
+		baseline = com::github::coderodde::wtpdmt::loadBaseline(clp.getComparePath());
+	}
+
+	std::unique_ptr<TraceWriter> trace_writer;
+
+	if (clp.traceRequested()) {
+		trace_writer = std::make_unique<TraceWriter>(clp.getTracePath(),
+													 clock,
+													 clp.getThresholdNanoseconds(),
+													 configuration.cpus);
+		configuration.trace_writer = trace_writer.get();
+		trace_writer->start();
+	}
+
+	std::unique_ptr<LiveReporter> live_reporter;
+
+	if (clp.getReportIntervalMilliseconds() > 0) {
+		live_reporter = std::make_unique<LiveReporter>(clock,
+													   configuration.cpus,
+													   clp.getReportIntervalMilliseconds(),
+													   clp.getReportFormat(),
+													   percentiles);
+		configuration.live_reporter = live_reporter.get();
+		live_reporter->start();
+	}
+
+	std::vector<std::unique_ptr<ThreadStatistics>> statistics =
+		com::github::coderodde::wtpdmt::runMeasurement(configuration);
+
+	if (live_reporter) {
+		live_reporter->stop(statistics);
+		std::cout << "\n";
+	}
+
+	PageFaultCounts page_faults_after = com::github::coderodde::wtpdmt::util::getPageFaultCounts();
+	StopLoadGenerator(load_generator.get());
+
+	if (trace_writer) {
+		uint64_t dropped_trace_events = 0;
+
+		for (const auto& thread_statistics : statistics) {
+			dropped_trace_events += thread_statistics->dropped_trace_events;
+		}
+
+		trace_writer->stop(dropped_trace_events);
+
+		std::cout << "INFO: Traced "
+				  << trace_writer->getRecordCount()
+				  << " gaps of at least "
+				  << clp.getThresholdNanoseconds()
+				  << " ns to '"
+				  << clp.getTracePath()
+				  << "', dropped "
+				  << dropped_trace_events
+				  << ".\n";
+	}
+
+	std::unique_ptr<Histogram> aggregate = std::make_unique<Histogram>();
+
+	for (const auto& thread_statistics : statistics) {
+		aggregate->add(thread_statistics->histogram);
+
+		std::cout << "INFO: Effective thread priority is "
+				  << clp.getEffectiveThreadPriorityName(thread_statistics->effective_priority_class,
+														thread_statistics->effective_thread_priority);
+
+		if (thread_statistics->requested_cpu != com::github::coderodde::wtpdmt::UNPINNED_CPU) {
+			std::cout << " on CPU " << thread_statistics->requested_cpu;
+		}
+
+		std::cout << ".\n";
+	}
+
+	std::cout << "\n";
+
+	if (statistics.size() > 1 || 
+		statistics[0]->requested_cpu != com::github::coderodde::wtpdmt::UNPINNED_CPU) {
+		com::github::coderodde::wtpdmt::printThreadTable(statistics, 
+														 *aggregate,
+														 clock,
+														 percentiles);
+	}
+
+	com::github::coderodde::wtpdmt::printGapStatistics(*aggregate, clock, percentiles);
+	com::github::coderodde::wtpdmt::printLoopCalibration(statistics, *aggregate, clock, percentiles);
+
+	if (clp.attributionRequested()) {
+		std::cout << "INFO: Gaps of at least "
+				  << clp.getAttributionThresholdNanoseconds()
+				  << " ns by cause:";
+
+		com::github::coderodde::wtpdmt::printGapAttribution(statistics, clock);
+	}
+
+	if (power_counter_source != PowerCounterSource::NONE) {
+		PowerStateStatistics power_states{};
+
+		for (const auto& thread_statistics : statistics) {
+			com::github::coderodde::wtpdmt::addPowerStateStatistics(power_states, thread_statistics->power_states);
+		}
+
+		std::cout << "INFO: Gaps of at least "
+				  << clp.getPowerThresholdNanoseconds()
+				  << " ns by power state (share of their time):";
+
+		com::github::coderodde::wtpdmt::printPowerStates("Threads", { "All" }, { power_states }, clock);
+	}
+
+	std::cout << "INFO: Maximum sleep duration: "
+			  << clock.ticksToNanoseconds(aggregate->getMaximum())
+			  << " ns\n";
+
+	if (clp.saveRequested()) {
+		com::github::coderodde::wtpdmt::saveBaseline(clp.getSavePath(), *aggregate, clock, statistics.size());
+		std::cout << "INFO: Saved the gap distribution to '" << clp.getSavePath() << "'.\n";
+	}
+
+	bool regressed = baseline && com::github::coderodde::wtpdmt::compareWithBaseline(*baseline,
+																				   *aggregate,
+																				   clock,
+																				   percentiles);
+
+	PrintRunStatistics(page_faults_before, page_faults_after);
+	return regressed ? com::github::coderodde::wtpdmt::BASELINE_REGRESSION_EXIT_CODE : EXIT_SUCCESS;
 } catch (std::logic_error& err) {
 	std::cerr << "ERROR: " << err.what() << "\n";
 	return EXIT_FAILURE;
+} catch (std::runtime_error& err) {
+	std::cerr << "ERROR: " << err.what() << "\n";
+	return EXIT_FAILURE;
 }
\ No newline at end of file
@@ -0,0 +1,563 @@
+// Analyzes a gap trace (wt --trace <FILE>) offline: the gap distribution
+// per thread, a time series of fixed windows and bursts of gaps that
+// follow each other closely. The file is memory-mapped and split into one
+// chunk per worker thread. The workers share the time series; the rest
+// of their results merge at the end.
+
+#include "../Histogram.h"
+#include "../LatencyTable.h"
+#include "../MappedFileView.h"
+#include "../TraceFormat.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::TraceFileHeader;
+using com::github::coderodde::wtpdmt::TraceRecord;
+using com::github::coderodde::wtpdmt::printHistogramTable;
+using com::github::coderodde::wtpdmt::util::Histogram;
+using com::github::coderodde::wtpdmt::util::MappedFileView;
+
+static const string FLAG_THREADS = "--threads";
+static const string FLAG_WINDOW  = "--window";
+static const string FLAG_SERIES  = "--series";
+static const string FLAG_BURST   = "--burst";
+
+static const std::vector<double> PERCENTILES = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+
+static const uint64_t NANOSECONDS_PER_MILLISECOND = 1000 * 1000;
+static const uint64_t DEFAULT_WINDOW_MILLISECONDS = 1000;
+static const uint64_t DEFAULT_BURST_NANOSECONDS   = 1000 * 1000;
+
+// Fewer gaps than this in a row are not a burst:
+static const uint64_t MINIMUM_BURST_GAPS = 3;
+static const size_t   PRINTED_BURST_COUNT = 10;
+
+// A time series longer than this is a corrupt trace or wants a longer
+// window:
+static const uint64_t MAXIMUM_WINDOW_COUNT = 16 * 1024 * 1024;
+
+// A run of records of one thread goes to Histogram::recordAll() in one
+// piece, unless it is longer than this many gaps:
+static const size_t RUN_BUFFER_GAPS = 64 * 1024;
+
+// Small traces are not worth a thread per CPU:
+static const size_t MINIMUM_RECORDS_PER_WORKER = 4096;
+
+static const int COLUMN_WIDTH = 11;
+
+struct WindowStatistics {
+	uint64_t gaps;
+	uint64_t lost_nanoseconds;
+	uint64_t largest_gap_nanoseconds;
+};
+
+// Gaps of one thread, each starting at most the burst distance after the
+// previous one ended.
+struct Burst {
+	uint32_t thread_index;
+	int32_t  cpu;
+	uint64_t start_nanoseconds; // Unix epoch time.
+	uint64_t end_nanoseconds;
+	uint64_t gaps;
+	uint64_t lost_nanoseconds;
+	uint64_t largest_gap_nanoseconds;
+};
+
+struct AnalysisParameters {
+	const char*       records;
+	size_t            record_size;
+	uint32_t          thread_count;
+	uint64_t          start_time_nanoseconds;
+	uint64_t          window_nanoseconds;
+	uint64_t          burst_nanoseconds;
+	WindowStatistics* windows; // Shared by the workers; see AnalyzeChunk().
+	size_t            window_count;
+};
+
+// What one worker found in its chunk. Its runs of gaps per thread keep
+// the first and the last run whatever their length, since those may
+// continue in the neighbouring chunks.
+struct ChunkResult {
+	std::vector<std::unique_ptr<Histogram>> histograms; // By thread.
+	std::vector<int32_t>                    cpus;       // By thread; -2 if no record.
+	std::vector<std::vector<Burst>>         runs;       // By thread.
+};
+
+static void PrintUsage() {
+	std::cout << "wtanalyze <FILE> [" << FLAG_THREADS << " <THREADS>] [" << FLAG_WINDOW << " <MILLISECONDS>] ["
+			  << FLAG_SERIES << " <CSV>] [" << FLAG_BURST << " <NANOSECONDS>]\n"
+			  << "where:\n\n"
+			  << "  <FILE> is a trace written by wt --trace.\n"
+			  << "  <THREADS> is the number of worker threads (default: one per CPU).\n"
+			  << "  <MILLISECONDS> is the length of a time series window (default: "
+			  << DEFAULT_WINDOW_MILLISECONDS << ").\n"
+			  << "  <CSV> receives the time series, one line per window.\n"
+			  << "  <NANOSECONDS> is the largest distance between the gaps of a burst (default: "
+			  << DEFAULT_BURST_NANOSECONDS << ");\n"
+			  << "  a burst has at least " << MINIMUM_BURST_GAPS << " gaps.\n";
+}
+
+static uint64_t ParseUnsignedArgument(const string& flag, const string& value) {
+	if (value.empty() || value.find_first_not_of("0123456789") != string::npos) {
+		std::stringstream ss;
+		ss << "Could not parse '" << value << "' as a non-negative integer for the flag " << flag << ".";
+		throw std::logic_error{ ss.str() };
+	}
+
+	return std::stoull(value);
+}
+
+static const TraceFileHeader& CheckLayout(const MappedFileView& file) {
+	if (file.getSize() < sizeof(TraceFileHeader)) {
+		throw std::runtime_error{ "The file is too small to hold a trace header." };
+	}
+
+	const TraceFileHeader& header = *reinterpret_cast<const TraceFileHeader*>(file.getData());
+
+	if (std::memcmp(header.magic, com::github::coderodde::wtpdmt::TRACE_FILE_MAGIC, sizeof(header.magic)) != 0) {
+		throw std::runtime_error{ "The file is not a gap trace." };
+	}
+
+	if (header.version != com::github::coderodde::wtpdmt::TRACE_FILE_VERSION) {
+		std::stringstream ss;
+		ss << "Unsupported trace version " << header.version << ".";
+		throw std::runtime_error{ ss.str() };
+	}
+
+	if (header.header_size < sizeof(TraceFileHeader) ||
+		header.record_size < sizeof(TraceRecord) ||
+		file.getSize() < header.header_size + header.record_count * header.record_size) {
+		throw std::runtime_error{ "The file is smaller than its header says." };
+	}
+
+	return header;
+}
+
+// Appends 'run' to 'runs', merging it into the last run if it starts
+// close enough after that one ends.
+static void AppendRun(std::vector<Burst>& runs, const Burst& run, uint64_t burst_nanoseconds) {
+	if (!runs.empty() && run.start_nanoseconds <= runs.back().end_nanoseconds + burst_nanoseconds) {
+		Burst& last = runs.back();
+		last.end_nanoseconds         = (std::max)(last.end_nanoseconds, run.end_nanoseconds);
+		last.gaps                   += run.gaps;
+		last.lost_nanoseconds       += run.lost_nanoseconds;
+		last.largest_gap_nanoseconds = (std::max)(last.largest_gap_nanoseconds, run.largest_gap_nanoseconds);
+		return;
+	}
+
+	runs.push_back(run);
+}
+
+static uint64_t GetWindowIndex(const AnalysisParameters& parameters, uint64_t timestamp_nanoseconds) {
+	return timestamp_nanoseconds > parameters.start_time_nanoseconds
+		 ? (timestamp_nanoseconds - parameters.start_time_nanoseconds) / parameters.window_nanoseconds
+		 : 0;
+}
+
+// The latest timestamp of a chunk and the record that holds it.
+struct ChunkEnd {
+	uint64_t timestamp_nanoseconds;
+	size_t   record_index;
+};
+
+static ChunkEnd FindChunkEnd(const AnalysisParameters& parameters, size_t first_record, size_t record_count) {
+	ChunkEnd end{ parameters.start_time_nanoseconds, first_record };
+
+	for (size_t i = 0; i < record_count; i++) {
+		uint64_t timestamp_nanoseconds;
+		std::memcpy(&timestamp_nanoseconds,
+					parameters.records + (first_record + i) * parameters.record_size
+					+ offsetof(TraceRecord, timestamp_nanoseconds),
+					sizeof(timestamp_nanoseconds));
+
+		if (timestamp_nanoseconds > end.timestamp_nanoseconds) {
+			end = ChunkEnd{ timestamp_nanoseconds, first_record + i };
+		}
+	}
+
+	return end;
+}
+
+// Runs 'task' on 'worker_count' threads, each with its share of the
+// records, and rethrows the first error.
+template<typename Task>
+static void RunWorkers(size_t worker_count, size_t record_count, Task task) {
+	std::vector<std::thread> workers;
+	std::vector<std::exception_ptr> errors(worker_count);
+
+	for (size_t i = 0; i < worker_count; i++) {
+		size_t first_record = record_count * i / worker_count;
+		size_t end_record = record_count * (i + 1) / worker_count;
+
+		workers.emplace_back([&, i, first_record, end_record]() {
+			try {
+				task(i, first_record, end_record - first_record);
+			} catch (...) {
+				errors[i] = std::current_exception();
+			}
+		});
+	}
+
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	for (const std::exception_ptr& error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+}
+
+static void AnalyzeChunk(const AnalysisParameters& parameters,
+						 size_t first_record,
+						 size_t record_count,
+						 ChunkResult& result) {
+	for (uint32_t i = 0; i < parameters.thread_count; i++) {
+		result.histograms.push_back(std::make_unique<Histogram>());
+	}
+
+	result.cpus.assign(parameters.thread_count, -2);
+	result.runs.resize(parameters.thread_count);
+
+	std::vector<Burst> open_runs(parameters.thread_count, Burst{ 0, 0, 0, 0, 0, 0, 0 });
+
+	// A measuring thread's records come in batches, so the gaps of one
+	// thread mostly follow each other:
+	std::vector<uint64_t> run_gaps;
+	uint32_t run_thread_index = 0;
+	run_gaps.reserve((std::min)(record_count, RUN_BUFFER_GAPS));
+
+	for (size_t i = 0; i < record_count; i++) {
+		TraceRecord record;
+		std::memcpy(&record, parameters.records + (first_record + i) * parameters.record_size, sizeof(record));
+
+		if (record.thread_index >= parameters.thread_count) {
+			std::stringstream ss;
+			ss << "Record " << first_record + i << " names thread " << record.thread_index
+			   << " of " << parameters.thread_count << ".";
+			throw std::runtime_error{ ss.str() };
+		}
+
+		if (!run_gaps.empty() && (record.thread_index != run_thread_index || run_gaps.size() == RUN_BUFFER_GAPS)) {
+			result.histograms[run_thread_index]->recordAll(run_gaps.data(), run_gaps.size());
+			run_gaps.clear();
+		}
+
+		run_gaps.push_back(record.gap_nanoseconds);
+		run_thread_index = record.thread_index;
+		result.cpus[record.thread_index] = record.cpu;
+
+		// The time series. The chunks hold mostly different stretches of
+		// time, so the workers rarely touch the same window:
+		uint64_t window_index = GetWindowIndex(parameters, record.timestamp_nanoseconds);
+
+		if (window_index >= parameters.window_count) {
+			std::stringstream ss;
+			ss << "Record " << first_record + i << " lies beyond the span of the trace.";
+			throw std::runtime_error{ ss.str() };
+		}
+
+		WindowStatistics& window = parameters.windows[static_cast<size_t>(window_index)];
+		std::atomic_ref<uint64_t>{ window.gaps }.fetch_add(1, std::memory_order_relaxed);
+		std::atomic_ref<uint64_t>{ window.lost_nanoseconds }.fetch_add(record.gap_nanoseconds, std::memory_order_relaxed);
+		std::atomic_ref<uint64_t> largest_gap{ window.largest_gap_nanoseconds };
+		uint64_t largest = largest_gap.load(std::memory_order_relaxed);
+
+		while (record.gap_nanoseconds > largest &&
+			   !largest_gap.compare_exchange_weak(largest, record.gap_nanoseconds, std::memory_order_relaxed)) {
+		}
+
+		// The runs of gaps:
+		Burst& open_run = open_runs[record.thread_index];
+		uint64_t gap_start_nanoseconds = record.timestamp_nanoseconds - record.gap_nanoseconds;
+
+		if (open_run.gaps > 0 && gap_start_nanoseconds <= open_run.end_nanoseconds + parameters.burst_nanoseconds) {
+			open_run.end_nanoseconds         = (std::max)(open_run.end_nanoseconds, record.timestamp_nanoseconds);
+			open_run.gaps++;
+			open_run.lost_nanoseconds       += record.gap_nanoseconds;
+			open_run.largest_gap_nanoseconds = (std::max)(open_run.largest_gap_nanoseconds, record.gap_nanoseconds);
+		} else {
+			std::vector<Burst>& runs = result.runs[record.thread_index];
+
+			if (open_run.gaps > 0 && (runs.empty() || open_run.gaps >= MINIMUM_BURST_GAPS)) {
+				runs.push_back(open_run);
+			}
+
+			open_run = Burst{ record.thread_index,
+							  record.cpu,
+							  gap_start_nanoseconds,
+							  record.timestamp_nanoseconds,
+							  1,
+							  record.gap_nanoseconds,
+							  record.gap_nanoseconds };
+		}
+	}
+
+	if (!run_gaps.empty()) {
+		result.histograms[run_thread_index]->recordAll(run_gaps.data(), run_gaps.size());
+	}
+
+	for (uint32_t i = 0; i < parameters.thread_count; i++) {
+		if (open_runs[i].gaps > 0) {
+			result.runs[i].push_back(open_runs[i]);
+		}
+	}
+}
+
+static void WriteSeries(const string& path, const std::vector<WindowStatistics>& windows, uint64_t window_nanoseconds) {
+	std::ofstream file(path);
+	file << "window_start_seconds,gaps,lost_nanoseconds,largest_gap_nanoseconds\n";
+
+	for (size_t i = 0; i < windows.size(); i++) {
+		file << static_cast<double>(i * window_nanoseconds) / 1e9 << ","
+			 << windows[i].gaps << ","
+			 << windows[i].lost_nanoseconds << ","
+			 << windows[i].largest_gap_nanoseconds << "\n";
+	}
+
+	if (!file.flush()) {
+		std::stringstream ss;
+		ss << "Could not write the time series to '" << path << "'.";
+		throw std::runtime_error{ ss.str() };
+	}
+}
+
+int main(int argc, char* argv[]) try {
+	string path;
+	string series_path;
+	size_t worker_count = (std::max)(1u, std::thread::hardware_concurrency());
+	uint64_t window_nanoseconds = DEFAULT_WINDOW_MILLISECONDS * NANOSECONDS_PER_MILLISECOND;
+	uint64_t burst_nanoseconds = DEFAULT_BURST_NANOSECONDS;
+
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+
+		if (i + 1 < argc && argument == FLAG_THREADS) {
+			worker_count = static_cast<size_t>(ParseUnsignedArgument(FLAG_THREADS, argv[++i]));
+		} else if (i + 1 < argc && argument == FLAG_WINDOW) {
+			uint64_t window_milliseconds = ParseUnsignedArgument(FLAG_WINDOW, argv[++i]);
+
+			if (window_milliseconds > UINT64_MAX / NANOSECONDS_PER_MILLISECOND) {
+				std::stringstream ss;
+				ss << "The window of " << window_milliseconds << " ms is too long.";
+				throw std::logic_error{ ss.str() };
+			}
+
+			window_nanoseconds = window_milliseconds * NANOSECONDS_PER_MILLISECOND;
+		} else if (i + 1 < argc && argument == FLAG_SERIES) {
+			series_path = argv[++i];
+		} else if (i + 1 < argc && argument == FLAG_BURST) {
+			burst_nanoseconds = ParseUnsignedArgument(FLAG_BURST, argv[++i]);
+		} else if (path.empty() && !argument.empty() && argument[0] != '-') {
+			path = argument;
+		} else {
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (path.empty() || worker_count == 0 || window_nanoseconds == 0) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	auto analysis_start = std::chrono::steady_clock::now();
+
+	MappedFileView file(path);
+	const TraceFileHeader& header = CheckLayout(file);
+	size_t record_count = static_cast<size_t>(header.record_count);
+
+	AnalysisParameters parameters{ file.getData() + header.header_size,
+								   header.record_size,
+								   header.thread_count,
+								   header.start_time_nanoseconds,
+								   window_nanoseconds,
+								   burst_nanoseconds,
+								   nullptr,
+								   0 };
+
+	worker_count = (std::max)(size_t(1), (std::min)(worker_count, record_count / MINIMUM_RECORDS_PER_WORKER));
+
+	// The span of the trace sizes the time series once for all workers:
+	std::vector<ChunkEnd> chunk_ends(worker_count);
+
+	RunWorkers(worker_count, record_count, [&](size_t worker_index, size_t first_record, size_t chunk_record_count) {
+		chunk_ends[worker_index] = FindChunkEnd(parameters, first_record, chunk_record_count);
+	});
+
+	ChunkEnd trace_end = chunk_ends[0];
+
+	for (const ChunkEnd& chunk_end : chunk_ends) {
+		trace_end = chunk_end.timestamp_nanoseconds > trace_end.timestamp_nanoseconds ? chunk_end : trace_end;
+	}
+
+	uint64_t window_count = GetWindowIndex(parameters, trace_end.timestamp_nanoseconds) + 1;
+
+	if (window_count > MAXIMUM_WINDOW_COUNT) {
+		std::stringstream ss;
+		ss << "Record " << trace_end.record_index << " ends "
+		   << static_cast<double>(trace_end.timestamp_nanoseconds - header.start_time_nanoseconds) / 1e9
+		   << " s after the start of the trace, more than " << MAXIMUM_WINDOW_COUNT << " windows of "
+		   << window_nanoseconds / NANOSECONDS_PER_MILLISECOND << " ms; the trace is corrupt or needs a longer "
+		   << FLAG_WINDOW << ".";
+		throw std::runtime_error{ ss.str() };
+	}
+
+	std::vector<WindowStatistics> windows(static_cast<size_t>(window_count), WindowStatistics{ 0, 0, 0 });
+	parameters.windows      = windows.data();
+	parameters.window_count = windows.size();
+
+	std::vector<ChunkResult> results(worker_count);
+
+	RunWorkers(worker_count, record_count, [&](size_t worker_index, size_t first_record, size_t chunk_record_count) {
+		AnalyzeChunk(parameters, first_record, chunk_record_count, results[worker_index]);
+	});
+
+	// Merge in chunk order, so that runs can join across chunk borders:
+	ChunkResult& total = results[0];
+
+	for (size_t i = 1; i < results.size(); i++) {
+		const ChunkResult& result = results[i];
+
+		for (uint32_t t = 0; t < header.thread_count; t++) {
+			total.histograms[t]->add(*result.histograms[t]);
+			total.cpus[t] = result.cpus[t] != -2 ? result.cpus[t] : total.cpus[t];
+
+			for (const Burst& run : result.runs[t]) {
+				AppendRun(total.runs[t], run, burst_nanoseconds);
+			}
+		}
+	}
+
+	std::vector<Burst> bursts;
+
+	for (const std::vector<Burst>& runs : total.runs) {
+		for (const Burst& run : runs) {
+			if (run.gaps >= MINIMUM_BURST_GAPS) {
+				bursts.push_back(run);
+			}
+		}
+	}
+
+	double analysis_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - analysis_start).count();
+
+	std::cout << "Records:             " << record_count << " gaps of at least " << header.threshold_nanoseconds
+			  << " ns, " << header.dropped_record_count << " dropped\n"
+			  << "Threads:             " << header.thread_count << "\n"
+			  << "Span:                " << std::fixed << std::setprecision(1)
+			  << static_cast<double>(trace_end.timestamp_nanoseconds - header.start_time_nanoseconds) / 1e9 << " s\n\n"
+			  << std::defaultfloat;
+
+	std::vector<string> labels;
+	std::vector<const Histogram*> histograms;
+	Histogram aggregate;
+
+	for (uint32_t t = 0; t < header.thread_count; t++) {
+		aggregate.add(*total.histograms[t]);
+		labels.push_back(std::to_string(t) + "/" + (total.cpus[t] < 0 ? string("-") : std::to_string(total.cpus[t])));
+		histograms.push_back(total.histograms[t].get());
+	}
+
+	if (header.thread_count > 1) {
+		labels.push_back("all");
+		histograms.push_back(&aggregate);
+	}
+
+	// The trace holds nanoseconds:
+	printHistogramTable("Thread/CPU", labels, histograms, 1.0, PERCENTILES);
+
+	size_t windows_with_gaps = 0;
+	size_t worst_window = 0;
+
+	for (size_t w = 0; w < windows.size(); w++) {
+		windows_with_gaps += windows[w].gaps > 0 ? 1 : 0;
+		worst_window = windows[w].lost_nanoseconds > windows[worst_window].lost_nanoseconds ? w : worst_window;
+	}
+
+	std::cout << "\n" << windows.size() << " windows of " << window_nanoseconds / NANOSECONDS_PER_MILLISECOND
+			  << " ms, " << windows_with_gaps << " with gaps.";
+
+	if (windows_with_gaps > 0) {
+		const WindowStatistics& window = windows[worst_window];
+		std::cout << " The worst starts at " << std::fixed << std::setprecision(3)
+				  << static_cast<double>(worst_window * window_nanoseconds) / 1e9 << std::defaultfloat
+				  << " s: " << window.gaps << " gaps, " << window.lost_nanoseconds << " ns lost, the largest "
+				  << window.largest_gap_nanoseconds << " ns.";
+	}
+
+	std::cout << "\n";
+
+	if (!series_path.empty()) {
+		WriteSeries(series_path, windows, window_nanoseconds);
+	}
+
+	std::sort(bursts.begin(), bursts.end(), [](const Burst& a, const Burst& b) {
+		return a.lost_nanoseconds > b.lost_nanoseconds;
+	});
+
+	std::cout << "\n" << bursts.size() << " bursts of at least " << MINIMUM_BURST_GAPS << " gaps at most "
+			  << burst_nanoseconds << " ns apart";
+
+	if (!bursts.empty()) {
+		std::cout << "; the largest:\n"
+				  << std::left
+				  << std::setw(7) << "Thread"
+				  << std::setw(5) << "CPU"
+				  << std::right
+				  << std::setw(COLUMN_WIDTH + 2) << "Start (s)"
+				  << std::setw(COLUMN_WIDTH + 2) << "Length (ns)"
+				  << std::setw(COLUMN_WIDTH) << "Gaps"
+				  << std::setw(COLUMN_WIDTH + 2) << "Lost (ns)"
+				  << std::setw(COLUMN_WIDTH + 2) << "Largest (ns)"
+				  << "\n";
+
+		for (size_t i = 0; i < bursts.size() && i < PRINTED_BURST_COUNT; i++) {
+			const Burst& burst = bursts[i];
+			uint64_t start_offset = burst.start_nanoseconds > header.start_time_nanoseconds
+								  ? burst.start_nanoseconds - header.start_time_nanoseconds
+								  : 0;
+
+			std::cout << std::left
+					  << std::setw(7) << burst.thread_index
+					  << std::setw(5) << (burst.cpu < 0 ? string("-") : std::to_string(burst.cpu))
+					  << std::right << std::fixed << std::setprecision(3)
+					  << std::setw(COLUMN_WIDTH + 2) << static_cast<double>(start_offset) / 1e9
+					  << std::defaultfloat
+					  << std::setw(COLUMN_WIDTH + 2) << burst.end_nanoseconds - burst.start_nanoseconds
+					  << std::setw(COLUMN_WIDTH) << burst.gaps
+					  << std::setw(COLUMN_WIDTH + 2) << burst.lost_nanoseconds
+					  << std::setw(COLUMN_WIDTH + 2) << burst.largest_gap_nanoseconds
+					  << "\n";
+		}
+	} else {
+		std::cout << ".\n";
+	}
+
+	std::cout << "\nINFO: Analyzed " << file.getSize() / (1024 * 1024) << " MiB in " << std::fixed
+			  << std::setprecision(3) << analysis_seconds << " s ("
+			  << std::setprecision(0) << static_cast<double>(file.getSize()) / (1024 * 1024) / analysis_seconds
+			  << " MiB/s) on " << worker_count << " threads.\n" << std::defaultfloat;
+
+	return EXIT_SUCCESS;
+} catch (std::logic_error& err) {
+	std::cerr << "ERROR: " << err.what() << "\n";
+	return EXIT_FAILURE;
+} catch (std::runtime_error& err) {
+	std::cerr << "ERROR: " << err.what() << "\n";
+	return EXIT_FAILURE;
+}
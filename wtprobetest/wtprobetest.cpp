@@ -0,0 +1,88 @@
+// Checks the promise of JitterProbe not to allocate after start(): runs a
+// probe with a callback, snapshots it, stops it, and fails if any form of
+// operator new was called in between. AllocationCounter.cpp counts the
+// calls for this program alone, so wt itself runs on the plain allocator.
+
+#include "../AllocationCounter.h"
+#include "../JitterProbe.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using com::github::coderodde::wtpdmt::getAllocationCount;
+using com::github::coderodde::wtpdmt::JitterProbe;
+using com::github::coderodde::wtpdmt::JitterProbeEvent;
+using com::github::coderodde::wtpdmt::JitterProbeOptions;
+using com::github::coderodde::wtpdmt::JitterSnapshot;
+using com::github::coderodde::wtpdmt::UNPINNED_PROBE_CPU;
+using com::github::coderodde::wtpdmt::util::Clock;
+
+static const std::chrono::milliseconds SNAPSHOT_INTERVAL{ 100 };
+static const size_t SNAPSHOT_COUNT = 10;
+
+// Low enough for the callback to run now and then on any machine.
+static const uint64_t THRESHOLD_NANOSECONDS = 1000;
+
+static std::atomic<uint64_t> callback_count{ 0 };
+
+static void OnThresholdExceeded(const JitterProbeEvent&) {
+	callback_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+int main() try {
+	JitterProbeOptions options;
+	options.clock_source          = Clock::getDefaultSource();
+	options.cpu                   = UNPINNED_PROBE_CPU;
+	options.priority_class        = com::github::coderodde::wtpdmt::util::getProcessPriorityClass();
+	options.thread_priority       = 0;
+	options.threshold_nanoseconds = THRESHOLD_NANOSECONDS;
+	options.on_threshold_exceeded = OnThresholdExceeded;
+
+	JitterProbe probe(options);
+	std::vector<JitterSnapshot> snapshots;
+	snapshots.reserve(SNAPSHOT_COUNT + 1);
+
+	uint64_t allocations_before_start = getAllocationCount();
+	probe.start();
+	uint64_t allocations_after_start = getAllocationCount();
+
+	for (size_t i = 0; i < SNAPSHOT_COUNT; i++) {
+		std::this_thread::sleep_for(SNAPSHOT_INTERVAL);
+		snapshots.push_back(probe.snapshot());
+	}
+
+	probe.stop();
+	snapshots.push_back(probe.snapshot());
+	uint64_t allocations_after_stop = getAllocationCount();
+
+	std::cout << "INFO: start() allocated "
+			  << allocations_after_start - allocations_before_start
+			  << " times.\n"
+			  << "INFO: " << snapshots.back().since_start.samples << " samples, "
+			  << callback_count.load() << " callbacks.\n";
+
+	if (snapshots.back().since_start.samples == 0) {
+		std::cerr << "ERROR: The probe took no samples.\n";
+		return EXIT_FAILURE;
+	}
+
+	if (allocations_after_stop != allocations_after_start) {
+		std::cerr << "ERROR: The probe allocated "
+				  << allocations_after_stop - allocations_after_start
+				  << " times between start() and the end of stop().\n";
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "INFO: No allocations between start() and the end of stop().\n";
+	return EXIT_SUCCESS;
+} catch (std::logic_error& err) {
+	std::cerr << "ERROR: " << err.what() << "\n";
+	return EXIT_FAILURE;
+} catch (std::runtime_error& err) {
+	std::cerr << "ERROR: " << err.what() << "\n";
+	return EXIT_FAILURE;
+}
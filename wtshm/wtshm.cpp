@@ -0,0 +1,231 @@
+// Dumps the statistics a daemon (wt --daemon <NAME>) publishes into shared
+// memory. Reading takes a consistent copy of the segment and never makes
+// the daemon do anything.
+
+#include "../Histogram.h"
+#include "../LatencyTable.h"
+#include "../SharedMemory.h"
+#include "../SharedStatisticsFormat.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::printHistogramTable;
+using com::github::coderodde::wtpdmt::SharedHistogram;
+using com::github::coderodde::wtpdmt::SharedStatisticsHeader;
+using com::github::coderodde::wtpdmt::SharedStatisticsState;
+using com::github::coderodde::wtpdmt::SharedThreadHeader;
+using com::github::coderodde::wtpdmt::util::Histogram;
+using com::github::coderodde::wtpdmt::util::SharedMemory;
+
+static const string FLAG_BUCKETS = "--buckets";
+
+static const std::vector<double> PERCENTILES = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+static const std::vector<string> WINDOW_NAMES = { "interval", "window", "total" };
+
+// An update takes far less than this; a reader that keeps colliding with
+// one is looking at a daemon that died in the middle of an update.
+static const size_t MAXIMUM_COPY_ATTEMPTS = 1000;
+static const std::chrono::microseconds COPY_RETRY_SLEEP{ 100 };
+
+static const int COLUMN_WIDTH = 11;
+
+static void PrintUsage() {
+	std::cout << "wtshm <NAME> [" << FLAG_BUCKETS << "]\n"
+			  << "where:\n\n"
+			  << "  <NAME> is the name given to wt --daemon.\n"
+			  << "  " << FLAG_BUCKETS << " also prints the non-empty buckets of each total histogram.\n";
+}
+
+// Copies the segment under the sequence lock (see SharedStatisticsFormat.h).
+static std::vector<char> TakeSnapshot(const SharedMemory& segment) {
+	std::vector<char> snapshot(segment.getSize());
+	uint64_t& sequence_word = const_cast<SharedStatisticsHeader*>(
+		reinterpret_cast<const SharedStatisticsHeader*>(segment.getData()))->sequence;
+	std::atomic_ref<uint64_t> sequence{ sequence_word };
+
+	for (size_t attempt = 0; attempt < MAXIMUM_COPY_ATTEMPTS; attempt++) {
+		uint64_t sequence_before = sequence.load(std::memory_order_acquire);
+
+		if (sequence_before % 2 == 0) {
+			std::memcpy(snapshot.data(), segment.getData(), snapshot.size());
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (sequence.load(std::memory_order_relaxed) == sequence_before) {
+				return snapshot;
+			}
+		}
+
+		std::this_thread::sleep_for(COPY_RETRY_SLEEP);
+	}
+
+	throw std::runtime_error{ "The segment stays in the middle of an update; the daemon may have died." };
+}
+
+static const SharedStatisticsHeader& CheckLayout(const std::vector<char>& snapshot) {
+	if (snapshot.size() < sizeof(SharedStatisticsHeader)) {
+		throw std::runtime_error{ "The segment is too small to hold a header." };
+	}
+
+	const SharedStatisticsHeader& header = *reinterpret_cast<const SharedStatisticsHeader*>(snapshot.data());
+
+	if (std::memcmp(header.magic, com::github::coderodde::wtpdmt::SHARED_STATISTICS_MAGIC, sizeof(header.magic)) != 0) {
+		throw std::runtime_error{ "The segment does not hold daemon statistics." };
+	}
+
+	if (header.version != com::github::coderodde::wtpdmt::SHARED_STATISTICS_VERSION) {
+		std::stringstream ss;
+		ss << "Unsupported segment version " << header.version << ".";
+		throw std::runtime_error{ ss.str() };
+	}
+
+	if (header.bucket_count != Histogram::BUCKET_COUNT || header.sub_bucket_bits != Histogram::SUB_BUCKET_BITS) {
+		throw std::runtime_error{ "The daemon uses a different histogram layout." };
+	}
+
+	if (header.header_size < sizeof(SharedStatisticsHeader) ||
+		header.histogram_size < sizeof(SharedHistogram) + Histogram::BUCKET_COUNT * sizeof(uint64_t) ||
+		header.thread_size < sizeof(SharedThreadHeader) + 3 * header.histogram_size ||
+		snapshot.size() < header.header_size + static_cast<size_t>(header.thread_count) * header.thread_size) {
+		throw std::runtime_error{ "The segment is smaller than its header says." };
+	}
+
+	return header;
+}
+
+static std::unique_ptr<Histogram> ImportHistogram(const char* source) {
+	SharedHistogram shared_histogram;
+	std::memcpy(&shared_histogram, source, sizeof(shared_histogram));
+
+	std::vector<uint64_t> counts(Histogram::BUCKET_COUNT);
+	std::memcpy(counts.data(), source + sizeof(shared_histogram), counts.size() * sizeof(uint64_t));
+
+	std::unique_ptr<Histogram> histogram = std::make_unique<Histogram>();
+	histogram->restore(counts.data(),
+					   shared_histogram.minimum,
+					   shared_histogram.maximum,
+					   shared_histogram.sum);
+	return histogram;
+}
+
+static uint64_t ToNanoseconds(uint64_t ticks, double nanoseconds_per_tick) {
+	return static_cast<uint64_t>(static_cast<double>(ticks) * nanoseconds_per_tick + 0.5);
+}
+
+static double GetAgeSeconds(uint64_t epoch_nanoseconds) {
+	uint64_t now = static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count());
+
+	return static_cast<double>(now - epoch_nanoseconds) / 1e9;
+}
+
+static void PrintHeader(const SharedStatisticsHeader& header) {
+	bool running = header.state == static_cast<uint32_t>(SharedStatisticsState::RUNNING);
+
+	std::cout << std::fixed << std::setprecision(1)
+			  << "Daemon process:      " << header.process_id << (running ? " (running)" : " (stopped)") << "\n"
+			  << "Started:             " << GetAgeSeconds(header.start_time_nanoseconds) << " s ago\n"
+			  << "Last update:         " << GetAgeSeconds(header.update_time_nanoseconds) << " s ago\n"
+			  << "Updates:             " << header.update_count << "\n"
+			  << "Interval:            " << header.interval_milliseconds << " ms\n"
+			  << "Window:              " << header.window_intervals << " intervals\n"
+			  << "Page faults:         " << header.minor_page_faults << " minor, "
+			  << header.major_page_faults << " major\n\n"
+			  << std::defaultfloat;
+}
+
+static void PrintBuckets(size_t thread_index, const Histogram& histogram, double nanoseconds_per_tick) {
+	std::cout << "\nThread " << thread_index << ", total, by bucket (ns):\n";
+
+	for (size_t i = 0; i < Histogram::BUCKET_COUNT; i++) {
+		if (histogram.getBucketCount(i) == 0) {
+			continue;
+		}
+
+		std::cout << std::setw(COLUMN_WIDTH + 2) << ToNanoseconds(Histogram::getBucketLowestValue(i), nanoseconds_per_tick)
+				  << " .. "
+				  << std::left
+				  << std::setw(COLUMN_WIDTH + 2) << ToNanoseconds(Histogram::getBucketHighestValue(i), nanoseconds_per_tick)
+				  << std::right
+				  << histogram.getBucketCount(i)
+				  << "\n";
+	}
+}
+
+int main(int argc, char* argv[]) try {
+	string name;
+	bool print_buckets = false;
+
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+
+		if (argument == FLAG_BUCKETS) {
+			print_buckets = true;
+		} else if (name.empty() && !argument.empty() && argument[0] != '-') {
+			name = argument;
+		} else {
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (name.empty()) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	SharedMemory segment(name);
+	std::vector<char> snapshot = TakeSnapshot(segment);
+	const SharedStatisticsHeader& header = CheckLayout(snapshot);
+
+	PrintHeader(header);
+
+	std::vector<string> labels;
+	std::vector<std::unique_ptr<Histogram>> histograms;
+	std::vector<const Histogram*> rows;
+	std::vector<const Histogram*> totals;
+
+	for (size_t thread_index = 0; thread_index < header.thread_count; thread_index++) {
+		const char* thread_data = snapshot.data() + header.header_size + thread_index * header.thread_size;
+		SharedThreadHeader thread_header;
+		std::memcpy(&thread_header, thread_data, sizeof(thread_header));
+
+		for (size_t window_index = 0; window_index < WINDOW_NAMES.size(); window_index++) {
+			histograms.push_back(
+				ImportHistogram(thread_data + sizeof(SharedThreadHeader) + window_index * header.histogram_size));
+			rows.push_back(histograms.back().get());
+			labels.push_back(std::to_string(thread_index) + "/"
+							 + (thread_header.cpu < 0 ? string("-") : std::to_string(thread_header.cpu)) + "/"
+							 + WINDOW_NAMES[window_index]);
+		}
+
+		totals.push_back(histograms.back().get());
+	}
+
+	printHistogramTable("Thread/CPU/Window", labels, rows, header.nanoseconds_per_tick, PERCENTILES);
+
+	if (print_buckets) {
+		for (size_t thread_index = 0; thread_index < totals.size(); thread_index++) {
+			PrintBuckets(thread_index, *totals[thread_index], header.nanoseconds_per_tick);
+		}
+	}
+
+	return EXIT_SUCCESS;
+} catch (std::logic_error& err) {
+	std::cerr << "ERROR: " << err.what() << "\n";
+	return EXIT_FAILURE;
+} catch (std::runtime_error& err) {
+	std::cerr << "ERROR: " << err.what() << "\n";
+	return EXIT_FAILURE;
+}
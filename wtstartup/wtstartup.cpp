@@ -0,0 +1,235 @@
+// Measures how long wt takes from entering main() to the first clock
+// sample of its gaps mode, and how many heap allocations happen on the
+// way: those of the static initializers, of parsing the command line, of
+// setUpRun(), which main() calls too, and of starting the measuring
+// threads up to their first sample. The steps run again and again in one
+// process, so the first repetition shows the cold start and the others
+// the warm one. What setUpRun() prints is formatted but discarded.
+
+#include "../AllocationCounter.h"
+#include "../Clock.h"
+#include "../CommandLineParser.h"
+#include "../Measurement.h"
+#include "../RunSetup.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using std::string;
+using com::github::coderodde::wtpdmt::getAllocationCount;
+using com::github::coderodde::wtpdmt::RunSetup;
+using com::github::coderodde::wtpdmt::ThreadStatistics;
+using com::github::coderodde::wtpdmt::util::Clock;
+using com::github::coderodde::wtpdmt::util::CommandLineParser;
+
+static const string FLAG_REPETITIONS = "--repetitions";
+static const string FLAG_SEPARATOR   = "--";
+
+static const size_t DEFAULT_REPETITIONS = 1000;
+
+static const int LABEL_WIDTH  = 22;
+static const int COLUMN_WIDTH = 12;
+
+struct StartupSample {
+	uint64_t parse_nanoseconds;
+	uint64_t setup_nanoseconds;
+	uint64_t threads_nanoseconds;      // From the end of the setup to the first sample.
+	uint64_t first_sample_nanoseconds; // From the start of parsing.
+	uint64_t parse_allocations;
+	uint64_t setup_allocations;
+	uint64_t threads_allocations;
+};
+
+// Takes the output of setUpRun() after it has been formatted.
+class DiscardingBuffer : public std::streambuf {
+protected:
+
+	int overflow(int character) override {
+		return traits_type::not_eof(character);
+	}
+
+	std::streamsize xsputn(const char*, std::streamsize count) override {
+		return count;
+	}
+};
+
+static void PrintUsage() {
+	std::cout << "wtstartup [" << FLAG_REPETITIONS << " <REPETITIONS>] [" << FLAG_SEPARATOR << " <FLAGS>...]\n"
+			  << "where:\n\n"
+			  << "  <REPETITIONS> is how often the startup runs (default: " << DEFAULT_REPETITIONS << ").\n"
+			  << "  <FLAGS> are the flags of wt to start with (default: none).\n";
+}
+
+static uint64_t ParseUnsignedArgument(const string& flag, const string& value) {
+	uint64_t result = 0;
+	auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+
+	if (value.empty() || error != std::errc{} || end != value.data() + value.size()) {
+		throw std::logic_error{ "Could not parse '" + value + "' as a non-negative integer for the flag " + flag + "." };
+	}
+
+	return result;
+}
+
+static uint64_t NanosecondsSince(std::chrono::steady_clock::time_point start) {
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - start).count());
+}
+
+// The steps of main() up to the first sample of the gaps mode. Every
+// measuring thread calibrates the loop and reads the clock once, as
+// runMeasurement() does before its loop; the earliest thread counts.
+static StartupSample RunStartup(std::vector<char*>& arguments) {
+	StartupSample sample;
+	uint64_t allocations_before = getAllocationCount();
+	auto start = std::chrono::steady_clock::now();
+
+	CommandLineParser clp(static_cast<int>(arguments.size()), arguments.data());
+
+	sample.parse_nanoseconds = NanosecondsSince(start);
+	sample.parse_allocations = getAllocationCount() - allocations_before;
+
+	auto setup_start = std::chrono::steady_clock::now();
+	allocations_before = getAllocationCount();
+
+	RunSetup setup = com::github::coderodde::wtpdmt::setUpRun(clp);
+
+	sample.setup_nanoseconds = NanosecondsSince(setup_start);
+	sample.setup_allocations = getAllocationCount() - allocations_before;
+
+	auto threads_start = std::chrono::steady_clock::now();
+	allocations_before = getAllocationCount();
+
+	size_t thread_count = clp.getMeasurementCpus().size();
+	std::vector<std::chrono::steady_clock::time_point> first_sample_times(thread_count);
+	std::vector<uint64_t> first_sample_allocations(thread_count);
+
+	com::github::coderodde::wtpdmt::runOnThreads(
+		clp.getMeasurementCpus(),
+		clp.getThreadPriority(),
+		[&](size_t thread_index, ThreadStatistics& thread_statistics) {
+			Clock::dispatch(setup.clock.getSource(), [&](auto reader) {
+				using Reader = decltype(reader);
+
+				thread_statistics.loop_calibration = com::github::coderodde::wtpdmt::calibrateGapLoop<Reader>();
+				volatile uint64_t first_sample = Reader::read();
+				(void) first_sample;
+			});
+
+			first_sample_times[thread_index] = std::chrono::steady_clock::now();
+			first_sample_allocations[thread_index] = getAllocationCount();
+		});
+
+	auto first_sample_time = *std::min_element(first_sample_times.begin(), first_sample_times.end());
+
+	sample.threads_nanoseconds      = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		first_sample_time - threads_start).count());
+	sample.first_sample_nanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		first_sample_time - start).count());
+	sample.threads_allocations      = *std::min_element(first_sample_allocations.begin(),
+														first_sample_allocations.end()) - allocations_before;
+	return sample;
+}
+
+static void PrintRow(const string& label,
+					 const std::vector<StartupSample>& samples,
+					 uint64_t StartupSample::* field) {
+	std::vector<uint64_t> values;
+
+	for (size_t i = 1; i < samples.size(); i++) {
+		values.push_back(samples[i].*field);
+	}
+
+	std::cout << std::setw(LABEL_WIDTH) << std::left << label
+			  << std::right
+			  << std::setw(COLUMN_WIDTH) << samples[0].*field;
+
+	if (values.empty()) {
+		std::cout << "\n";
+		return;
+	}
+
+	std::sort(values.begin(), values.end());
+
+	std::cout << std::setw(COLUMN_WIDTH) << values.front()
+			  << std::setw(COLUMN_WIDTH) << values[values.size() / 2]
+			  << std::setw(COLUMN_WIDTH) << values.back()
+			  << "\n";
+}
+
+int main(int argc, char* argv[]) try {
+	// Everything the static initializers of the program allocated:
+	uint64_t static_allocations = getAllocationCount();
+
+	size_t repetitions = DEFAULT_REPETITIONS;
+	std::vector<char*> arguments{ argv[0] };
+
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+
+		if (i + 1 < argc && argument == FLAG_REPETITIONS) {
+			repetitions = static_cast<size_t>(ParseUnsignedArgument(FLAG_REPETITIONS, argv[++i]));
+		} else if (argument == FLAG_SEPARATOR) {
+			arguments.insert(arguments.end(), argv + i + 1, argv + argc);
+			break;
+		} else {
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (repetitions == 0) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	std::vector<StartupSample> samples;
+	samples.reserve(repetitions);
+
+	DiscardingBuffer discarding_buffer;
+	std::streambuf* output_buffer = std::cout.rdbuf(&discarding_buffer);
+
+	try {
+		for (size_t i = 0; i < repetitions; i++) {
+			samples.push_back(RunStartup(arguments));
+		}
+	} catch (...) {
+		std::cout.rdbuf(output_buffer);
+		throw;
+	}
+
+	std::cout.rdbuf(output_buffer);
+
+	std::cout << "INFO: Static initializers allocated " << static_allocations << " times.\n\n"
+			  << std::setfill(' ') // setUpRun() leaves the fill at '0'.
+			  << std::setw(LABEL_WIDTH) << std::left << ""
+			  << std::right
+			  << std::setw(COLUMN_WIDTH) << "First"
+			  << std::setw(COLUMN_WIDTH) << "Minimum"
+			  << std::setw(COLUMN_WIDTH) << "Median"
+			  << std::setw(COLUMN_WIDTH) << "Maximum"
+			  << "\n";
+
+	PrintRow("Parsing (ns)",         samples, &StartupSample::parse_nanoseconds);
+	PrintRow("Setup (ns)",           samples, &StartupSample::setup_nanoseconds);
+	PrintRow("Threads (ns)",         samples, &StartupSample::threads_nanoseconds);
+	PrintRow("First sample (ns)",    samples, &StartupSample::first_sample_nanoseconds);
+	PrintRow("Parsing allocations",  samples, &StartupSample::parse_allocations);
+	PrintRow("Setup allocations",    samples, &StartupSample::setup_allocations);
+	PrintRow("Thread allocations",   samples, &StartupSample::threads_allocations);
+
+	return EXIT_SUCCESS;
+} catch (std::logic_error& err) {
+	std::cerr << "ERROR: " << err.what() << "\n";
+	return EXIT_FAILURE;
+} catch (std::runtime_error& err) {
+	std::cerr << "ERROR: " << err.what() << "\n";
+	return EXIT_FAILURE;
+}